@@ -16,13 +16,57 @@ gcc -c -Iinclude -std=c11 -Wall -Wextra -pthread \
     src/memory_client.c -o $BUILD_DIR/memory_client.o
 gcc -c -Iinclude -std=c11 -Wall -Wextra -pthread \
     src/memory_metrics.c -o $BUILD_DIR/memory_metrics.o
+gcc -c -Iinclude -std=c11 -Wall -Wextra -pthread \
+    src/memory_persist.c -o $BUILD_DIR/memory_persist.o
+gcc -c -Iinclude -std=c11 -Wall -Wextra -pthread \
+    src/memory_histogram.c -o $BUILD_DIR/memory_histogram.o
+gcc -c -Iinclude -std=c11 -Wall -Wextra -pthread \
+    src/memory_profiler.c -o $BUILD_DIR/memory_profiler.o
+gcc -c -Iinclude -std=c11 -Wall -Wextra -pthread \
+    src/memory_trace.c -o $BUILD_DIR/memory_trace.o
+gcc -c -Iinclude -std=c11 -Wall -Wextra -pthread \
+    src/memory_subheap.c -o $BUILD_DIR/memory_subheap.o
+gcc -c -Iinclude -std=c11 -Wall -Wextra -pthread \
+    src/memory_pool_group.c -o $BUILD_DIR/memory_pool_group.o
+gcc -c -Iinclude -std=c11 -Wall -Wextra -pthread \
+    src/memory_guard.c -o $BUILD_DIR/memory_guard.o
+gcc -c -Iinclude -std=c11 -Wall -Wextra -pthread \
+    src/memory_verify.c -o $BUILD_DIR/memory_verify.o
+gcc -c -Iinclude -std=c11 -Wall -Wextra -pthread \
+    src/memory_log.c -o $BUILD_DIR/memory_log.o
+gcc -c -Iinclude -std=c11 -Wall -Wextra -pthread \
+    src/memory_export.c -o $BUILD_DIR/memory_export.o
+gcc -c -Iinclude -std=c11 -Wall -Wextra -pthread \
+    src/memory_adaptive.c -o $BUILD_DIR/memory_adaptive.o
+gcc -c -Iinclude -std=c11 -Wall -Wextra -pthread \
+    src/memory_kernels.c -o $BUILD_DIR/memory_kernels.o
+gcc -c -Iinclude -std=c11 -Wall -Wextra -pthread \
+    src/memory_wait.c -o $BUILD_DIR/memory_wait.o
 
 # Crear librería estática
 echo "Creando librería estática..."
 ar rcs $BUILD_DIR/lib$LIB_NAME.a \
     $BUILD_DIR/memory_pool.o \
     $BUILD_DIR/memory_client.o \
-    $BUILD_DIR/memory_metrics.o
+    $BUILD_DIR/memory_metrics.o \
+    $BUILD_DIR/memory_persist.o \
+    $BUILD_DIR/memory_histogram.o \
+    $BUILD_DIR/memory_profiler.o \
+    $BUILD_DIR/memory_trace.o \
+    $BUILD_DIR/memory_subheap.o \
+    $BUILD_DIR/memory_pool_group.o \
+    $BUILD_DIR/memory_guard.o \
+    $BUILD_DIR/memory_verify.o \
+    $BUILD_DIR/memory_log.o \
+    $BUILD_DIR/memory_export.o \
+    $BUILD_DIR/memory_adaptive.o \
+    $BUILD_DIR/memory_kernels.o \
+    $BUILD_DIR/memory_wait.o
+
+# Biblioteca para LD_PRELOAD
+echo "Creando biblioteca de interposición..."
+gcc -shared -fPIC -Iinclude -std=c11 -Wall -Wextra -pthread -DMEMORY_ALIGNMENT=16 -Wl,-Bsymbolic \
+    src/*.c src/preload/memory_preload.c -o $BUILD_DIR/libmemory_preload.so
 
 # Compilar ejemplos
 for example in "${EXAMPLES[@]}"; do
@@ -5,6 +5,7 @@
 #include <pthread.h>
 #include "../include/memory_pool.h"
 #include "../include/memory_client.h"
+#include "../include/memory_metrics.h"
 
 #define NUM_THREADS 4
 #define OPS_PER_THREAD 1000
@@ -149,6 +150,19 @@ void benchmark_concurrent_custom() {
     printf("Operaciones totales: %.0f\n", total_ops);
     printf("Operaciones por segundo: %.0f\n", total_ops / total_time);
 
+    // Latencias por operación (histogramas del pool)
+    const char* names[] = {"alloc", "free", "espera de lock"};
+    memory_latency_op_t ops[] = {MEMORY_LATENCY_ALLOC, MEMORY_LATENCY_FREE, MEMORY_LATENCY_LOCK_WAIT};
+    for (int i = 0; i < 3; i++) {
+        memory_histogram_t histogram;
+        if (memory_pool_get_latency(pool, ops[i], -1, &histogram) != MEMORY_SUCCESS) break;
+        printf("Latencia %-15s p50: %6llu ns  p99: %6llu ns  p999: %6llu ns\n", names[i],
+               (unsigned long long)memory_histogram_percentile(&histogram, 50.0),
+               (unsigned long long)memory_histogram_percentile(&histogram, 99.0),
+               (unsigned long long)memory_histogram_percentile(&histogram, 99.9));
+    }
+    memory_pool_print_cost_counters(pool);
+
     memory_pool_destroy(pool);
 }
 
@@ -0,0 +1,117 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <list>
+#include <map>
+#include <memory_resource>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../include/memory_resource.hpp"
+
+// Contenedores estándar sobre el pool (cliente normal, cliente con sub-heap y
+// pool directo) frente al recurso por defecto (new/delete).
+//
+// Uso: benchmark_containers [escala]
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+double elapsed_ms(clock_type::time_point start) {
+    return std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+}
+
+// push_back con crecimiento geométrico: pocas asignaciones grandes
+double bench_vector(std::pmr::memory_resource* resource, int n) {
+    auto start = clock_type::now();
+    for (int round = 0; round < 20; round++) {
+        std::pmr::vector<int> values(resource);
+        for (int i = 0; i < n; i++) values.push_back(i);
+    }
+    return elapsed_ms(start);
+}
+
+// Un nodo por elemento: muchas asignaciones pequeñas del mismo tamaño
+double bench_list(std::pmr::memory_resource* resource, int n) {
+    auto start = clock_type::now();
+    std::pmr::list<int> values(resource);
+    for (int i = 0; i < n; i++) values.push_back(i);
+    for (int round = 0; round < 4; round++) {
+        for (auto it = values.begin(); it != values.end();) {
+            it = (*it & 1) ? values.erase(it) : std::next(it);
+        }
+        for (int i = 0; i < n / 2; i++) values.push_front(i * 2 + 1);
+    }
+    return elapsed_ms(start);
+}
+
+// Nodos y array de buckets que se rehace al crecer
+double bench_unordered_map(std::pmr::memory_resource* resource, int n) {
+    auto start = clock_type::now();
+    std::pmr::unordered_map<int, int> table(resource);
+    for (int i = 0; i < n; i++) table.emplace(i * 7919, i);
+    for (int i = 0; i < n; i += 2) table.erase(i * 7919);
+    for (int i = 0; i < n; i += 2) table.emplace(i * 7919 + 1, i);
+    return elapsed_ms(start);
+}
+
+// Árbol con claves string: nodo + buffer de la cadena cuando no cabe en SSO
+double bench_map_strings(std::pmr::memory_resource* resource, int n) {
+    auto start = clock_type::now();
+    std::pmr::map<std::pmr::string, int> tree(resource);
+    for (int i = 0; i < n; i++) {
+        std::pmr::string key("clave-con-longitud-suficiente-", resource);
+        key += std::to_string(i);
+        tree.emplace(std::move(key), i);
+    }
+    return elapsed_ms(start);
+}
+
+struct workload {
+    const char* name;
+    double (*run)(std::pmr::memory_resource*, int);
+    int size;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int scale = argc > 1 ? std::atoi(argv[1]) : 1;
+    if (scale < 1) scale = 1;
+
+    std::printf("=== BENCHMARK CONTENEDORES std::pmr (escala %d) ===\n", scale);
+
+    workload workloads[] = {
+        {"vector<int>", bench_vector, 100000 * scale},
+        {"list<int>", bench_list, 10000 * scale},
+        {"unordered_map", bench_unordered_map, 10000 * scale},
+        {"map<string>", bench_map_strings, 10000 * scale},
+    };
+
+    std::printf("%-16s %12s %12s %12s %12s\n", "carga", "new/delete", "cliente", "sub-heap", "pool");
+    for (const workload& w : workloads) {
+        memory_pool_t* pool = memory_pool_create(256 * 1024 * 1024, ALLOC_FIRST_FIT);
+        memory_client_t* client = memory_client_create(1, pool);
+        memory_client_t* local = memory_client_create_ex(2, pool, MEMORY_CLIENT_FLAG_SUBHEAP);
+
+        memory::client_resource client_resource(client);
+        memory::client_resource local_resource(local);
+        memory::pool_resource pool_resource(pool, 3);
+
+        double baseline = w.run(std::pmr::new_delete_resource(), w.size);
+        double with_client = w.run(&client_resource, w.size);
+        double with_local = w.run(&local_resource, w.size);
+        double with_pool = w.run(&pool_resource, w.size);
+
+        std::printf("%-16s %10.2fms %10.2fms %10.2fms %10.2fms\n", w.name, baseline, with_client,
+                    with_local, with_pool);
+
+        memory_client_destroy(local);
+        memory_client_destroy(client);
+        memory_pool_destroy(pool);
+    }
+    return 0;
+}
@@ -0,0 +1,77 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include "../include/memory_pool.h"
+#include "../include/memory_client.h"
+
+// False sharing entre clientes: cada hilo tiene su cliente y escribe solo
+// en sus propios objetos pequeños, asignados de forma intercalada como en
+// benchmark_concurrent. Sin afinidad los objetos de hilos distintos quedan
+// en la misma línea de caché y cada escritura la hace rebotar entre núcleos;
+// con MEMORY_CLIENT_FLAG_AFFINE cada línea pertenece a un solo cliente.
+
+#define MAX_THREADS 8
+#define OBJECTS_PER_CLIENT 64
+#define OBJECT_SIZE 16
+#define WRITE_ROUNDS 200000
+
+typedef struct {
+    volatile unsigned long* objects[OBJECTS_PER_CLIENT];
+    double seconds;
+} bench_thread_t;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void* run_writer(void* arg) {
+    bench_thread_t* data = arg;
+    double start = now_seconds();
+    for (int r = 0; r < WRITE_ROUNDS; r++) {
+        for (int i = 0; i < OBJECTS_PER_CLIENT; i++) data->objects[i][0]++;
+    }
+    data->seconds = now_seconds() - start;
+    return NULL;
+}
+
+// Devuelve ns por escritura del hilo más lento
+static double run(int threads, unsigned flags) {
+    memory_pool_t* pool = memory_pool_create(16 * 1024 * 1024, ALLOC_FIRST_FIT);
+    memory_client_t* clients[MAX_THREADS];
+    bench_thread_t data[MAX_THREADS];
+    pthread_t handles[MAX_THREADS];
+
+    for (int t = 0; t < threads; t++) clients[t] = memory_client_create_ex(t + 1, pool, flags);
+    // Asignación intercalada: cada hilo recibe su cliente ya poblado
+    for (int i = 0; i < OBJECTS_PER_CLIENT; i++) {
+        for (int t = 0; t < threads; t++) data[t].objects[i] = memory_client_alloc(clients[t], OBJECT_SIZE);
+    }
+
+    for (int t = 0; t < threads; t++) pthread_create(&handles[t], NULL, run_writer, &data[t]);
+    double worst = 0.0;
+    for (int t = 0; t < threads; t++) {
+        pthread_join(handles[t], NULL);
+        if (data[t].seconds > worst) worst = data[t].seconds;
+    }
+
+    for (int t = 0; t < threads; t++) memory_client_destroy(clients[t]);
+    memory_pool_destroy(pool);
+    return worst * 1e9 / ((double)WRITE_ROUNDS * OBJECTS_PER_CLIENT);
+}
+
+int main() {
+    printf("=== BENCHMARK FALSE SHARING ENTRE CLIENTES ===\n");
+    printf("%d objetos de %d bytes por cliente, asignados intercalados\n\n", OBJECTS_PER_CLIENT, OBJECT_SIZE);
+    printf("%8s %20s %20s %10s\n", "hilos", "contiguo ns/escr", "afín ns/escr", "mejora");
+
+    for (int threads = 1; threads <= MAX_THREADS; threads *= 2) {
+        double shared = run(threads, 0);
+        double affine = run(threads, MEMORY_CLIENT_FLAG_AFFINE);
+        printf("%8d %20.2f %20.2f %9.1fx\n", threads, shared, affine, affine > 0 ? shared / affine : 0.0);
+    }
+    return 0;
+}
@@ -5,6 +5,7 @@
 #include "../include/memory_pool.h"
 #include "../include/memory_client.h"
 #include "../include/memory_metrics.h"
+#include "../include/memory_verify.h"
 
 #define NUM_OPERATIONS 300  // Más reducido para estabilidad
 #define NUM_ITERATIONS 2
@@ -16,6 +17,7 @@ typedef struct {
     size_t memory_used;
     double fragmentation;
     int successful_ops;
+    pool_cost_counters_t costs;     // suma de las iteraciones
 } strategy_result_t;
 
 void benchmark_strategy(alloc_strategy_t strategy, const char* name, strategy_result_t* result) {
@@ -25,6 +27,7 @@ void benchmark_strategy(alloc_strategy_t strategy, const char* name, strategy_re
     size_t total_memory = 0;
     double total_fragmentation = 0;
     int total_successful = 0;
+    pool_cost_counters_t total_costs = {0};
 
     for (int iter = 0; iter < NUM_ITERATIONS; iter++) {
         printf("  Iteración %d...\n", iter + 1);
@@ -55,9 +58,9 @@ void benchmark_strategy(alloc_strategy_t strategy, const char* name, strategy_re
                 }
             }
 
-            // Verificación periódica más frecuente
+            // Verificación periódica incremental: un tramo acotado del heap
             if (i % 50 == 0 && i > 0) {
-                if (!memory_pool_check(pool)) {
+                if (memory_pool_verify_step(pool, 64, NULL) != 0) {
                     printf("    ERROR: Pool corrupto en operación %d - abortando iteración\n", i);
                     // Limpiar y salir de esta iteración
                     for (int j = 0; j < i; j++) {
@@ -115,6 +118,16 @@ void benchmark_strategy(alloc_strategy_t strategy, const char* name, strategy_re
             }
         }
 
+        pool_cost_counters_t costs;
+        memory_pool_get_cost_counters(pool, &costs);
+        total_costs.searches += costs.searches;
+        total_costs.search_steps += costs.search_steps;
+        total_costs.splits += costs.splits;
+        total_costs.forward_merges += costs.forward_merges;
+        total_costs.backward_merges += costs.backward_merges;
+        total_costs.backward_walk_steps += costs.backward_walk_steps;
+        total_costs.bytes_zeroed += costs.bytes_zeroed;
+
         memory_client_destroy(client);
         memory_pool_destroy(pool);
 
@@ -131,6 +144,7 @@ void benchmark_strategy(alloc_strategy_t strategy, const char* name, strategy_re
     result->memory_used = total_memory / NUM_ITERATIONS;
     result->fragmentation = total_fragmentation / NUM_ITERATIONS;
     result->successful_ops = total_successful / NUM_ITERATIONS;
+    result->costs = total_costs;
 }
 
 int main() {
@@ -141,10 +155,11 @@ int main() {
     srand((unsigned int)time(NULL));
 
     strategy_result_t strategies[] = {
-        {"FIRST_FIT", ALLOC_FIRST_FIT, 0, 0, 0, 0},
-        {"BEST_FIT", ALLOC_BEST_FIT, 0, 0, 0, 0},
-        {"WORST_FIT", ALLOC_WORST_FIT, 0, 0, 0, 0},
-        {"NEXT_FIT", ALLOC_NEXT_FIT, 0, 0, 0, 0}
+        {"FIRST_FIT", ALLOC_FIRST_FIT, 0, 0, 0, 0, {0}},
+        {"BEST_FIT", ALLOC_BEST_FIT, 0, 0, 0, 0, {0}},
+        {"WORST_FIT", ALLOC_WORST_FIT, 0, 0, 0, 0, {0}},
+        {"NEXT_FIT", ALLOC_NEXT_FIT, 0, 0, 0, 0, {0}},
+        {"ADAPTIVE", ALLOC_ADAPTIVE, 0, 0, 0, 0, {0}}
     };
 
     int num_strategies = sizeof(strategies) / sizeof(strategies[0]);
@@ -169,6 +184,23 @@ int main() {
                success_rate);
     }
 
+    // Dónde se va el tiempo de cada estrategia
+    printf("\n=== COSTE POR OPERACIÓN ===\n");
+    printf("%-12s %-12s %-12s %-12s %-12s %-14s\n",
+           "Estrategia", "Pasos/búsq.", "Divisiones", "Fus. sig.", "Fus. ant.", "Headers/ant.");
+    printf("------------ ------------ ------------ ------------ ------------ --------------\n");
+
+    for (int i = 0; i < num_strategies; i++) {
+        const pool_cost_counters_t* costs = &strategies[i].costs;
+        printf("%-12s %-12.2f %-12zu %-12zu %-12zu %-14.1f\n",
+               strategies[i].name,
+               costs->searches ? (double)costs->search_steps / costs->searches : 0.0,
+               costs->splits,
+               costs->forward_merges,
+               costs->backward_merges,
+               costs->backward_merges ? (double)costs->backward_walk_steps / costs->backward_merges : 0.0);
+    }
+
     printf("\nBenchmark completado.\n");
     return 0;
 }
@@ -0,0 +1,83 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include "../include/memory_pool.h"
+#include "../include/memory_client.h"
+
+// Compara el camino habitual del cliente (mutex del pool + mutex del cliente)
+// con el sub-heap privado sin locks, con uno y varios hilos dueños.
+
+#define OPS_PER_THREAD 400000
+#define LIVE_SLOTS 512
+#define MAX_THREADS 8
+
+typedef struct {
+    memory_pool_t* pool;
+    int id;
+    unsigned flags;
+    double seconds;
+} bench_thread_t;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void* run_client(void* arg) {
+    bench_thread_t* data = arg;
+    memory_client_t* client = memory_client_create_ex(data->id, data->pool, data->flags);
+    void* slots[LIVE_SLOTS] = {0};
+    unsigned int seed = (unsigned int)data->id;
+
+    double start = now_seconds();
+    for (int i = 0; i < OPS_PER_THREAD; i++) {
+        int slot = rand_r(&seed) % LIVE_SLOTS;
+        if (slots[slot]) {
+            memory_client_free(client, slots[slot]);
+            slots[slot] = NULL;
+        } else {
+            slots[slot] = memory_client_alloc(client, 16 + rand_r(&seed) % 240);
+        }
+    }
+    data->seconds = now_seconds() - start;
+
+    memory_client_destroy(client);
+    return NULL;
+}
+
+static double run(int threads, unsigned flags) {
+    memory_pool_t* pool = memory_pool_create(64 * 1024 * 1024, ALLOC_BEST_FIT);
+    pthread_t handles[MAX_THREADS];
+    bench_thread_t data[MAX_THREADS];
+
+    for (int i = 0; i < threads; i++) {
+        data[i] = (bench_thread_t){pool, i + 1, flags, 0.0};
+        pthread_create(&handles[i], NULL, run_client, &data[i]);
+    }
+
+    double worst = 0.0;
+    for (int i = 0; i < threads; i++) {
+        pthread_join(handles[i], NULL);
+        if (data[i].seconds > worst) worst = data[i].seconds;
+    }
+
+    memory_pool_destroy(pool);
+    return worst;
+}
+
+int main() {
+    printf("=== BENCHMARK SUB-HEAP PRIVADO vs DOBLE LOCK ===\n");
+    printf("%8s %18s %18s %10s\n", "hilos", "doble lock ns/op", "sub-heap ns/op", "mejora");
+
+    for (int threads = 1; threads <= MAX_THREADS; threads *= 2) {
+        double locked = run(threads, 0);
+        double local = run(threads, MEMORY_CLIENT_FLAG_SUBHEAP);
+        printf("%8d %18.1f %18.1f %9.1fx\n", threads,
+               locked * 1e9 / OPS_PER_THREAD, local * 1e9 / OPS_PER_THREAD,
+               local > 0 ? locked / local : 0.0);
+    }
+    return 0;
+}
@@ -0,0 +1,509 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include "../include/memory_pool.h"
+#include "../include/memory_histogram.h"
+#include "../include/memory_metrics.h"
+
+// Suite de benchmarks de asignadores con cargas clásicas (Larson, threadtest,
+// xmalloc, cache-scratch y churn de tamaños aleatorios). El tiempo es de
+// pared (CLOCK_MONOTONIC) y cada operación se registra en un histograma para
+// reportar percentiles. malloc de glibc se mide como referencia.
+//
+// Uso: benchmark_suite [--threads n] [--scale x] [--format text|json|csv]
+//                      [--allocators all|pool|glibc] [--pool-size bytes]
+
+// =============================================================================
+// ASIGNADORES BAJO PRUEBA
+// =============================================================================
+
+typedef struct allocator {
+    const char* name;
+    memory_pool_t* pool;
+    void* (*alloc)(struct allocator* allocator, size_t size);
+    void (*free)(struct allocator* allocator, void* ptr);
+} allocator_t;
+
+static void* pool_bench_alloc(allocator_t* allocator, size_t size) {
+    return memory_pool_alloc(allocator->pool, size, 0);
+}
+
+static void pool_bench_free(allocator_t* allocator, void* ptr) {
+    memory_pool_free(allocator->pool, ptr, 0);
+}
+
+static void* glibc_bench_alloc(allocator_t* allocator, size_t size) {
+    (void)allocator;
+    return malloc(size);
+}
+
+static void glibc_bench_free(allocator_t* allocator, void* ptr) {
+    (void)allocator;
+    free(ptr);
+}
+
+// =============================================================================
+// INFRAESTRUCTURA DE MEDICIÓN
+// =============================================================================
+
+typedef struct {
+    int threads;
+    double scale;
+} bench_params_t;
+
+typedef struct worker {
+    allocator_t* allocator;
+    const bench_params_t* params;
+    int index;
+    unsigned int seed;
+    size_t ops;
+    size_t failed;
+    uint64_t start_ns;              // al salir de la barrera de inicio
+    uint64_t end_ns;
+    memory_histogram_t alloc_latency;
+    memory_histogram_t free_latency;
+} worker_t;
+
+typedef struct {
+    const char* workload;
+    const char* allocator;
+    int threads;
+    size_t ops;
+    size_t failed;
+    uint64_t wall_ns;
+    memory_histogram_t alloc_latency;
+    memory_histogram_t free_latency;
+    int has_costs;                  // solo los pools tienen contadores de coste
+    pool_cost_counters_t costs;
+} bench_result_t;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void* timed_alloc(worker_t* worker, size_t size) {
+    uint64_t start = now_ns();
+    void* ptr = worker->allocator->alloc(worker->allocator, size);
+    memory_histogram_record(&worker->alloc_latency, now_ns() - start);
+    worker->ops++;
+    if (!ptr) worker->failed++;
+    return ptr;
+}
+
+static void timed_free(worker_t* worker, void* ptr) {
+    if (!ptr) return;
+    uint64_t start = now_ns();
+    worker->allocator->free(worker->allocator, ptr);
+    memory_histogram_record(&worker->free_latency, now_ns() - start);
+    worker->ops++;
+}
+
+static size_t scaled(const bench_params_t* params, size_t base) {
+    size_t value = (size_t)((double)base * params->scale);
+    return value ? value : 1;
+}
+
+// Tamaño aleatorio con sesgo a bloques pequeños: [min, max)
+static size_t random_size(unsigned int* seed, size_t min, size_t max) {
+    size_t range = max - min;
+    size_t a = (size_t)rand_r(seed) % range;
+    size_t b = (size_t)rand_r(seed) % range;
+    return min + (a < b ? a : b);
+}
+
+// =============================================================================
+// CARGAS DE TRABAJO
+// =============================================================================
+
+#define LARSON_SLOTS 1000
+#define LARSON_ROUNDS 8
+#define THREADTEST_BATCH 1000
+#define XMALLOC_RING 1024
+#define SCRATCH_WRITES 64
+#define CHURN_SLOTS 256
+
+static pthread_barrier_t round_barrier;
+
+// Larson: cada hilo reemplaza objetos al azar en una ventana de punteros; en
+// cada ronda la ventana pasa al hilo siguiente (liberaciones entre hilos).
+static void** larson_slots;
+
+static void* workload_larson(void* arg) {
+    worker_t* worker = arg;
+    int threads = worker->params->threads;
+    size_t replacements = scaled(worker->params, 20000);
+
+    void** own = &larson_slots[(size_t)worker->index * LARSON_SLOTS];
+    for (int i = 0; i < LARSON_SLOTS; i++) {
+        own[i] = timed_alloc(worker, random_size(&worker->seed, 16, 512));
+    }
+
+    for (int round = 0; round < LARSON_ROUNDS; round++) {
+        pthread_barrier_wait(&round_barrier);
+        void** window = &larson_slots[(size_t)((worker->index + round) % threads) * LARSON_SLOTS];
+        for (size_t i = 0; i < replacements; i++) {
+            int slot = rand_r(&worker->seed) % LARSON_SLOTS;
+            timed_free(worker, window[slot]);
+            window[slot] = timed_alloc(worker, random_size(&worker->seed, 16, 512));
+        }
+    }
+
+    pthread_barrier_wait(&round_barrier);
+    for (int i = 0; i < LARSON_SLOTS; i++) {
+        timed_free(worker, own[i]);
+    }
+    return NULL;
+}
+
+// threadtest: lotes de asignaciones de tamaño fijo liberadas en bloque
+static void* workload_threadtest(void* arg) {
+    worker_t* worker = arg;
+    size_t iterations = scaled(worker->params, 50);
+    void* batch[THREADTEST_BATCH];
+
+    for (size_t it = 0; it < iterations; it++) {
+        for (int i = 0; i < THREADTEST_BATCH; i++) batch[i] = timed_alloc(worker, 64);
+        for (int i = 0; i < THREADTEST_BATCH; i++) timed_free(worker, batch[i]);
+    }
+    return NULL;
+}
+
+// xmalloc: parejas productor/consumidor; el consumidor libera lo que asigna
+// el productor a través de un buffer circular SPSC.
+typedef struct {
+    void* items[XMALLOC_RING];
+    size_t head;
+    size_t tail;
+} xmalloc_ring_t;
+
+static xmalloc_ring_t* xmalloc_rings;
+
+static void* workload_xmalloc(void* arg) {
+    worker_t* worker = arg;
+    xmalloc_ring_t* ring = &xmalloc_rings[worker->index / 2];
+    size_t items = scaled(worker->params, 100000);
+
+    // Con un número impar de hilos el último no tiene pareja: asigna y libera
+    if (worker->index % 2 == 0 && worker->index + 1 == worker->params->threads) {
+        for (size_t i = 0; i < items; i++) {
+            timed_free(worker, timed_alloc(worker, random_size(&worker->seed, 16, 256)));
+        }
+        return NULL;
+    }
+
+    if (worker->index % 2 == 0) {
+        for (size_t i = 0; i < items; i++) {
+            void* ptr = timed_alloc(worker, random_size(&worker->seed, 16, 256));
+            size_t head = ring->head;
+            while (head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) == XMALLOC_RING) sched_yield();
+            ring->items[head % XMALLOC_RING] = ptr;
+            __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+        }
+    } else {
+        for (size_t i = 0; i < items; i++) {
+            size_t tail = ring->tail;
+            while (__atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) == tail) sched_yield();
+            timed_free(worker, ring->items[tail % XMALLOC_RING]);
+            __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+        }
+    }
+    return NULL;
+}
+
+// cache-scratch: cada hilo libera un objeto asignado por el hilo principal y
+// luego asigna/escribe/libera objetos pequeños (detecta falso compartir)
+static void** scratch_objects;
+
+static void* workload_cache_scratch(void* arg) {
+    worker_t* worker = arg;
+    size_t iterations = scaled(worker->params, 100000);
+
+    timed_free(worker, scratch_objects[worker->index]);
+    for (size_t it = 0; it < iterations; it++) {
+        volatile char* object = timed_alloc(worker, 8);
+        if (object) {
+            for (int w = 0; w < SCRATCH_WRITES; w++) object[w % 8]++;
+        }
+        timed_free(worker, (void*)object);
+    }
+    return NULL;
+}
+
+// churn: conjunto vivo por hilo con tamaños aleatorios hasta 4 KiB
+static void* workload_churn(void* arg) {
+    worker_t* worker = arg;
+    size_t operations = scaled(worker->params, 200000);
+    void* slots[CHURN_SLOTS] = {0};
+
+    for (size_t i = 0; i < operations; i++) {
+        int slot = rand_r(&worker->seed) % CHURN_SLOTS;
+        if (slots[slot]) {
+            timed_free(worker, slots[slot]);
+            slots[slot] = NULL;
+        } else {
+            slots[slot] = timed_alloc(worker, random_size(&worker->seed, 16, 4096));
+        }
+    }
+    for (int i = 0; i < CHURN_SLOTS; i++) timed_free(worker, slots[i]);
+    return NULL;
+}
+
+typedef struct {
+    const char* name;
+    void* (*run)(void* arg);
+} workload_t;
+
+static const workload_t workloads[] = {
+    {"larson", workload_larson},
+    {"threadtest", workload_threadtest},
+    {"xmalloc", workload_xmalloc},
+    {"cache-scratch", workload_cache_scratch},
+    {"churn", workload_churn},
+};
+
+#define NUM_WORKLOADS (sizeof(workloads) / sizeof(workloads[0]))
+
+// =============================================================================
+// EJECUCIÓN
+// =============================================================================
+
+static pthread_barrier_t start_barrier;
+
+typedef struct {
+    worker_t* worker;
+    void* (*run)(void* arg);
+} thread_start_t;
+
+static void* thread_entry(void* arg) {
+    thread_start_t* start = arg;
+    pthread_barrier_wait(&start_barrier);
+    start->worker->start_ns = now_ns();
+    void* result = start->run(start->worker);
+    start->worker->end_ns = now_ns();
+    return result;
+}
+
+static void run_workload(const workload_t* workload, allocator_t* allocator,
+                         const bench_params_t* params, bench_result_t* result) {
+    int threads = params->threads;
+    worker_t* workers = calloc((size_t)threads, sizeof(worker_t));
+    thread_start_t* starts = calloc((size_t)threads, sizeof(thread_start_t));
+    pthread_t* handles = calloc((size_t)threads, sizeof(pthread_t));
+
+    larson_slots = calloc((size_t)threads * LARSON_SLOTS, sizeof(void*));
+    xmalloc_rings = calloc((size_t)threads / 2 + 1, sizeof(xmalloc_ring_t));
+    scratch_objects = calloc((size_t)threads, sizeof(void*));
+    for (int i = 0; i < threads; i++) scratch_objects[i] = allocator->alloc(allocator, 8);
+
+    pthread_barrier_init(&start_barrier, NULL, (unsigned)threads);
+    pthread_barrier_init(&round_barrier, NULL, (unsigned)threads);
+
+    for (int i = 0; i < threads; i++) {
+        workers[i].allocator = allocator;
+        workers[i].params = params;
+        workers[i].index = i;
+        workers[i].seed = 0x9e3779b9u * (unsigned)(i + 1);
+        memory_histogram_reset(&workers[i].alloc_latency);
+        memory_histogram_reset(&workers[i].free_latency);
+        starts[i].worker = &workers[i];
+        starts[i].run = workload->run;
+        pthread_create(&handles[i], NULL, thread_entry, &starts[i]);
+    }
+
+    for (int i = 0; i < threads; i++) pthread_join(handles[i], NULL);
+
+    result->workload = workload->name;
+    result->allocator = allocator->name;
+    result->threads = threads;
+    result->ops = 0;
+    result->failed = 0;
+    memory_histogram_reset(&result->alloc_latency);
+    memory_histogram_reset(&result->free_latency);
+    // Tiempo de pared: del primer hilo que arranca al último que termina
+    uint64_t first_start = UINT64_MAX, last_end = 0;
+    for (int i = 0; i < threads; i++) {
+        if (workers[i].start_ns < first_start) first_start = workers[i].start_ns;
+        if (workers[i].end_ns > last_end) last_end = workers[i].end_ns;
+        result->ops += workers[i].ops;
+        result->failed += workers[i].failed;
+        memory_histogram_merge(&result->alloc_latency, &workers[i].alloc_latency);
+        memory_histogram_merge(&result->free_latency, &workers[i].free_latency);
+    }
+    result->wall_ns = last_end - first_start;
+
+    pthread_barrier_destroy(&start_barrier);
+    pthread_barrier_destroy(&round_barrier);
+    free(scratch_objects);
+    free(xmalloc_rings);
+    free(larson_slots);
+    free(handles);
+    free(starts);
+    free(workers);
+}
+
+// =============================================================================
+// SALIDA
+// =============================================================================
+
+typedef enum { FORMAT_TEXT, FORMAT_JSON, FORMAT_CSV } output_format_t;
+
+static double ops_per_sec(const bench_result_t* r) {
+    return r->wall_ns ? (double)r->ops * 1e9 / (double)r->wall_ns : 0.0;
+}
+
+static void print_latency_json(const char* name, const memory_histogram_t* h) {
+    printf("\"%s\": {\"count\": %llu, \"mean_ns\": %.1f, \"p50_ns\": %llu, \"p99_ns\": %llu, "
+           "\"p999_ns\": %llu, \"max_ns\": %llu}",
+           name, (unsigned long long)h->total_count, memory_histogram_mean(h),
+           (unsigned long long)memory_histogram_percentile(h, 50.0),
+           (unsigned long long)memory_histogram_percentile(h, 99.0),
+           (unsigned long long)memory_histogram_percentile(h, 99.9),
+           (unsigned long long)h->max);
+}
+
+static void print_result(const bench_result_t* r, output_format_t format, int first) {
+    const memory_histogram_t* a = &r->alloc_latency;
+    const memory_histogram_t* f = &r->free_latency;
+
+    switch (format) {
+        case FORMAT_JSON:
+            printf("%s    {\"workload\": \"%s\", \"allocator\": \"%s\", \"threads\": %d, "
+                   "\"ops\": %zu, \"failed\": %zu, \"wall_ns\": %llu, \"ops_per_sec\": %.0f, ",
+                   first ? "" : ",\n", r->workload, r->allocator, r->threads, r->ops, r->failed,
+                   (unsigned long long)r->wall_ns, ops_per_sec(r));
+            print_latency_json("alloc", a);
+            printf(", ");
+            print_latency_json("free", f);
+            if (r->has_costs) {
+                const pool_cost_counters_t* c = &r->costs;
+                printf(", \"costs\": {\"searches\": %zu, \"search_steps\": %zu, \"splits\": %zu, "
+                       "\"forward_merges\": %zu, \"backward_merges\": %zu, \"backward_walk_steps\": %zu, "
+                       "\"bytes_zeroed\": %zu, \"lock_acquisitions\": %zu, \"lock_contended\": %zu}",
+                       c->searches, c->search_steps, c->splits, c->forward_merges, c->backward_merges,
+                       c->backward_walk_steps, c->bytes_zeroed, c->lock_acquisitions, c->lock_contended);
+            }
+            printf("}");
+            break;
+        case FORMAT_CSV:
+            printf("%s,%s,%d,%zu,%zu,%llu,%.0f,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,"
+                   "%zu,%zu,%zu,%zu,%zu,%zu,%zu,%zu,%zu\n",
+                   r->workload, r->allocator, r->threads, r->ops, r->failed,
+                   (unsigned long long)r->wall_ns, ops_per_sec(r),
+                   (unsigned long long)memory_histogram_percentile(a, 50.0),
+                   (unsigned long long)memory_histogram_percentile(a, 99.0),
+                   (unsigned long long)memory_histogram_percentile(a, 99.9),
+                   (unsigned long long)a->max,
+                   (unsigned long long)memory_histogram_percentile(f, 50.0),
+                   (unsigned long long)memory_histogram_percentile(f, 99.0),
+                   (unsigned long long)memory_histogram_percentile(f, 99.9),
+                   (unsigned long long)f->max,
+                   r->costs.searches, r->costs.search_steps, r->costs.splits, r->costs.forward_merges,
+                   r->costs.backward_merges, r->costs.backward_walk_steps, r->costs.bytes_zeroed,
+                   r->costs.lock_acquisitions, r->costs.lock_contended);
+            break;
+        case FORMAT_TEXT:
+            printf("%-14s %-10s %3d %10.0f ops/s  alloc p50/p99/p999 %5llu/%6llu/%7llu ns  "
+                   "free p50/p99/p999 %5llu/%6llu/%7llu ns%s\n",
+                   r->workload, r->allocator, r->threads, ops_per_sec(r),
+                   (unsigned long long)memory_histogram_percentile(a, 50.0),
+                   (unsigned long long)memory_histogram_percentile(a, 99.0),
+                   (unsigned long long)memory_histogram_percentile(a, 99.9),
+                   (unsigned long long)memory_histogram_percentile(f, 50.0),
+                   (unsigned long long)memory_histogram_percentile(f, 99.0),
+                   (unsigned long long)memory_histogram_percentile(f, 99.9),
+                   r->failed ? "  (con fallos)" : "");
+            if (r->has_costs && r->costs.searches) {
+                const pool_cost_counters_t* c = &r->costs;
+                printf("%-14s %-10s     búsqueda %.2f bloques  divisiones %zu  fusiones %zu+%zu "
+                       "(%.1f headers por fusión hacia atrás)  a cero %zu B  mutex %zu (%zu con espera)\n",
+                       "", "", (double)c->search_steps / c->searches, c->splits, c->forward_merges,
+                       c->backward_merges, c->backward_merges ? (double)c->backward_walk_steps / c->backward_merges : 0.0,
+                       c->bytes_zeroed, c->lock_acquisitions, c->lock_contended);
+            }
+            break;
+    }
+}
+
+int main(int argc, char** argv) {
+    bench_params_t params = {4, 1.0};
+    output_format_t format = FORMAT_TEXT;
+    const char* which = "all";
+    size_t pool_size = 256 * 1024 * 1024;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--threads") == 0) params.threads = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--scale") == 0) params.scale = atof(argv[i + 1]);
+        else if (strcmp(argv[i], "--allocators") == 0) which = argv[i + 1];
+        else if (strcmp(argv[i], "--pool-size") == 0) pool_size = strtoull(argv[i + 1], NULL, 0);
+        else if (strcmp(argv[i], "--format") == 0) {
+            if (strcmp(argv[i + 1], "json") == 0) format = FORMAT_JSON;
+            else if (strcmp(argv[i + 1], "csv") == 0) format = FORMAT_CSV;
+        } else {
+            fprintf(stderr, "Opción desconocida: %s\n", argv[i]);
+            return 1;
+        }
+    }
+    if (params.threads < 1) params.threads = 1;
+
+    const char* pool_names[] = {"pool-first", "pool-best", "pool-worst", "pool-next"};
+    allocator_t allocators[ALLOC_STRATEGY_COUNT + 1];
+    int count = 0;
+
+    if (strcmp(which, "glibc") == 0 || strcmp(which, "all") == 0) {
+        allocators[count++] = (allocator_t){"glibc", NULL, glibc_bench_alloc, glibc_bench_free};
+    }
+    if (strcmp(which, "pool") == 0 || strcmp(which, "all") == 0) {
+        for (int s = 0; s < ALLOC_STRATEGY_COUNT; s++) {
+            allocators[count++] = (allocator_t){pool_names[s], NULL, pool_bench_alloc, pool_bench_free};
+        }
+    }
+
+    if (format == FORMAT_JSON) {
+        printf("{\n  \"threads\": %d,\n  \"scale\": %g,\n  \"pool_size\": %zu,\n  \"results\": [\n",
+               params.threads, params.scale, pool_size);
+    } else if (format == FORMAT_CSV) {
+        printf("workload,allocator,threads,ops,failed,wall_ns,ops_per_sec,"
+               "alloc_p50_ns,alloc_p99_ns,alloc_p999_ns,alloc_max_ns,"
+               "free_p50_ns,free_p99_ns,free_p999_ns,free_max_ns,"
+               "searches,search_steps,splits,forward_merges,backward_merges,backward_walk_steps,"
+               "bytes_zeroed,lock_acquisitions,lock_contended\n");
+    } else {
+        printf("=== SUITE DE BENCHMARKS (%d hilos, escala %g) ===\n", params.threads, params.scale);
+    }
+
+    int first = 1;
+    for (size_t w = 0; w < NUM_WORKLOADS; w++) {
+        for (int a = 0; a < count; a++) {
+            // Pool nuevo por ejecución para que las cargas no se contaminen
+            if (allocators[a].alloc == pool_bench_alloc) {
+                allocators[a].pool = memory_pool_create(pool_size, (alloc_strategy_t)(a - (count - ALLOC_STRATEGY_COUNT)));
+                if (!allocators[a].pool) {
+                    fprintf(stderr, "No se pudo crear un pool de %zu bytes\n", pool_size);
+                    return 1;
+                }
+            }
+
+            bench_result_t* result = malloc(sizeof(bench_result_t));
+            run_workload(&workloads[w], &allocators[a], &params, result);
+            result->has_costs = allocators[a].pool != NULL;
+            memory_pool_get_cost_counters(allocators[a].pool, &result->costs);
+            print_result(result, format, first);
+            first = 0;
+            free(result);
+
+            if (allocators[a].pool) {
+                memory_pool_destroy(allocators[a].pool);
+                allocators[a].pool = NULL;
+            }
+        }
+    }
+
+    if (format == FORMAT_JSON) printf("\n  ]\n}\n");
+    return 0;
+}
@@ -40,13 +40,14 @@ void liberar_lista(lista** A) {
 }
 
 int main() {
-    pool = memory_pool_create(4024 * 1024, ALLOC_FIRST_FIT);
+    // Un único hilo: ni el pool ni el cliente necesitan sus mutex
+    pool = memory_pool_create_ex(4024 * 1024, ALLOC_FIRST_FIT, MEMORY_POOL_FLAG_UNSYNCHRONIZED);
     if (!pool) {
         printf("Error al crear pool\n");
         return 1;
     }
 
-    client = memory_client_create(1, pool);
+    client = memory_client_create_ex(1, pool, MEMORY_CLIENT_FLAG_UNSYNCHRONIZED);
     if (!client) {
         printf("Error al crear cliente\n");
         memory_pool_destroy(pool);
@@ -0,0 +1,216 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../include/memory_pool.h"
+#include "../include/memory_metrics.h"
+#include "../include/memory_trace.h"
+
+// Reproduce una traza grabada con memory_trace_start contra un pool con la
+// estrategia y el tamaño indicados, y reporta rendimiento, pico de memoria y
+// evolución de la fragmentación.
+//
+// Uso: memory_replay <traza> [--strategy first|best|worst|next|adaptive|all]
+//                            [--pool-size bytes] [--samples n]
+
+typedef struct {
+    uint64_t address;   // dirección original (0 = vacío)
+    void* ptr;          // dirección en el pool de reproducción
+} replay_entry_t;
+
+typedef struct {
+    replay_entry_t* entries;
+    size_t capacity;
+    size_t count;
+} replay_map_t;
+
+static size_t replay_hash(uint64_t key, size_t capacity) {
+    key = (key ^ (key >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+    key = (key ^ (key >> 27)) * UINT64_C(0x94d049bb133111eb);
+    return (size_t)(key ^ (key >> 31)) & (capacity - 1);
+}
+
+static replay_entry_t* replay_find(replay_map_t* map, uint64_t address) {
+    size_t i = replay_hash(address, map->capacity);
+    while (map->entries[i].address && map->entries[i].address != address) {
+        i = (i + 1) & (map->capacity - 1);
+    }
+    return &map->entries[i];
+}
+
+static void replay_put(replay_map_t* map, uint64_t address, void* ptr) {
+    replay_entry_t* entry = replay_find(map, address);
+    if (!entry->address) map->count++;
+    entry->address = address;
+    entry->ptr = ptr;
+}
+
+// Borrado con desplazamiento hacia atrás (sonda lineal)
+static void* replay_take(replay_map_t* map, uint64_t address) {
+    replay_entry_t* entry = replay_find(map, address);
+    if (!entry->address) return NULL;
+
+    void* ptr = entry->ptr;
+    size_t hole = (size_t)(entry - map->entries);
+    size_t i = hole;
+    for (;;) {
+        i = (i + 1) & (map->capacity - 1);
+        if (!map->entries[i].address) break;
+        size_t home = replay_hash(map->entries[i].address, map->capacity);
+        if (((i - home) & (map->capacity - 1)) >= ((i - hole) & (map->capacity - 1))) {
+            map->entries[hole] = map->entries[i];
+            hole = i;
+        }
+    }
+    map->entries[hole].address = 0;
+    map->entries[hole].ptr = NULL;
+    map->count--;
+    return ptr;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static const char* strategy_names[] = {"FIRST_FIT", "BEST_FIT", "WORST_FIT", "NEXT_FIT", "ADAPTIVE"};
+
+static void replay(const memory_trace_event_t* events, size_t count, alloc_strategy_t strategy,
+                   size_t pool_size, size_t samples) {
+    memory_pool_t* pool = memory_pool_create(pool_size, strategy);
+    if (!pool) {
+        printf("No se pudo crear un pool de %zu bytes\n", pool_size);
+        return;
+    }
+
+    // Capacidad suficiente para todas las asignaciones vivas con factor <= 0.5
+    replay_map_t map;
+    map.capacity = 1024;
+    while (map.capacity < count * 2) map.capacity <<= 1;
+    map.count = 0;
+    map.entries = calloc(map.capacity, sizeof(replay_entry_t));
+    if (!map.entries) {
+        memory_pool_destroy(pool);
+        return;
+    }
+
+    printf("\n--- %s (pool %zu bytes) ---\n", strategy_names[strategy], pool_size);
+    printf("%10s %14s %14s %10s\n", "evento", "usado", "mayor libre", "frag %");
+
+    size_t sample_every = samples ? (count + samples - 1) / samples : 0;
+    size_t peak_used = 0, failed = 0, unknown_frees = 0;
+    double elapsed = 0.0;
+
+    for (size_t i = 0; i < count; i++) {
+        const memory_trace_event_t* event = &events[i];
+        double start = now_seconds();
+
+        switch (event->type) {
+            case MEMORY_TRACE_ALLOC: {
+                void* ptr = memory_pool_alloc(pool, event->size, event->client_id);
+                if (!ptr) failed++;
+                else if (event->address) replay_put(&map, event->address, ptr);
+                break;
+            }
+            case MEMORY_TRACE_FREE: {
+                void* ptr = replay_take(&map, event->address);
+                if (ptr) memory_pool_free(pool, ptr, event->client_id);
+                else unknown_frees++;
+                break;
+            }
+            case MEMORY_TRACE_REALLOC: {
+                // El contenido no importa en la reproducción: alloc + free
+                void* old_ptr = replay_take(&map, event->old_address);
+                void* ptr = memory_pool_alloc(pool, event->size, event->client_id);
+                if (old_ptr) memory_pool_free(pool, old_ptr, event->client_id);
+                if (!ptr) failed++;
+                else replay_put(&map, event->address, ptr);
+                break;
+            }
+        }
+
+        elapsed += now_seconds() - start;
+
+        pool_metrics_t metrics;
+        memory_pool_get_metrics(pool, &metrics);
+        if (metrics.used_memory > peak_used) peak_used = metrics.used_memory;
+
+        if (sample_every && (i % sample_every == 0 || i + 1 == count)) {
+            printf("%10zu %14zu %14zu %9.2f\n", i + 1, metrics.used_memory,
+                   metrics.largest_free_block, metrics.fragmentation);
+        }
+    }
+
+    printf("Eventos: %zu en %.3f s (%.0f ops/s)\n", count, elapsed, elapsed > 0 ? count / elapsed : 0.0);
+    printf("Pico de memoria usada: %zu bytes (%.1f%% del pool)\n",
+           peak_used, 100.0 * (double)peak_used / (double)pool_size);
+    printf("Asignaciones fallidas: %zu, frees sin asignación previa: %zu\n", failed, unknown_frees);
+
+    free(map.entries);
+    memory_pool_destroy(pool);
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "Uso: %s <traza> [--strategy first|best|worst|next|adaptive|all] "
+                        "[--pool-size bytes] [--samples n]\n", argv[0]);
+        return 1;
+    }
+
+    const char* path = argv[1];
+    const char* strategy_arg = "all";
+    size_t pool_size = 64 * 1024 * 1024;
+    size_t samples = 10;
+
+    for (int i = 2; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--strategy") == 0) strategy_arg = argv[i + 1];
+        else if (strcmp(argv[i], "--pool-size") == 0) pool_size = strtoull(argv[i + 1], NULL, 0);
+        else if (strcmp(argv[i], "--samples") == 0) samples = strtoull(argv[i + 1], NULL, 0);
+        else {
+            fprintf(stderr, "Opción desconocida: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        perror(path);
+        return 1;
+    }
+
+    memory_trace_file_header_t header;
+    if (fread(&header, sizeof(header), 1, file) != 1 ||
+        memcmp(header.magic, MEMORY_TRACE_MAGIC, sizeof(MEMORY_TRACE_MAGIC)) != 0 ||
+        header.version != MEMORY_TRACE_VERSION || header.event_size != sizeof(memory_trace_event_t)) {
+        fprintf(stderr, "%s no es una traza válida\n", path);
+        fclose(file);
+        return 1;
+    }
+
+    fseek(file, 0, SEEK_END);
+    size_t count = ((size_t)ftell(file) - sizeof(header)) / sizeof(memory_trace_event_t);
+    fseek(file, sizeof(header), SEEK_SET);
+
+    memory_trace_event_t* events = malloc((count ? count : 1) * sizeof(memory_trace_event_t));
+    if (!events || fread(events, sizeof(memory_trace_event_t), count, file) != count) {
+        fprintf(stderr, "Error leyendo %zu eventos\n", count);
+        fclose(file);
+        free(events);
+        return 1;
+    }
+    fclose(file);
+
+    printf("=== REPRODUCCIÓN DE TRAZA %s (%zu eventos) ===\n", path, count);
+
+    for (int s = 0; s <= ALLOC_ADAPTIVE; s++) {
+        const char* short_names[] = {"first", "best", "worst", "next", "adaptive"};
+        if (strcmp(strategy_arg, "all") == 0 || strcmp(strategy_arg, short_names[s]) == 0) {
+            replay(events, count, (alloc_strategy_t)s, pool_size, samples);
+        }
+    }
+
+    free(events);
+    return 0;
+}
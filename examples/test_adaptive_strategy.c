@@ -0,0 +1,143 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/memory_pool.h"
+#include "../include/memory_metrics.h"
+#include "../include/memory_export.h"
+
+// ALLOC_ADAPTIVE: mide las cuatro estrategias, cambia según el coste
+// observado y expone cada decisión en las métricas y en la exportación.
+
+#define BLOQUES 2000
+#define OPERACIONES 200000
+
+static const char* nombres[] = {"FIRST_FIT", "BEST_FIT", "WORST_FIT", "NEXT_FIT"};
+
+// Carga con muchos bloques libres pequeños: las búsquedas exhaustivas
+// (best y worst) examinan listas largas
+static void agitar(memory_pool_t* pool, void** bloques, unsigned* semilla, int cambios) {
+    for (int i = 0; i < cambios; i++) {
+        int j = rand_r(semilla) % BLOQUES;
+        if (bloques[j]) {
+            memory_pool_free(pool, bloques[j], 1);
+            bloques[j] = NULL;
+        } else {
+            bloques[j] = memory_pool_alloc(pool, 16 + rand_r(semilla) % 256, 1);
+        }
+    }
+}
+
+int main(void) {
+    printf("=== TEST ESTRATEGIA ADAPTATIVA ===\n");
+
+    memory_pool_t* pool = memory_pool_create(4 * 1024 * 1024, ALLOC_ADAPTIVE);
+    if (!pool) {
+        printf("Error creando pool\n");
+        return 1;
+    }
+    int errores = 0;
+    unsigned semilla = 7;
+    void* bloques[BLOQUES] = {0};
+
+    if (memory_pool_get_strategy(pool) != ALLOC_ADAPTIVE) {
+        printf("✗ El pool no informa de ALLOC_ADAPTIVE\n");
+        errores++;
+    }
+
+    agitar(pool, bloques, &semilla, OPERACIONES);
+
+    memory_adaptive_stats_t stats;
+    if (memory_pool_get_adaptive_stats(pool, &stats) != MEMORY_SUCCESS) {
+        printf("✗ No hay estadísticas adaptativas\n");
+        memory_pool_destroy(pool);
+        return 1;
+    }
+
+    printf("Ventanas: %zu, cambios: %zu, exploraciones: %zu, estrategia: %s\n",
+           stats.windows, stats.switches, stats.explorations, nombres[stats.current_strategy]);
+    printf("Búsqueda: %.2f bloques, divisiones: %.2f, fragmentación: %.1f%%, fallos: %.4f\n",
+           stats.search_length, stats.split_rate, stats.fragmentation, stats.failure_rate);
+
+    size_t medidas = 0;
+    for (int s = 0; s < ALLOC_STRATEGY_COUNT; s++) {
+        printf("  %-9s coste %8.2f en %zu ventanas\n", nombres[s], stats.cost[s], stats.windows_per_strategy[s]);
+        medidas += stats.windows_per_strategy[s];
+        if (!stats.windows_per_strategy[s]) {
+            printf("✗ %s nunca se midió\n", nombres[s]);
+            errores++;
+        }
+    }
+    if (stats.windows < 10 || medidas != stats.windows) {
+        printf("✗ Ventanas inconsistentes: %zu frente a %zu medidas\n", stats.windows, medidas);
+        errores++;
+    }
+    if (stats.explorations < ALLOC_STRATEGY_COUNT - 1 || stats.current_strategy >= ALLOC_STRATEGY_COUNT) {
+        printf("✗ Decisiones inconsistentes\n");
+        errores++;
+    }
+
+    // Tras tantas ventanas la elegida debe ser la más barata salvo histéresis
+    // o una exploración en curso
+    double minimo = stats.cost[0];
+    for (int s = 1; s < ALLOC_STRATEGY_COUNT; s++) {
+        if (stats.cost[s] < minimo) minimo = stats.cost[s];
+    }
+    if (stats.cost[stats.current_strategy] * 0.9 > minimo) {
+        printf("  (última ventana de exploración: %s cuesta más que el mínimo)\n", nombres[stats.current_strategy]);
+    }
+
+    if (!memory_pool_verify_metrics(pool)) {
+        printf("✗ Métricas incoherentes tras los cambios de estrategia\n");
+        errores++;
+    }
+
+    // Las decisiones aparecen en la exportación
+    memory_export_register_pool("adaptativo", pool);
+    char texto[64 * 1024];
+    memory_export_render(MEMORY_EXPORT_PROMETHEUS, texto, sizeof(texto));
+    if (!strstr(texto, "memory_pool_adaptive_switches_total{pool=\"adaptativo\",reason=\"exploration\"}") ||
+        !strstr(texto, "memory_pool_adaptive_strategy{pool=\"adaptativo\",strategy=\"first_fit\"}")) {
+        printf("✗ Faltan series adaptativas en Prometheus\n");
+        errores++;
+    }
+    memory_export_render(MEMORY_EXPORT_JSON, texto, sizeof(texto));
+    if (!strstr(texto, "\"adaptive\":{\"strategy\":")) {
+        printf("✗ Falta el objeto adaptive en JSON\n");
+        errores++;
+    }
+
+    // Una estrategia concreta desactiva la adaptación
+    memory_pool_set_strategy(pool, ALLOC_BEST_FIT);
+    if (memory_pool_get_strategy(pool) != ALLOC_BEST_FIT ||
+        memory_pool_get_adaptive_stats(pool, &stats) != MEMORY_ERROR_INVALID_PARAM) {
+        printf("✗ ALLOC_BEST_FIT no desactivó la adaptación\n");
+        errores++;
+    }
+    memory_export_render(MEMORY_EXPORT_PROMETHEUS, texto, sizeof(texto));
+    if (strstr(texto, "memory_pool_adaptive_strategy{")) {
+        printf("✗ Series adaptativas en un pool no adaptativo\n");
+        errores++;
+    }
+
+    // Y se puede reactivar sobre un pool en uso
+    memory_pool_set_strategy(pool, ALLOC_ADAPTIVE);
+    agitar(pool, bloques, &semilla, 20000);
+    if (memory_pool_get_adaptive_stats(pool, &stats) != MEMORY_SUCCESS || stats.windows == 0 ||
+        !memory_pool_verify_metrics(pool)) {
+        printf("✗ La adaptación reactivada no avanza\n");
+        errores++;
+    }
+
+    for (int i = 0; i < BLOQUES; i++) {
+        if (bloques[i]) memory_pool_free(pool, bloques[i], 1);
+    }
+    memory_pool_destroy(pool);
+
+    if (errores) {
+        printf("✗ %d errores\n", errores);
+        return 1;
+    }
+    printf("✓ Estrategia adaptativa correcta\n");
+    return 0;
+}
@@ -0,0 +1,186 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <poll.h>
+#include <pthread.h>
+#include "../include/memory_pool.h"
+#include "../include/memory_client.h"
+
+// Asignación con espera: timeout con el pool lleno, despertar al liberar,
+// orden FIFO entre los que esperan, cesión del turno cuando la cabeza se
+// rinde y aviso por eventfd para bucles de eventos.
+
+#define BLOQUE 1000
+#define MAX_BLOQUES 256
+
+static memory_pool_t* pool;
+static void* bloques[MAX_BLOQUES];
+static int llenos;
+
+static double ahora_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+static void dormir_ms(int ms) {
+    struct timespec ts = {ms / 1000, (long)(ms % 1000) * 1000000};
+    nanosleep(&ts, NULL);
+}
+
+// Llena el pool con bloques iguales y lo que sobra con bloques menores
+static void llenar(void) {
+    llenos = 0;
+    while (llenos < MAX_BLOQUES && (bloques[llenos] = memory_pool_alloc(pool, BLOQUE, 1))) llenos++;
+    for (size_t resto = BLOQUE / 2; resto >= 16; resto /= 2) {
+        while (memory_pool_alloc(pool, resto, 9)) {
+        }
+    }
+}
+
+typedef struct {
+    size_t tamano;
+    long timeout_ms;
+    int* orden;
+    int* siguiente;
+    int id;
+    double fin_ms;
+    void* resultado;
+} espera_t;
+
+static void* liberar_tarde(void* bloque) {
+    dormir_ms(50);
+    memory_pool_free(pool, bloque, 1);
+    return NULL;
+}
+
+static pthread_mutex_t orden_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void* esperar(void* arg) {
+    espera_t* e = arg;
+    e->resultado = memory_pool_alloc_wait(pool, e->tamano, 1, e->timeout_ms);
+    e->fin_ms = ahora_ms();
+    pthread_mutex_lock(&orden_mutex);
+    if (e->resultado) e->orden[(*e->siguiente)++] = e->id;
+    pthread_mutex_unlock(&orden_mutex);
+    return NULL;
+}
+
+int main(void) {
+    printf("=== TEST ASIGNACIÓN CON ESPERA ===\n");
+    int errores = 0;
+
+    pool = memory_pool_create(64 * 1024, ALLOC_FIRST_FIT);
+    if (!pool) return 1;
+    // La tabla del cliente vive en el pool: se crea antes de llenarlo
+    memory_client_t* cliente = memory_client_create(3, pool);
+    void* ancla = memory_client_alloc(cliente, 16);
+    if (!ancla) return 1;
+    llenar();
+    printf("Pool lleno con %d bloques de %d bytes\n", llenos, BLOQUE);
+
+    // 1. Timeout: sin liberaciones vuelve NULL tras el plazo
+    double inicio = ahora_ms();
+    if (memory_pool_alloc_wait(pool, BLOQUE, 2, 50) || ahora_ms() - inicio < 45) {
+        printf("✗ La espera con timeout no respetó el plazo\n");
+        errores++;
+    }
+    if (memory_pool_alloc_wait(pool, BLOQUE, 2, 0)) errores++;
+    if (memory_pool_alloc_wait(pool, 1024 * 1024, 2, -1)) {
+        printf("✗ Una petición mayor que el pool no debe esperar\n");
+        errores++;
+    }
+
+    // 2. FIFO: tres esperas encoladas en orden reciben los bloques en orden
+    int orden[3] = {0};
+    int siguiente = 0;
+    espera_t esperas[3];
+    pthread_t hilos[3];
+    for (int i = 0; i < 3; i++) {
+        esperas[i] = (espera_t){BLOQUE, -1, orden, &siguiente, i + 1, 0, NULL};
+        pthread_create(&hilos[i], NULL, esperar, &esperas[i]);
+        dormir_ms(30);
+    }
+    for (int i = 0; i < 3; i++) {
+        memory_pool_free(pool, bloques[--llenos], 1);
+        dormir_ms(30);
+    }
+    for (int i = 0; i < 3; i++) pthread_join(hilos[i], NULL);
+    if (siguiente != 3 || orden[0] != 1 || orden[1] != 2 || orden[2] != 3) {
+        printf("✗ Orden de servicio %d,%d,%d (esperado 1,2,3)\n", orden[0], orden[1], orden[2]);
+        errores++;
+    }
+    for (int i = 0; i < 3; i++) bloques[llenos++] = esperas[i].resultado;
+
+    // 3. La cabeza pide lo que no llega; la siguiente respeta el orden y
+    // recibe su bloque cuando la cabeza se rinde
+    siguiente = 0;
+    espera_t cabeza = {8 * BLOQUE, 150, orden, &siguiente, 1, 0, NULL};
+    espera_t detras = {BLOQUE, -1, orden, &siguiente, 2, 0, NULL};
+    inicio = ahora_ms();
+    pthread_create(&hilos[0], NULL, esperar, &cabeza);
+    dormir_ms(30);
+    pthread_create(&hilos[1], NULL, esperar, &detras);
+    dormir_ms(30);
+    memory_pool_free(pool, bloques[--llenos], 1);
+    pthread_join(hilos[0], NULL);
+    pthread_join(hilos[1], NULL);
+    if (cabeza.resultado || !detras.resultado || detras.fin_ms < cabeza.fin_ms) {
+        printf("✗ La segunda espera se adelantó a la cabeza o no recibió memoria\n");
+        errores++;
+    }
+    printf("Cabeza rendida a los %.0f ms, segunda servida a los %.0f ms\n",
+           cabeza.fin_ms - inicio, detras.fin_ms - inicio);
+    bloques[llenos++] = detras.resultado;
+
+    // 4. eventfd: un intento asíncrono fallido lo arma y la liberación lo
+    // vuelve legible
+    int fd = memory_pool_wait_fd(pool);
+    if (fd < 0 || fd != memory_pool_wait_fd(pool)) {
+        printf("✗ eventfd inválido\n");
+        return 1;
+    }
+    struct pollfd evento = {fd, POLLIN, 0};
+    if (memory_client_alloc_async(cliente, BLOQUE) || poll(&evento, 1, 0) != 0) {
+        printf("✗ Asignación asíncrona con el pool lleno\n");
+        errores++;
+    }
+    memory_pool_free(pool, bloques[--llenos], 1);
+    if (poll(&evento, 1, 1000) != 1) {
+        printf("✗ El eventfd no se activó al liberar\n");
+        errores++;
+    }
+    uint64_t valor;
+    if (read(fd, &valor, sizeof(valor)) != (ssize_t)sizeof(valor)) errores++;
+    void* asincrono = memory_client_alloc_async(cliente, BLOQUE);
+    if (!asincrono) {
+        printf("✗ El reintento tras el aviso no obtuvo memoria\n");
+        errores++;
+    }
+    memory_client_free(cliente, asincrono);
+
+    // 5. Con el cliente: espera sin límite que despierta otro hilo
+    void* retenido = memory_client_alloc_async(cliente, BLOQUE);
+    if (!retenido) errores++;
+    pthread_t liberador;
+    pthread_create(&liberador, NULL, liberar_tarde, bloques[--llenos]);
+    void* esperado = memory_client_alloc_wait(cliente, BLOQUE, -1);
+    pthread_join(liberador, NULL);
+    if (!esperado) {
+        printf("✗ La espera del cliente no recibió memoria\n");
+        errores++;
+    }
+    if (memory_client_get_allocated_count(cliente) != 3) errores++;
+    memory_client_destroy(cliente);
+    memory_pool_destroy(pool);
+
+    if (errores) {
+        printf("✗ %d errores\n", errores);
+        return 1;
+    }
+    printf("✓ Asignación con espera correcta\n");
+    return 0;
+}
@@ -0,0 +1,138 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "../include/memory_pool.h"
+#include "../include/memory_client.h"
+#include "../include/memory_trace.h"
+
+#define NUM_THREADS 4
+#define OPS_PER_THREAD 5000
+
+static memory_pool_t* pool;
+
+static void* trabajador(void* arg) {
+    int id = (int)(intptr_t)arg;
+    memory_client_t* client = memory_client_create(id, pool);
+    unsigned int seed = (unsigned int)id;
+    void* slots[64] = {0};
+
+    for (int i = 0; i < OPS_PER_THREAD; i++) {
+        int slot = rand_r(&seed) % 64;
+        if (slots[slot]) {
+            memory_client_free(client, slots[slot]);
+            slots[slot] = NULL;
+        } else {
+            slots[slot] = memory_client_alloc(client, 16 + rand_r(&seed) % 512);
+        }
+    }
+
+    memory_client_free_all(client);
+    memory_client_destroy(client);
+    return NULL;
+}
+
+int main() {
+    printf("=== TEST TRAZA DE ASIGNACIONES ===\n");
+
+    char path[] = "/tmp/memory_trace_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) return 1;
+    close(fd);
+
+    pool = memory_pool_create(4 * 1024 * 1024, ALLOC_BEST_FIT);
+    if (memory_trace_start(path, 1 << 16) != MEMORY_SUCCESS) {
+        printf("✗ No se pudo iniciar la traza\n");
+        return 1;
+    }
+
+    pthread_t threads[NUM_THREADS];
+    for (int i = 0; i < NUM_THREADS; i++) {
+        pthread_create(&threads[i], NULL, trabajador, (void*)(intptr_t)(i + 1));
+    }
+    for (int i = 0; i < NUM_THREADS; i++) pthread_join(threads[i], NULL);
+
+    // Un realloc que mueve el bloque se registra como un único evento
+    void* original = memory_pool_alloc(pool, 64, 99);
+    void* bloqueo = memory_pool_alloc(pool, 64, 99);
+    void* movido = memory_pool_realloc(pool, original, 8192, 99);
+    memory_pool_free(pool, bloqueo, 99);
+    memory_pool_free(pool, movido, 99);
+
+    int errores = 0;
+    if (memory_trace_stop() != MEMORY_SUCCESS || memory_trace_is_active()) errores++;
+
+    memory_trace_stats_t stats;
+    memory_trace_get_stats(&stats);
+    printf("Eventos: %zu registrados, %zu escritos, %zu descartados\n",
+           stats.recorded_events, stats.written_events, stats.dropped_events);
+    if (stats.recorded_events == 0 || stats.written_events != stats.recorded_events) {
+        printf("✗ No se escribieron todos los eventos registrados\n");
+        errores++;
+    }
+
+    // Releer el archivo: cabecera válida y asignaciones/liberaciones emparejadas
+    FILE* file = fopen(path, "rb");
+    memory_trace_file_header_t header;
+    if (!file || fread(&header, sizeof(header), 1, file) != 1 ||
+        memcmp(header.magic, MEMORY_TRACE_MAGIC, sizeof(MEMORY_TRACE_MAGIC)) != 0 ||
+        header.version != MEMORY_TRACE_VERSION || header.event_size != sizeof(memory_trace_event_t)) {
+        printf("✗ Cabecera de traza inválida\n");
+        return 1;
+    }
+
+    memory_trace_event_t event;
+    size_t allocs = 0, frees = 0, reallocs = 0, total = 0;
+    uint32_t hilos_vistos = 0;
+    while (fread(&event, sizeof(event), 1, file) == 1) {
+        total++;
+        if (event.type == MEMORY_TRACE_ALLOC && event.address) allocs++;
+        if (event.type == MEMORY_TRACE_FREE) frees++;
+        if (event.type == MEMORY_TRACE_REALLOC && event.address == (uintptr_t)movido &&
+            event.old_address == (uintptr_t)original && event.size == 8192) {
+            reallocs++;
+        }
+        if (event.thread > hilos_vistos) hilos_vistos = event.thread;
+    }
+    fclose(file);
+    unlink(path);
+
+    printf("Archivo: %zu eventos (%zu allocs, %zu frees, %u hilos)\n", total, allocs, frees, hilos_vistos);
+    if (total != stats.written_events || (stats.dropped_events == 0 && (allocs != frees || reallocs != 1)) ||
+        hilos_vistos < NUM_THREADS) {
+        printf("✗ Contenido de la traza inconsistente\n");
+        errores++;
+    }
+
+    // Una segunda traza numera los hilos desde 1 otra vez. Las liberaciones
+    // rechazadas (doble, de otro cliente) no dejan evento
+    if (memory_trace_start(path, 1 << 10) != MEMORY_SUCCESS) errores++;
+    void* bloque = memory_pool_alloc(pool, 64, 99);
+    memory_pool_free(pool, bloque, 98);
+    memory_pool_free(pool, bloque, 99);
+    memory_pool_free(pool, bloque, 99);
+    memory_trace_stop();
+
+    file = fopen(path, "rb");
+    size_t eventos = 0, liberaciones = 0;
+    uint32_t hilo_maximo = 0;
+    if (!file || fread(&header, sizeof(header), 1, file) != 1) errores++;
+    while (file && fread(&event, sizeof(event), 1, file) == 1) {
+        eventos++;
+        if (event.type == MEMORY_TRACE_FREE) liberaciones++;
+        if (event.thread > hilo_maximo) hilo_maximo = event.thread;
+    }
+    if (file) fclose(file);
+    unlink(path);
+    if (eventos != 2 || liberaciones != 1 || hilo_maximo != 1) {
+        printf("✗ Segunda traza: %zu eventos, %zu liberaciones, hilo %u\n", eventos, liberaciones, hilo_maximo);
+        errores++;
+    }
+
+    memory_pool_destroy(pool);
+
+    printf("=== Test %s ===\n", errores ? "FALLIDO" : "completado");
+    return errores ? 1 : 0;
+}
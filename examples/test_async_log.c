@@ -0,0 +1,107 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "../include/memory_pool.h"
+#include "../include/memory_log.h"
+
+// Backend de log asíncrono: nivel en tiempo de ejecución, un anillo por hilo
+// y volcado a archivo sin perder ni duplicar mensajes.
+
+#define HILOS 4
+#define MENSAJES 500
+
+static memory_pool_t* pool;
+
+// Cada alloc de tamaño 0 registra un ERROR; las asignaciones válidas
+// registran mensajes DEBUG que el nivel WARN debe filtrar
+static void* productor(void* arg) {
+    (void)arg;
+    for (int i = 0; i < MENSAJES; i++) {
+        memory_pool_alloc(pool, 0, 1);
+        void* ptr = memory_pool_alloc(pool, 64, 1);
+        memory_pool_free(pool, ptr, 1);
+    }
+    return NULL;
+}
+
+static size_t contar_lineas(const char* path, const char* texto) {
+    FILE* file = fopen(path, "r");
+    if (!file) return 0;
+    char linea[512];
+    size_t total = 0;
+    while (fgets(linea, sizeof(linea), file)) {
+        if (strstr(linea, texto)) total++;
+    }
+    fclose(file);
+    return total;
+}
+
+int main(void) {
+    printf("=== TEST LOG ASÍNCRONO ===\n");
+
+    char path[] = "/tmp/memory_log_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) return 1;
+    close(fd);
+
+    pool = memory_pool_create(1024 * 1024, ALLOC_FIRST_FIT);
+    if (!pool) return 1;
+    int errores = 0;
+
+    memory_log_level_t nivel_inicial = memory_log_get_level();
+    memory_log_set_level(MEMORY_LOG_WARN);
+    if (memory_log_start_async(path, 256) != MEMORY_SUCCESS || memory_log_start_async(path, 256) == MEMORY_SUCCESS) {
+        printf("✗ Arranque del backend incorrecto\n");
+        errores++;
+    }
+
+    pthread_t hilos[HILOS];
+    for (int i = 0; i < HILOS; i++) pthread_create(&hilos[i], NULL, productor, NULL);
+    for (int i = 0; i < HILOS; i++) pthread_join(hilos[i], NULL);
+    memory_log_stop_async();
+
+    memory_log_stats_t stats;
+    memory_log_get_stats(&stats);
+    size_t en_archivo = contar_lineas(path, "Parámetros inválidos para alloc");
+    printf("Escritos %zu, descartados %zu, anillos %zu\n", stats.written_messages, stats.dropped_messages,
+           stats.thread_rings);
+
+    if (stats.written_messages + stats.dropped_messages != HILOS * MENSAJES ||
+        en_archivo != stats.written_messages || stats.written_messages == 0) {
+        printf("✗ %zu mensajes en el archivo para %zu escritos\n", en_archivo, stats.written_messages);
+        errores++;
+    }
+    if (contar_lineas(path, "[MEMORY-DEBUG]") != 0 || contar_lineas(path, "[hilo ") != en_archivo) {
+        printf("✗ Mensajes por debajo del nivel o sin hilo\n");
+        errores++;
+    }
+    if (stats.thread_rings < 1 || stats.thread_rings > HILOS) {
+        printf("✗ %zu anillos para %d hilos\n", stats.thread_rings, HILOS);
+        errores++;
+    }
+
+    // Los anillos de hilos terminados se reutilizan; con OFF no se registra nada
+    memory_log_set_level(MEMORY_LOG_OFF);
+    memory_log_start_async(path, 256);
+    for (int i = 0; i < HILOS; i++) pthread_create(&hilos[i], NULL, productor, NULL);
+    for (int i = 0; i < HILOS; i++) pthread_join(hilos[i], NULL);
+    memory_log_stop_async();
+
+    size_t anillos = stats.thread_rings;
+    memory_log_get_stats(&stats);
+    if (stats.written_messages != 0 || stats.dropped_messages != 0 || stats.thread_rings != anillos ||
+        contar_lineas(path, "Parámetros inválidos para alloc") != en_archivo) {
+        printf("✗ Se registraron mensajes con el nivel OFF\n");
+        errores++;
+    }
+
+    memory_log_set_level(nivel_inicial);
+    memory_pool_destroy(pool);
+    unlink(path);
+
+    printf("=== Test %s ===\n", errores ? "FALLIDO" : "completado");
+    return errores ? 1 : 0;
+}
@@ -0,0 +1,122 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../include/memory_pool.h"
+#include "../include/memory_client.h"
+#include "../include/memory_metrics.h"
+
+#define NUM_BLOCKS 100000
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+int main() {
+    printf("=== TEST LIBERACIÓN EN BLOQUE ===\n");
+
+    memory_pool_t* pool = memory_pool_create(64 * 1024 * 1024, ALLOC_FIRST_FIT);
+    memory_client_t* grande = memory_client_create(1, pool);
+    memory_client_t* vecino = memory_client_create(2, pool);
+    if (!pool || !grande || !vecino) return 1;
+
+    // Bloques intercalados: cada 10 del cliente grande, uno del vecino
+    static void* del_vecino[NUM_BLOCKS / 10];
+    int errores = 0;
+    for (int i = 0; i < NUM_BLOCKS; i++) {
+        if (!memory_client_alloc(grande, 32 + (i % 7) * 16)) errores++;
+        if (i % 10 == 0) {
+            del_vecino[i / 10] = memory_client_alloc(vecino, 48);
+            memset(del_vecino[i / 10], 0xAB, 48);
+        }
+    }
+
+    double inicio = now_ms();
+    memory_client_free_all(grande);
+    double transcurrido = now_ms() - inicio;
+    printf("free_all de %d bloques: %.2f ms\n", NUM_BLOCKS, transcurrido);
+
+    if (memory_client_get_allocated_count(grande) != 0) errores++;
+    if (!memory_pool_verify_metrics(pool) || !memory_pool_check(pool)) {
+        printf("✗ Estructuras del pool inconsistentes tras la liberación en bloque\n");
+        errores++;
+    }
+
+    // Los bloques del vecino siguen intactos
+    for (int i = 0; i < NUM_BLOCKS / 10; i++) {
+        unsigned char* p = del_vecino[i];
+        if (p[0] != 0xAB || p[47] != 0xAB) {
+            errores++;
+            break;
+        }
+    }
+
+    pool_metrics_t metrics;
+    memory_pool_get_metrics(pool, &metrics);
+    // Bloques del vecino más el array de su tabla de seguimiento
+    if (metrics.used_blocks != NUM_BLOCKS / 10 + 1 || metrics.free_count < NUM_BLOCKS) {
+        printf("✗ Métricas: %d usados, %zu liberaciones\n", metrics.used_blocks, metrics.free_count);
+        errores++;
+    }
+
+    // Punteros inválidos o ajenos se ignoran en la liberación en bloque
+    void* mezcla[3] = {del_vecino[0], NULL, del_vecino[1]};
+    if (memory_pool_free_bulk(pool, mezcla, 3, 1) != 0) errores++;
+    if (memory_pool_free_bulk(pool, mezcla, 3, 2) != 2) errores++;
+
+    memory_client_destroy(vecino);
+    memory_pool_get_metrics(pool, &metrics);
+    if (metrics.used_blocks != 0 || metrics.free_blocks != 1) {
+        printf("✗ El pool no volvió a un único bloque libre\n");
+        errores++;
+    }
+
+    memory_client_destroy(grande);
+    memory_pool_destroy(pool);
+
+    // Un lote pequeño al principio de un heap grande se libera uno a uno
+    // (recorre solo lo que lo precede); al final del heap compensa la pasada
+    // única en lugar de recorrerlo casi entero por cada bloque
+    enum { HEAP_BLOQUES = 20000, LOTE = 32 };
+    memory_pool_t* largo = memory_pool_create(4 * 1024 * 1024, ALLOC_FIRST_FIT);
+    static void* bloques[HEAP_BLOQUES];
+    for (int i = 0; i < HEAP_BLOQUES; i++) {
+        if (!(bloques[i] = memory_pool_alloc(largo, 64, 3))) errores++;
+    }
+    void* lote[LOTE];
+    pool_cost_counters_t antes, despues;
+
+    for (int i = 0; i < LOTE; i++) lote[i] = bloques[2 * i];
+    memory_pool_get_cost_counters(largo, &antes);
+    if (memory_pool_free_bulk(largo, lote, LOTE, 3) != LOTE) errores++;
+    memory_pool_get_cost_counters(largo, &despues);
+    size_t recorridos = despues.backward_walk_steps - antes.backward_walk_steps;
+    if (recorridos == 0 || recorridos > LOTE * 2 * LOTE) {
+        printf("✗ Lote inicial: %zu headers recorridos\n", recorridos);
+        errores++;
+    }
+
+    for (int i = 0; i < LOTE; i++) lote[i] = bloques[HEAP_BLOQUES - 1 - 2 * i];
+    memory_pool_get_cost_counters(largo, &antes);
+    if (memory_pool_free_bulk(largo, lote, LOTE, 3) != LOTE) errores++;
+    memory_pool_get_cost_counters(largo, &despues);
+    if (despues.backward_walk_steps != antes.backward_walk_steps) {
+        printf("✗ Lote final liberado uno a uno: %zu headers recorridos\n",
+               despues.backward_walk_steps - antes.backward_walk_steps);
+        errores++;
+    }
+
+    memory_pool_get_metrics(largo, &metrics);
+    if (metrics.used_blocks != HEAP_BLOQUES - 2 * LOTE ||
+        !memory_pool_verify_metrics(largo) || !memory_pool_check(largo)) {
+        printf("✗ Pool inconsistente tras los lotes pequeños\n");
+        errores++;
+    }
+    memory_pool_destroy(largo);
+
+    printf("=== Test %s ===\n", errores ? "FALLIDO" : "completado");
+    return errores ? 1 : 0;
+}
@@ -0,0 +1,115 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "../include/memory_pool.h"
+#include "../include/memory_client.h"
+#include "../include/memory_metrics.h"
+
+// Colocación afín: con asignaciones intercaladas de varios clientes,
+// ninguna línea de caché contiene bytes de dos clientes distintos. Sin el
+// flag, los bloques contiguos de clientes distintos sí las comparten.
+
+#define CLIENTES 4
+#define RONDAS 200
+#define LINEA MEMORY_CACHE_LINE
+
+typedef struct {
+    uintptr_t inicio;
+    size_t tamano;
+    int cliente;
+} tramo_t;
+
+static int comparar(const void* a, const void* b) {
+    const tramo_t* x = a;
+    const tramo_t* y = b;
+    return x->inicio < y->inicio ? -1 : x->inicio > y->inicio;
+}
+
+// Cuenta las líneas de caché en las que escriben dos clientes distintos
+static size_t lineas_compartidas(tramo_t* tramos, size_t n) {
+    qsort(tramos, n, sizeof(tramo_t), comparar);
+    size_t compartidas = 0;
+    for (size_t i = 1; i < n; i++) {
+        uintptr_t ultima_anterior = (tramos[i - 1].inicio + tramos[i - 1].tamano - 1) / LINEA;
+        if (tramos[i].cliente != tramos[i - 1].cliente && tramos[i].inicio / LINEA == ultima_anterior) {
+            compartidas++;
+        }
+    }
+    return compartidas;
+}
+
+static size_t probar(unsigned flags, int* errores) {
+    memory_pool_t* pool = memory_pool_create(8 * 1024 * 1024, ALLOC_FIRST_FIT);
+    memory_client_t* clientes[CLIENTES];
+    for (int c = 0; c < CLIENTES; c++) clientes[c] = memory_client_create_ex(c + 1, pool, flags);
+
+    // Pequeños, medianos (fuera del sub-heap) y alineados, intercalados
+    static tramo_t tramos[CLIENTES * RONDAS * 3];
+    size_t n = 0;
+    const size_t tamanos[] = {24, 1500, 100};
+    for (int r = 0; r < RONDAS; r++) {
+        for (int t = 0; t < 3; t++) {
+            for (int c = 0; c < CLIENTES; c++) {
+                size_t tamano = tamanos[t] + (size_t)(r % 5);
+                unsigned char* p = t == 2 ? memory_client_alloc_aligned(clientes[c], 16, tamano)
+                                          : memory_client_alloc(clientes[c], tamano);
+                if (!p) {
+                    (*errores)++;
+                    continue;
+                }
+                memset(p, c + 1, tamano);
+                tramos[n++] = (tramo_t){(uintptr_t)p, tamano, c};
+            }
+        }
+    }
+
+    // El contenido de cada cliente sigue intacto
+    for (size_t i = 0; i < n; i++) {
+        const unsigned char* p = (const unsigned char*)tramos[i].inicio;
+        for (size_t j = 0; j < tramos[i].tamano; j++) {
+            if (p[j] != tramos[i].cliente + 1) {
+                printf("✗ Bloque del cliente %d sobrescrito\n", tramos[i].cliente + 1);
+                (*errores)++;
+                break;
+            }
+        }
+    }
+
+    size_t compartidas = lineas_compartidas(tramos, n);
+
+    for (int c = 0; c < CLIENTES; c++) memory_client_destroy(clientes[c]);
+    pool_metrics_t metricas;
+    memory_pool_get_metrics(pool, &metricas);
+    if (metricas.used_blocks != 0 || !memory_pool_check(pool)) {
+        printf("✗ El pool no quedó vacío y consistente (%d bloques)\n", metricas.used_blocks);
+        (*errores)++;
+    }
+    memory_pool_destroy(pool);
+    return compartidas;
+}
+
+int main(void) {
+    printf("=== TEST COLOCACIÓN AFÍN POR CLIENTE ===\n");
+    int errores = 0;
+
+    size_t normal = probar(0, &errores);
+    size_t afin = probar(MEMORY_CLIENT_FLAG_AFFINE, &errores);
+    printf("Líneas compartidas entre clientes: %zu sin afinidad, %zu con afinidad\n", normal, afin);
+
+    if (normal == 0) {
+        printf("✗ Sin afinidad los clientes deberían compartir líneas\n");
+        errores++;
+    }
+    if (afin != 0) {
+        printf("✗ Con afinidad hay %zu líneas compartidas\n", afin);
+        errores++;
+    }
+
+    if (errores) {
+        printf("✗ %d errores\n", errores);
+        return 1;
+    }
+    printf("✓ Colocación afín correcta\n");
+    return 0;
+}
@@ -0,0 +1,83 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/memory_pool.h"
+#include "../include/memory_client.h"
+#include "../include/memory_metrics.h"
+
+#define NUM_SLOTS 2000
+
+int main() {
+    printf("=== TEST SUB-HEAP PRIVADO DEL CLIENTE ===\n");
+
+    memory_pool_t* pool = memory_pool_create(8 * 1024 * 1024, ALLOC_FIRST_FIT);
+    memory_client_t* client = memory_client_create(5, pool);
+    if (!pool || !client) return 1;
+
+    int errores = 0;
+    if (memory_client_reserve(client, 16 * 1024) != MEMORY_SUCCESS) {
+        printf("✗ No se pudo reservar el sub-heap\n");
+        return 1;
+    }
+
+    // Mezcla de tamaños: los pequeños van al sub-heap y los grandes al pool
+    static void* slots[NUM_SLOTS];
+    static size_t sizes[NUM_SLOTS];
+    unsigned int seed = 99;
+    size_t vivos = 0;
+
+    for (int round = 0; round < 20; round++) {
+        for (int i = 0; i < NUM_SLOTS; i++) {
+            if (slots[i] && rand_r(&seed) % 2) {
+                unsigned char* p = slots[i];
+                if (p[0] != (unsigned char)i || p[sizes[i] - 1] != (unsigned char)i) errores++;
+                if (memory_client_free(client, slots[i]) != MEMORY_SUCCESS) errores++;
+                slots[i] = NULL;
+                vivos--;
+            } else if (!slots[i]) {
+                sizes[i] = (rand_r(&seed) % 10 == 0) ? 2048 + rand_r(&seed) % 2048 : 1 + rand_r(&seed) % 1024;
+                slots[i] = memory_client_alloc(client, sizes[i]);
+                if (!slots[i]) {
+                    errores++;
+                    continue;
+                }
+                memset(slots[i], i & 0xFF, sizes[i]);
+                vivos++;
+            }
+        }
+    }
+
+    if (errores) printf("✗ Contenido corrupto o liberaciones fallidas\n");
+    if (memory_client_get_allocated_count(client) != vivos) {
+        printf("✗ Cuenta del cliente %zu, esperado %zu\n", memory_client_get_allocated_count(client), vivos);
+        errores++;
+    }
+
+    // Doble liberación en el sub-heap: se ignora como en el pool
+    void* p = memory_client_alloc(client, 32);
+    memory_client_free(client, p);
+    if (memory_client_free(client, p) != MEMORY_SUCCESS) errores++;
+
+    // free_all devuelve los tramos y el pool queda con un único bloque libre
+    memory_client_free_all(client);
+    pool_metrics_t metrics;
+    memory_pool_get_metrics(pool, &metrics);
+    if (memory_client_get_allocated_count(client) != 0 || metrics.used_blocks != 0 || metrics.free_blocks != 1) {
+        printf("✗ Quedaron bloques tras free_all (%d usados)\n", metrics.used_blocks);
+        errores++;
+    }
+    if (!memory_pool_verify_metrics(pool)) errores++;
+
+    // Con el flag de creación el sub-heap se reserva en la primera asignación
+    memory_client_t* lazy = memory_client_create_ex(6, pool, MEMORY_CLIENT_FLAG_SUBHEAP);
+    void* q = memory_client_alloc(lazy, 100);
+    if (!q || memory_client_free(lazy, q) != MEMORY_SUCCESS) errores++;
+    memory_client_destroy(lazy);
+
+    memory_client_destroy(client);
+    memory_pool_destroy(pool);
+
+    printf("=== Test %s ===\n", errores ? "FALLIDO" : "completado");
+    return errores ? 1 : 0;
+}
@@ -0,0 +1,80 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include "../include/memory_pool.h"
+#include "../include/memory_client.h"
+#include "../include/memory_metrics.h"
+
+#define NUM_BLOCKS 20000
+
+// La tabla de bloques del cliente crece, encoge con free_all y vive en el pool
+int main() {
+    printf("=== TEST TABLA DE BLOQUES DEL CLIENTE ===\n");
+
+    memory_pool_t* pool = memory_pool_create(16 * 1024 * 1024, ALLOC_BEST_FIT);
+    memory_client_t* client = memory_client_create(3, pool);
+    memory_client_t* otro = memory_client_create(4, pool);
+    if (!pool || !client || !otro) return 1;
+
+    static void* blocks[NUM_BLOCKS];
+    int errores = 0;
+    unsigned int seed = 42;
+
+    for (int i = 0; i < NUM_BLOCKS; i++) {
+        blocks[i] = memory_client_alloc(client, 16 + rand_r(&seed) % 256);
+        if (!blocks[i]) errores++;
+    }
+    if (memory_client_get_allocated_count(client) != NUM_BLOCKS) {
+        printf("✗ Cuenta tras asignar: %zu\n", memory_client_get_allocated_count(client));
+        errores++;
+    }
+
+    // Liberar en orden aleatorio la mitad (ejercita el desplazamiento hacia atrás)
+    size_t vivos = NUM_BLOCKS;
+    for (int i = 0; i < NUM_BLOCKS; i++) {
+        int j = i + rand_r(&seed) % (NUM_BLOCKS - i);
+        void* tmp = blocks[i];
+        blocks[i] = blocks[j];
+        blocks[j] = tmp;
+    }
+    for (int i = 0; i < NUM_BLOCKS / 2; i++) {
+        if (memory_client_free(client, blocks[i]) != MEMORY_SUCCESS) errores++;
+        blocks[i] = NULL;
+        vivos--;
+    }
+    if (memory_client_get_allocated_count(client) != vivos) {
+        printf("✗ Cuenta tras liberar: %zu (esperado %zu)\n",
+               memory_client_get_allocated_count(client), vivos);
+        errores++;
+    }
+
+    // Un bloque de otro cliente no debe poder liberarse ni alterar la tabla
+    void* ajeno = memory_client_alloc(otro, 64);
+    if (memory_client_free(client, ajeno) == MEMORY_SUCCESS) errores++;
+    if (memory_client_get_allocated_count(client) != vivos) errores++;
+
+    // Los restantes siguen localizables
+    for (int i = NUM_BLOCKS / 2; i < NUM_BLOCKS; i++) {
+        if (memory_client_free(client, blocks[i]) != MEMORY_SUCCESS) errores++;
+    }
+    if (memory_client_get_allocated_count(client) != 0) errores++;
+
+    memory_client_free_all(client);
+    memory_client_free_all(otro);
+
+    // Con la tabla devuelta al pool, este vuelve a un único bloque libre
+    pool_metrics_t metrics;
+    memory_pool_get_metrics(pool, &metrics);
+    if (metrics.used_blocks != 0 || metrics.free_blocks != 1) {
+        printf("✗ Pool no vacío tras free_all (%d usados, %d libres)\n",
+               metrics.used_blocks, metrics.free_blocks);
+        errores++;
+    }
+
+    memory_client_destroy(client);
+    memory_client_destroy(otro);
+    memory_pool_destroy(pool);
+
+    printf("=== Test %s ===\n", errores ? "FALLIDO" : "completado");
+    return errores ? 1 : 0;
+}
@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/memory_pool.h"
+#include "../include/memory_metrics.h"
+
+// Contadores de coste: cada búsqueda, división, fusión, limpieza y toma del
+// mutex queda contada donde ocurre.
+
+static int comprobar(const char* que, size_t obtenido, size_t esperado) {
+    if (obtenido == esperado) return 0;
+    printf("✗ %s: %zu (esperado %zu)\n", que, obtenido, esperado);
+    return 1;
+}
+
+int main(void) {
+    printf("=== TEST CONTADORES DE COSTE ===\n");
+
+    const size_t tamano = 1024 * 1024;
+    memory_pool_t* pool = memory_pool_create(tamano, ALLOC_FIRST_FIT);
+    memory_pool_t* perezoso = memory_pool_create_ex(tamano, ALLOC_FIRST_FIT, MEMORY_POOL_FLAG_LAZY);
+    if (!pool || !perezoso) {
+        printf("Error creando pools\n");
+        return 1;
+    }
+    int errores = 0;
+    pool_cost_counters_t costes;
+
+    // La creación limpia el heap entero salvo en modo perezoso
+    memory_pool_get_cost_counters(pool, &costes);
+    errores += comprobar("bytes a cero al crear", costes.bytes_zeroed, tamano);
+    errores += comprobar("búsquedas al crear", costes.searches, 0);
+    memory_pool_get_cost_counters(perezoso, &costes);
+    errores += comprobar("bytes a cero al crear en perezoso", costes.bytes_zeroed, 0);
+
+    // Tres asignaciones dividen el bloque libre final tres veces
+    void* a = memory_pool_alloc(pool, 100, 1);
+    void* b = memory_pool_alloc(pool, 100, 1);
+    void* c = memory_pool_alloc(pool, 100, 1);
+    memory_pool_get_cost_counters(pool, &costes);
+    errores += comprobar("búsquedas", costes.searches, 3);
+    errores += comprobar("bloques examinados", costes.search_steps, 3);
+    errores += comprobar("divisiones", costes.splits, 3);
+    size_t tomas = costes.lock_acquisitions;
+    if (tomas < 3) {
+        printf("✗ Solo %zu tomas del mutex para tres asignaciones\n", tomas);
+        errores++;
+    }
+
+    // b no tiene vecinos libres; a se fusiona con b (siguiente); c con el
+    // resto del heap (siguiente) y con a+b (anterior, recorriendo desde el
+    // principio)
+    memory_pool_free(pool, b, 1);
+    memory_pool_get_cost_counters(pool, &costes);
+    errores += comprobar("fusiones tras liberar b", costes.forward_merges + costes.backward_merges, 0);
+    errores += comprobar("headers recorridos buscando el anterior de b", costes.backward_walk_steps, 1);
+
+    memory_pool_free(pool, a, 1);
+    memory_pool_get_cost_counters(pool, &costes);
+    errores += comprobar("fusiones con el siguiente tras liberar a", costes.forward_merges, 1);
+
+    memory_pool_free(pool, c, 1);
+    memory_pool_get_cost_counters(pool, &costes);
+    errores += comprobar("fusiones con el siguiente tras liberar c", costes.forward_merges, 2);
+    errores += comprobar("fusiones con el anterior tras liberar c", costes.backward_merges, 1);
+    errores += comprobar("headers recorridos buscando el anterior de c", costes.backward_walk_steps, 2);
+    if (costes.lock_acquisitions <= tomas) {
+        printf("✗ Las liberaciones no tomaron el mutex\n");
+        errores++;
+    }
+
+    // Reasignar memoria ya escrita la vuelve a limpiar
+    void* d = memory_pool_alloc(pool, 256, 1);
+    memory_pool_get_cost_counters(pool, &costes);
+    if (costes.bytes_zeroed <= tamano) {
+        printf("✗ Reasignar memoria usada no contó bytes limpiados\n");
+        errores++;
+    }
+    memory_pool_free(pool, d, 1);
+
+    memory_pool_print_cost_counters(pool);
+
+    memory_pool_destroy(perezoso);
+    memory_pool_destroy(pool);
+
+    if (errores) {
+        printf("✗ %d errores\n", errores);
+        return 1;
+    }
+    printf("✓ Contadores de coste correctos\n");
+    return 0;
+}
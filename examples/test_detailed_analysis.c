@@ -130,6 +130,14 @@ void test_fragmentation_scenario() {
     printf("Estado después de fragmentación:\n");
     printf("  Bloques libres: %d, Fragmentación: %.1f%%, Mayor bloque libre: %zu bytes\n",
            frag_metrics.free_blocks, frag_metrics.fragmentation, frag_metrics.largest_free_block);
+    memory_pool_print_free_distribution(pool);
+
+    // La vista por clase debe predecir el resultado de la asignación grande
+    pool_free_distribution_t distribution;
+    memory_pool_get_free_distribution(pool, &distribution);
+    int large_class = 10; // 2000 bytes está en [1024, 2048)
+    printf("  Máx. asignable en clase [1024, 2048): %zu bytes\n",
+           distribution.max_allocatable[large_class]);
 
     // Verificar integridad antes de asignación grande
     if (memory_pool_check(pool)!=0) {
@@ -0,0 +1,145 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "../include/memory_pool.h"
+#include "../include/memory_metrics.h"
+#include "../include/memory_guard.h"
+
+// Asignador de muestreo con guarda: desbordamientos y usos tras liberar se
+// ejecutan en un hijo, que debe morir por SIGSEGV tras reportar el cliente.
+
+#define CLIENTE 7
+#define HUECOS 8
+
+typedef enum { DESBORDAMIENTO, USO_TRAS_LIBERAR } fallo_t;
+
+// Ejecuta el fallo en un hijo y devuelve su stderr en salida
+static int provocar(memory_pool_t* pool, fallo_t fallo, char* salida, size_t capacidad) {
+    int tuberia[2];
+    if (pipe(tuberia) != 0) return -1;
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        dup2(tuberia[1], STDERR_FILENO);
+        close(tuberia[0]);
+
+        volatile char* p = memory_pool_alloc(pool, 100, CLIENTE);
+        if (fallo == DESBORDAMIENTO) {
+            p[ALIGN_SIZE(100)] = 1;
+        } else {
+            memory_pool_free(pool, (void*)p, CLIENTE);
+            (void)p[10];
+        }
+        _exit(0);
+    }
+
+    close(tuberia[1]);
+    size_t leido = 0;
+    ssize_t n;
+    while (leido + 1 < capacidad && (n = read(tuberia[0], salida + leido, capacidad - 1 - leido)) > 0) {
+        leido += (size_t)n;
+    }
+    salida[leido] = '\0';
+    close(tuberia[0]);
+
+    int estado;
+    waitpid(pid, &estado, 0);
+    return WIFSIGNALED(estado) ? WTERMSIG(estado) : 0;
+}
+
+int main(void) {
+    printf("=== TEST ASIGNADOR CON PÁGINAS DE GUARDA ===\n");
+
+    memory_pool_t* pool = memory_pool_create(1024 * 1024, ALLOC_FIRST_FIT);
+    if (!pool || memory_guard_start(1, HUECOS) != MEMORY_SUCCESS) {
+        printf("Error creando pool o región de guarda\n");
+        return 1;
+    }
+    int errores = 0;
+    long pagina = sysconf(_SC_PAGESIZE);
+
+    // Con tasa 1 todas las asignaciones se muestrean: el bloque acaba justo
+    // antes de la página de guarda
+    char* p = memory_pool_alloc(pool, 100, CLIENTE);
+    if (!p || ((uintptr_t)(p + ALIGN_SIZE(100)) % (uintptr_t)pagina) != 0 ||
+        memory_pool_usable_size(pool, p) != 100) {
+        printf("✗ El bloque muestreado no está al final de su página\n");
+        errores++;
+    }
+    strcpy(p, "contenido");
+    char* q = memory_pool_realloc(pool, p, 3000, CLIENTE);
+    if (!q || strcmp(q, "contenido") != 0) {
+        printf("✗ realloc de un bloque muestreado perdió el contenido\n");
+        errores++;
+    }
+    memory_pool_free(pool, q, CLIENTE);
+
+    char salida[8192];
+    int senal = provocar(pool, DESBORDAMIENTO, salida, sizeof(salida));
+    if (senal != SIGSEGV || !strstr(salida, "desbordamiento de búfer") || !strstr(salida, "cliente 7")) {
+        printf("✗ Desbordamiento no reportado (señal %d):\n%s\n", senal, salida);
+        errores++;
+    }
+    senal = provocar(pool, USO_TRAS_LIBERAR, salida, sizeof(salida));
+    if (senal != SIGSEGV || !strstr(salida, "uso tras liberar") || !strstr(salida, "Liberado por")) {
+        printf("✗ Uso tras liberar no reportado (señal %d):\n%s\n", senal, salida);
+        errores++;
+    }
+
+    // Errores detectados al liberar, sin terminar el proceso
+    memory_guard_stats_t antes, despues;
+    memory_guard_get_stats(&antes);
+    char* r = memory_pool_alloc(pool, 13, CLIENTE);
+    r[13] = 'x';
+    if (memory_pool_free(pool, r, CLIENTE) != MEMORY_SUCCESS ||
+        memory_pool_free(pool, r, CLIENTE) != MEMORY_ERROR_CORRUPTION) {
+        printf("✗ Doble liberación no rechazada\n");
+        errores++;
+    }
+    memory_guard_get_stats(&despues);
+    if (despues.errors_detected != antes.errors_detected + 2) {
+        printf("✗ Se esperaban 2 errores nuevos, hubo %zu\n", despues.errors_detected - antes.errors_detected);
+        errores++;
+    }
+
+    // Sin huecos libres la asignación sigue por el pool
+    void* bloques[HUECOS + 4];
+    for (int i = 0; i < HUECOS + 4; i++) bloques[i] = memory_pool_alloc(pool, 64, CLIENTE);
+    memory_guard_get_stats(&despues);
+    if (despues.slots_in_use != HUECOS || despues.skipped_allocations < 4) {
+        printf("✗ Huecos en uso %zu, omitidas %zu\n", despues.slots_in_use, despues.skipped_allocations);
+        errores++;
+    }
+    if (memory_pool_free_bulk(pool, bloques, HUECOS + 4, CLIENTE) != HUECOS + 4) {
+        printf("✗ free_bulk no liberó bloques muestreados y normales\n");
+        errores++;
+    }
+
+    memory_guard_stop();
+    memory_guard_get_stats(&antes);
+    void* normal = memory_pool_alloc(pool, 64, CLIENTE);
+    memory_guard_get_stats(&despues);
+    if (memory_guard_is_active() || despues.sampled_allocations != antes.sampled_allocations ||
+        despues.slots_in_use != 0) {
+        printf("✗ El muestreo siguió activo tras memory_guard_stop\n");
+        errores++;
+    }
+    memory_pool_free(pool, normal, CLIENTE);
+
+    pool_metrics_t metricas;
+    memory_pool_get_metrics(pool, &metricas);
+    if (metricas.used_blocks != 0) {
+        printf("✗ Quedaron %d bloques en uso en el pool\n", metricas.used_blocks);
+        errores++;
+    }
+
+    memory_pool_destroy(pool);
+
+    printf("=== Test %s ===\n", errores ? "FALLIDO" : "completado");
+    return errores ? 1 : 0;
+}
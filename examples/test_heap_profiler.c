@@ -0,0 +1,119 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/memory_pool.h"
+#include "../include/memory_client.h"
+#include "../include/memory_profiler.h"
+
+#define NUM_BLOCKS 4000
+#define SAMPLE_INTERVAL 4096
+
+static void* slots[NUM_BLOCKS];
+
+// Dos sitios de asignación distintos para que aparezcan en el perfil
+static __attribute__((noinline)) void asignar_pequenos(memory_client_t* client, int from, int to) {
+    for (int i = from; i < to; i++) slots[i] = memory_client_alloc(client, 64);
+}
+
+static __attribute__((noinline)) void asignar_grandes(memory_client_t* client, int from, int to) {
+    for (int i = from; i < to; i++) slots[i] = memory_client_alloc(client, 1024);
+}
+
+int main() {
+    printf("=== TEST PERFILADOR DE HEAP POR MUESTREO ===\n");
+
+    memory_pool_t* pool = memory_pool_create(8 * 1024 * 1024, ALLOC_FIRST_FIT);
+    memory_client_t* client = memory_client_create(7, pool);
+    if (!pool || !client) {
+        printf("Error creando pool/cliente\n");
+        return 1;
+    }
+
+    int errores = 0;
+    if (memory_profiler_start(SAMPLE_INTERVAL) != MEMORY_SUCCESS || !memory_profiler_is_active()) {
+        printf("✗ No se pudo iniciar el perfilador\n");
+        return 1;
+    }
+
+    asignar_pequenos(client, 0, NUM_BLOCKS / 2);
+    asignar_grandes(client, NUM_BLOCKS / 2, NUM_BLOCKS);
+
+    size_t real = (NUM_BLOCKS / 2) * (size_t)(64 + 1024);
+    memory_profiler_stats_t stats;
+    memory_profiler_get_stats(&stats);
+    printf("Muestras: %zu vivas / %zu totales\n", stats.live_samples, stats.total_samples);
+    printf("Bytes vivos: estimados %zu, reales %zu\n", stats.live_bytes_estimate, real);
+
+    if (stats.live_samples == 0 ||
+        stats.live_bytes_estimate < real / 2 || stats.live_bytes_estimate > real * 2) {
+        printf("✗ Estimación fuera de rango\n");
+        errores++;
+    }
+
+    FILE* out = tmpfile();
+    memory_profiler_dump(out, MEMORY_PROFILE_COLLAPSED);
+    rewind(out);
+    char line[4096];
+    // Además del cliente 7 puede aparecer la tabla interna del cliente (-2)
+    int lineas = 0, con_cliente = 0, mal_formadas = 0;
+    while (fgets(line, sizeof(line), out)) {
+        lineas++;
+        if (strncmp(line, "client_7;", 9) == 0) con_cliente++;
+        else if (strncmp(line, "client_", 7) != 0) mal_formadas++;
+    }
+    fclose(out);
+    printf("Perfil colapsado: %d líneas\n", lineas);
+    if (con_cliente == 0 || mal_formadas) {
+        printf("✗ Formato colapsado incorrecto\n");
+        errores++;
+    }
+
+    out = tmpfile();
+    memory_profiler_dump(out, MEMORY_PROFILE_PPROF);
+    rewind(out);
+    if (!fgets(line, sizeof(line), out) || !strstr(line, "heap_v2/4096")) {
+        printf("✗ Cabecera pprof incorrecta\n");
+        errores++;
+    }
+    fclose(out);
+
+    // Al liberar, todas las muestras deben desaparecer
+    for (int i = 0; i < NUM_BLOCKS; i++) memory_client_free(client, slots[i]);
+    memory_client_free_all(client);
+    memory_profiler_get_stats(&stats);
+    if (stats.live_samples != 0 || stats.live_bytes_estimate != 0) {
+        printf("✗ Quedaron %zu muestras vivas tras liberar\n", stats.live_samples);
+        errores++;
+    }
+
+    // Muestreando cada byte se agota la reserva fija: las muestras de más se
+    // descartan y, al liberar, los huecos vuelven a la reserva
+    enum { MUCHOS = 20000 };
+    static void* muchos[MUCHOS];
+    memory_profiler_start(1);
+    for (int i = 0; i < MUCHOS; i++) muchos[i] = memory_pool_alloc(pool, 16, 7);
+    memory_profiler_get_stats(&stats);
+    printf("Reserva agotada: %zu vivas, %zu descartadas\n", stats.live_samples, stats.dropped_samples);
+    if (stats.dropped_samples == 0 || stats.live_samples + stats.dropped_samples != MUCHOS) {
+        printf("✗ Descarte de muestras incorrecto\n");
+        errores++;
+    }
+    for (int i = 0; i < MUCHOS; i++) memory_pool_free(pool, muchos[i], 7);
+    void* otra = memory_pool_alloc(pool, 16, 7);
+    memory_profiler_get_stats(&stats);
+    if (stats.live_samples != 1) {
+        printf("✗ La reserva no recuperó los huecos liberados\n");
+        errores++;
+    }
+    memory_pool_free(pool, otra, 7);
+
+    memory_profiler_stop();
+    if (memory_profiler_is_active()) errores++;
+
+    memory_client_destroy(client);
+    memory_pool_destroy(pool);
+
+    printf("=== Test %s ===\n", errores ? "FALLIDO" : "completado");
+    return errores ? 1 : 0;
+}
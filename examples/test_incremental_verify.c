@@ -0,0 +1,168 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include "../include/memory_pool.h"
+#include "../include/memory_pool_group.h"
+#include "../include/memory_verify.h"
+
+// Verificador incremental: tramos acotados, cursor estable frente a las
+// fusiones entre tramos, detección de headers corruptos e hilo de fondo.
+
+#define BLOQUES 4000
+#define TRAMO 100
+
+static size_t reportados = 0;
+
+static void al_error(void* pool, const void* block, const char* reason, void* user_data) {
+    (void)pool;
+    (void)block;
+    (void)reason;
+    (*(size_t*)user_data)++;
+}
+
+// Libera y reasigna una parte aleatoria de los bloques
+static void agitar(memory_pool_t* pool, void** bloques, unsigned* semilla, int cambios) {
+    for (int i = 0; i < cambios; i++) {
+        int j = rand_r(semilla) % BLOQUES;
+        if (bloques[j]) {
+            memory_pool_free(pool, bloques[j], 1);
+            bloques[j] = NULL;
+        } else {
+            bloques[j] = memory_pool_alloc(pool, 16 + rand_r(semilla) % 512, 1);
+        }
+    }
+}
+
+int main(void) {
+    printf("=== TEST VERIFICADOR INCREMENTAL ===\n");
+
+    memory_pool_t* pool = memory_pool_create(8 * 1024 * 1024, ALLOC_FIRST_FIT);
+    if (!pool) {
+        printf("Error creando pool\n");
+        return 1;
+    }
+    int errores = 0;
+    unsigned semilla = 42;
+
+    // El cursor queda en b; b se libera y luego a, que lo absorbe: el
+    // recorrido debe seguir por a en vez de por el header desaparecido
+    void* a = memory_pool_alloc(pool, 100, 1);
+    void* b = memory_pool_alloc(pool, 100, 1);
+    void* c = memory_pool_alloc(pool, 100, 1);
+    memory_pool_verify_step(pool, 1, NULL);
+    memory_pool_free(pool, b, 1);
+    memory_pool_free(pool, a, 1);
+    if (memory_pool_verify_step(pool, 10, NULL) != 0) {
+        printf("✗ El cursor no siguió la fusión del bloque que iba a revisar\n");
+        errores++;
+    }
+    memory_pool_free(pool, c, 1);
+
+    void* bloques[BLOQUES] = {0};
+    for (int i = 0; i < BLOQUES; i++) bloques[i] = memory_pool_alloc(pool, 16 + rand_r(&semilla) % 512, 1);
+    for (int i = 0; i < BLOQUES; i += 3) {
+        memory_pool_free(pool, bloques[i], 1);
+        bloques[i] = NULL;
+    }
+
+    // Cada tramo revisa como mucho TRAMO bloques; con el heap agitado entre
+    // tramos (fusiones alrededor del cursor) no debe haber falsos positivos
+    memory_verify_progress_t progreso;
+    memory_pool_verify_get_progress(pool, &progreso);
+    size_t tramos = 0;
+    do {
+        size_t antes = progreso.blocks_checked;
+        if (memory_pool_verify_step(pool, TRAMO, &progreso) != 0) errores++;
+        if (progreso.passes_completed == 0 && progreso.blocks_checked - antes > TRAMO) {
+            printf("✗ Un tramo revisó más de %d bloques\n", TRAMO);
+            errores++;
+        }
+        agitar(pool, bloques, &semilla, 50);
+        tramos++;
+    } while (progreso.passes_completed < 3 && tramos < 100000);
+
+    if (progreso.passes_completed < 3 || progreso.errors != 0) {
+        printf("✗ %zu recorridos en %zu tramos, %zu errores\n", progreso.passes_completed, tramos,
+               progreso.errors);
+        errores++;
+    }
+    printf("%zu recorridos completos en %zu tramos de %d bloques\n", progreso.passes_completed, tramos, TRAMO);
+
+    // Header corrupto: se reporta al manejador y el recorrido se reinicia
+    memory_pool_verify_set_handler(pool, al_error, &reportados);
+    char* victima = NULL;
+    for (int i = BLOQUES / 2; i < BLOQUES && !victima; i++) victima = bloques[i];
+    unsigned char copia[16];
+    memcpy(copia, victima - sizeof(copia), sizeof(copia));
+    memset(victima - sizeof(copia), 0x5A, sizeof(copia));
+
+    size_t recorridos = progreso.passes_completed;
+    while (reportados == 0 && tramos++ < 100000) {
+        memory_pool_verify_step(pool, TRAMO, &progreso);
+        if (progreso.passes_completed > recorridos + 1) break;
+    }
+    if (reportados == 0 || progreso.errors == 0) {
+        printf("✗ Header corrupto no detectado\n");
+        errores++;
+    }
+
+    memcpy(victima - sizeof(copia), copia, sizeof(copia));
+    memory_pool_verify_set_handler(pool, NULL, NULL);
+    size_t errores_previos = progreso.errors;
+    recorridos = progreso.passes_completed;
+    while (progreso.passes_completed == recorridos) memory_pool_verify_step(pool, TRAMO, &progreso);
+    while (progreso.passes_completed == recorridos + 1) memory_pool_verify_step(pool, TRAMO, &progreso);
+    if (progreso.errors != errores_previos) {
+        printf("✗ Errores tras restaurar el header: %zu\n", progreso.errors - errores_previos);
+        errores++;
+    }
+
+    // Hilo de fondo mientras este hilo sigue asignando y liberando
+    if (memory_pool_verify_start(pool, TRAMO, 1) != MEMORY_SUCCESS ||
+        memory_pool_verify_start(pool, TRAMO, 1) == MEMORY_SUCCESS) {
+        printf("✗ Arranque del hilo de fondo incorrecto\n");
+        errores++;
+    }
+    recorridos = progreso.passes_completed;
+    for (int ronda = 0; ronda < 2000; ronda++) {
+        agitar(pool, bloques, &semilla, 20);
+        memory_pool_verify_get_progress(pool, &progreso);
+        if (progreso.passes_completed >= recorridos + 2) break;
+        usleep(500);
+    }
+    memory_pool_verify_stop(pool);
+    if (progreso.passes_completed < recorridos + 2 || progreso.errors != errores_previos) {
+        printf("✗ Hilo de fondo: %zu recorridos, %zu errores nuevos\n",
+               progreso.passes_completed - recorridos, progreso.errors - errores_previos);
+        errores++;
+    }
+
+    for (int i = 0; i < BLOQUES; i++) {
+        if (bloques[i]) memory_pool_free(pool, bloques[i], 1);
+    }
+    memory_pool_destroy(pool);
+
+    // En un grupo avanza cada pool miembro; destruirlo detiene el hilo
+    memory_pool_group_class_t clases[] = {
+        {128, 1024 * 1024, ALLOC_BEST_FIT, 0},
+        {SIZE_MAX, 4 * 1024 * 1024, ALLOC_FIRST_FIT, 0},
+    };
+    memory_pool_group_t* grupo = memory_pool_group_create(clases, 2);
+    memory_pool_t* vista = memory_pool_group_as_pool(grupo);
+    for (int i = 0; i < 100; i++) memory_pool_alloc(vista, i % 2 ? 64 : 4096, 1);
+    memory_pool_verify_step(vista, 1000, &progreso);
+    if (progreso.passes_completed != 2 || progreso.errors != 0 || progreso.total_bytes != 5 * 1024 * 1024) {
+        printf("✗ Verificación del grupo: %zu recorridos, %zu errores\n", progreso.passes_completed,
+               progreso.errors);
+        errores++;
+    }
+    memory_pool_verify_start(vista, 10, 1);
+    usleep(2000);
+    memory_pool_group_destroy(grupo);
+
+    printf("=== Test %s ===\n", errores ? "FALLIDO" : "completado");
+    return errores ? 1 : 0;
+}
@@ -0,0 +1,90 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "../include/memory_pool.h"
+#include "../include/memory_metrics.h"
+
+#define LAZY_POOL_SIZE ((size_t)16 * 1024 * 1024 * 1024)
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+// Memoria residente del proceso en KiB
+static long rss_kb(void) {
+    long pages = 0, resident = 0;
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (!statm) return -1;
+    if (fscanf(statm, "%ld %ld", &pages, &resident) != 2) resident = -1;
+    fclose(statm);
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+static int es_cero(const unsigned char* p, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        if (p[i]) return 0;
+    }
+    return 1;
+}
+
+int main() {
+    printf("=== TEST POOL PEREZOSO (MAP_NORESERVE) ===\n");
+
+    long rss_inicial = rss_kb();
+    double inicio = now_ms();
+    memory_pool_t* pool = memory_pool_create_ex(LAZY_POOL_SIZE, ALLOC_FIRST_FIT, MEMORY_POOL_FLAG_LAZY);
+    double creacion = now_ms() - inicio;
+    if (!pool) {
+        // Sin espacio de direcciones suficiente (p. ej. ulimit -v) no hay nada que probar
+        printf("Reserva de %zu bytes no disponible, test omitido\n", LAZY_POOL_SIZE);
+        return 0;
+    }
+    printf("Creación de pool de 16 GiB: %.3f ms\n", creacion);
+
+    int errores = 0;
+    if (creacion > 50.0) {
+        printf("✗ La creación no fue inmediata\n");
+        errores++;
+    }
+
+    // Asignaciones dispersas: solo se comprometen las páginas tocadas
+    void* bloques[64];
+    for (int i = 0; i < 64; i++) {
+        bloques[i] = memory_pool_alloc(pool, 64 * 1024, 1);
+        if (!bloques[i] || !es_cero(bloques[i], 64 * 1024)) errores++;
+        memset(bloques[i], 0xCD, 64 * 1024);
+    }
+
+    long rss_usado = rss_kb() - rss_inicial;
+    printf("RSS tras 4 MiB asignados: +%ld KiB\n", rss_usado);
+    if (rss_usado > 64 * 1024) {
+        printf("✗ Se comprometió más memoria de la usada\n");
+        errores++;
+    }
+
+    // Los bloques reutilizados por debajo de la frontera se limpian
+    for (int i = 0; i < 64; i += 2) memory_pool_free(pool, bloques[i], 1);
+    for (int i = 0; i < 64; i += 2) {
+        bloques[i] = memory_pool_alloc(pool, 1000, 1);
+        if (!bloques[i] || !es_cero(bloques[i], 1000)) {
+            printf("✗ Bloque reutilizado no llegó a cero\n");
+            errores++;
+            break;
+        }
+    }
+
+    // Y un bloque grande que cruza la frontera también sale a cero
+    void* grande = memory_pool_alloc(pool, 8 * 1024 * 1024, 1);
+    if (!grande || !es_cero(grande, 8 * 1024 * 1024)) errores++;
+
+    if (!memory_pool_verify_metrics(pool)) errores++;
+    memory_pool_destroy(pool);
+
+    printf("=== Test %s ===\n", errores ? "FALLIDO" : "completado");
+    return errores ? 1 : 0;
+}
@@ -0,0 +1,127 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "../include/memory_pool.h"
+#include "../include/memory_kernels.h"
+
+// Núcleos de limpieza y copia: cada variante que admite la CPU, con y sin
+// stores no temporales, en todos los desalineamientos y con colas de todos
+// los tamaños; y el pool sigue entregando memoria limpia con ellos.
+
+#define MARGEN 64
+
+static int probar_variante(memory_kernel_isa_t isa, unsigned char* destino, unsigned char* origen) {
+    int errores = 0;
+    const size_t tamanos[] = {0, 1, 63, 255, 256, 257, 1000, 4096, 4099, 65536 + 37, 300000};
+
+    for (int stream = 0; stream < 2; stream++) {
+        memory_kernels_set_streaming_threshold(stream ? 0 : SIZE_MAX);
+
+        for (size_t t = 0; t < sizeof(tamanos) / sizeof(tamanos[0]); t++) {
+            for (size_t desfase = 0; desfase < 64; desfase += 7) {
+                size_t n = tamanos[t];
+                unsigned char* d = destino + MARGEN + desfase;
+                const unsigned char* s = origen + 3 + desfase / 2;
+
+                memset(destino, 0xEE, n + 2 * MARGEN + 64);
+                memory_copy(d, s, n);
+                if (memcmp(d, s, n) != 0 || d[-1] != 0xEE || d[n] != 0xEE) {
+                    printf("✗ %s copia de %zu bytes (desfase %zu, stream %d)\n",
+                           memory_kernels_isa_name(isa), n, desfase, stream);
+                    errores++;
+                }
+
+                memory_zero(d, n);
+                for (size_t i = 0; i < n; i++) {
+                    if (d[i]) {
+                        printf("✗ %s limpieza de %zu bytes (desfase %zu, stream %d) en %zu\n",
+                               memory_kernels_isa_name(isa), n, desfase, stream, i);
+                        errores++;
+                        break;
+                    }
+                }
+                if (d[-1] != 0xEE || d[n] != 0xEE) {
+                    printf("✗ %s limpieza de %zu bytes se salió del rango\n", memory_kernels_isa_name(isa), n);
+                    errores++;
+                }
+            }
+        }
+    }
+    return errores;
+}
+
+int main(void) {
+    printf("=== TEST NÚCLEOS DE MEMORIA ===\n");
+
+    memory_kernel_isa_t elegida = memory_kernels_get_isa();
+    size_t umbral = memory_kernels_get_streaming_threshold();
+    printf("Variante elegida: %s, umbral de streaming: %zu bytes\n", memory_kernels_isa_name(elegida), umbral);
+
+    int errores = 0;
+    if (!memory_kernels_isa_supported(elegida)) {
+        printf("✗ Se eligió una variante que la CPU no admite\n");
+        errores++;
+    }
+
+    size_t capacidad = 300000 + 2 * MARGEN + 128;
+    unsigned char* destino = malloc(capacidad);
+    unsigned char* origen = malloc(capacidad);
+    if (!destino || !origen) return 1;
+    for (size_t i = 0; i < capacidad; i++) origen[i] = (unsigned char)(i * 131 + 7);
+
+    for (int isa = 0; isa < MEMORY_KERNEL_ISA_COUNT; isa++) {
+        if (!memory_kernels_isa_supported((memory_kernel_isa_t)isa)) {
+            printf("  %s: no disponible\n", memory_kernels_isa_name((memory_kernel_isa_t)isa));
+            if (memory_kernels_set_isa((memory_kernel_isa_t)isa) != MEMORY_ERROR_INVALID_PARAM) errores++;
+            continue;
+        }
+        memory_kernels_set_isa((memory_kernel_isa_t)isa);
+        int fallos = probar_variante((memory_kernel_isa_t)isa, destino, origen);
+        printf("  %s: %s\n", memory_kernels_isa_name((memory_kernel_isa_t)isa), fallos ? "errores" : "correcta");
+        errores += fallos;
+    }
+
+    memory_kernels_set_isa(elegida);
+    memory_kernels_set_streaming_threshold(umbral);
+
+    // Un bloque grande ensuciado, liberado y reasignado vuelve limpio y
+    // realloc conserva el contenido al moverlo
+    memory_pool_t* pool = memory_pool_create(8 * 1024 * 1024, ALLOC_FIRST_FIT);
+    if (!pool) return 1;
+    size_t grande = 2 * 1024 * 1024 + 123;
+    unsigned char* bloque = memory_pool_alloc(pool, grande, 1);
+    void* tapon = memory_pool_alloc(pool, 64, 1);
+    memset(bloque, 0x5A, grande);
+    memory_pool_free(pool, bloque, 1);
+    bloque = memory_pool_alloc(pool, grande, 1);
+    for (size_t i = 0; bloque && i < grande; i++) {
+        if (bloque[i]) {
+            printf("✗ Bloque reasignado sin limpiar en %zu\n", i);
+            errores++;
+            break;
+        }
+    }
+    for (size_t i = 0; bloque && i < grande; i++) bloque[i] = (unsigned char)(i * 7);
+    unsigned char* movido = memory_pool_realloc(pool, bloque, grande + 4096, 1);
+    for (size_t i = 0; movido && i < grande; i++) {
+        if (movido[i] != (unsigned char)(i * 7)) {
+            printf("✗ realloc perdió el contenido en %zu\n", i);
+            errores++;
+            break;
+        }
+    }
+    memory_pool_free(pool, movido, 1);
+    memory_pool_free(pool, tapon, 1);
+    memory_pool_destroy(pool);
+
+    free(destino);
+    free(origen);
+
+    if (errores) {
+        printf("✗ %d errores\n", errores);
+        return 1;
+    }
+    printf("✓ Núcleos de memoria correctos\n");
+    return 0;
+}
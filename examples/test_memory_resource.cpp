@@ -0,0 +1,116 @@
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "../include/memory_resource.hpp"
+#include "../include/memory_metrics.h"
+
+// Adaptadores C++ del pool: recurso pmr, allocator con estado, alineación y
+// contabilidad por cliente.
+
+struct alignas(64) linea_cache {
+    char datos[64];
+};
+
+static bool alineado(const void* ptr, std::size_t alignment) {
+    return (reinterpret_cast<std::uintptr_t>(ptr) & (alignment - 1)) == 0;
+}
+
+int main() {
+    std::printf("=== TEST ADAPTADORES C++ (std::pmr / Allocator) ===\n");
+
+    memory_pool_t* pool = memory_pool_create(8 * 1024 * 1024, ALLOC_BEST_FIT);
+    memory_client_t* client = memory_client_create(1, pool);
+    if (!pool || !client) {
+        std::printf("Error creando pool/cliente\n");
+        return 1;
+    }
+    int errores = 0;
+
+    // Recurso pmr: cada nodo del contenedor queda registrado en el cliente
+    memory::client_resource resource(client);
+    {
+        std::pmr::map<int, std::pmr::string> tabla(&resource);
+        for (int i = 0; i < 100; i++) {
+            tabla.emplace(i, std::pmr::string(64, 'x', &resource));
+        }
+        if (memory_client_get_allocated_count(client) < 200) {
+            std::printf("✗ El cliente registra %zu bloques\n", memory_client_get_allocated_count(client));
+            errores++;
+        }
+    }
+    if (memory_client_get_allocated_count(client) != 0) {
+        std::printf("✗ Quedaron %zu bloques tras destruir el contenedor\n",
+                    memory_client_get_allocated_count(client));
+        errores++;
+    }
+
+    // Alineación pedida explícitamente y por el tipo
+    void* grande = resource.allocate(1000, 256);
+    if (!alineado(grande, 256)) {
+        std::printf("✗ allocate no respetó la alineación de 256\n");
+        errores++;
+    }
+    resource.deallocate(grande, 1000, 256);
+
+    memory::allocator<linea_cache> lineas(client);
+    std::vector<linea_cache, memory::allocator<linea_cache>> vector_lineas(lineas);
+    vector_lineas.resize(33);
+    if (!alineado(vector_lineas.data(), alignof(linea_cache))) {
+        std::printf("✗ El allocator no respetó alignof(T)\n");
+        errores++;
+    }
+
+    // Copias y conversiones comparten origen; orígenes distintos no son iguales
+    memory::allocator<int> enteros(lineas);
+    memory::allocator<int> directo(pool, 7);
+    if (enteros != lineas || enteros == directo) {
+        std::printf("✗ Igualdad de allocators incorrecta\n");
+        errores++;
+    }
+    memory::pool_resource recurso_pool(pool, 7);
+    memory::pool_resource otro_pool(pool, 8);
+    if (!recurso_pool.is_equal(memory::pool_resource(pool, 7)) || recurso_pool.is_equal(otro_pool) ||
+        recurso_pool.is_equal(resource)) {
+        std::printf("✗ is_equal de los recursos incorrecto\n");
+        errores++;
+    }
+
+    std::vector<int, memory::allocator<int>> numeros(directo);
+    for (int i = 0; i < 10000; i++) numeros.push_back(i);
+    pool_metrics_t metricas;
+    memory_pool_get_metrics(pool, &metricas);
+    if (metricas.used_blocks < 2) errores++;
+
+    // Sin memoria: std::bad_alloc, como exige memory_resource
+    bool lanzado = false;
+    try {
+        void* imposible = recurso_pool.allocate(64 * 1024 * 1024);
+        recurso_pool.deallocate(imposible, 64 * 1024 * 1024);
+    } catch (const std::bad_alloc&) {
+        lanzado = true;
+    }
+    if (!lanzado) {
+        std::printf("✗ No se lanzó std::bad_alloc\n");
+        errores++;
+    }
+
+    numeros = std::vector<int, memory::allocator<int>>(directo);
+    vector_lineas.clear();
+    vector_lineas.shrink_to_fit();
+
+    if (memory_client_get_allocated_count(client) != 0) {
+        std::printf("✗ Fugas en el cliente: %zu bloques\n", memory_client_get_allocated_count(client));
+        errores++;
+    }
+
+    memory_client_destroy(client);
+    memory_pool_destroy(pool);
+
+    std::printf("=== Test %s ===\n", errores ? "FALLIDO" : "completado");
+    return errores ? 1 : 0;
+}
@@ -0,0 +1,99 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "../include/memory_pool.h"
+#include "../include/memory_client.h"
+#include "../include/memory_metrics.h"
+
+#define NUM_OPERATIONS 20000
+#define NUM_SLOTS 512
+
+static volatile int lector_activo = 1;
+
+// Lector que consulta métricas continuamente sin bloquear a los asignadores
+static void* lector_metricas(void* arg) {
+    memory_pool_t* pool = (memory_pool_t*)arg;
+    size_t lecturas = 0;
+    int inconsistentes = 0;
+
+    while (lector_activo) {
+        pool_metrics_t metrics;
+        memory_pool_get_metrics(pool, &metrics);
+        if (metrics.used_memory + metrics.free_memory != metrics.total_memory) {
+            inconsistentes++;
+        }
+        lecturas++;
+    }
+
+    printf("  Lector: %zu lecturas, %d instantáneas inconsistentes\n", lecturas, inconsistentes);
+    return (void*)(intptr_t)inconsistentes;
+}
+
+static int probar_estrategia(alloc_strategy_t strategy, const char* name) {
+    printf("Estrategia %s\n", name);
+
+    memory_pool_t* pool = memory_pool_create(2 * 1024 * 1024, strategy);
+    memory_client_t* client = memory_client_create(1, pool);
+    if (!pool || !client) {
+        printf("  Error creando pool/cliente\n");
+        return 0;
+    }
+
+    pthread_t lector;
+    lector_activo = 1;
+    pthread_create(&lector, NULL, lector_metricas, pool);
+
+    void* slots[NUM_SLOTS] = {0};
+    unsigned int seed = 12345;
+    int errores = 0;
+
+    for (int i = 0; i < NUM_OPERATIONS; i++) {
+        int slot = rand_r(&seed) % NUM_SLOTS;
+        if (slots[slot]) {
+            memory_client_free(client, slots[slot]);
+            slots[slot] = NULL;
+        } else {
+            slots[slot] = memory_client_alloc(client, 16 + rand_r(&seed) % 4096);
+        }
+
+        if (i % 1000 == 0 && !memory_pool_verify_metrics(pool)) {
+            printf("  ✗ Métricas inconsistentes en operación %d\n", i);
+            errores++;
+        }
+    }
+
+    memory_client_free_all(client);
+
+    lector_activo = 0;
+    void* inconsistentes = NULL;
+    pthread_join(lector, &inconsistentes);
+    if (inconsistentes) errores++;
+
+    pool_metrics_t metrics;
+    memory_pool_get_metrics(pool, &metrics);
+    if (!memory_pool_verify_metrics(pool) || metrics.used_blocks != 0 || metrics.free_blocks != 1) {
+        printf("  ✗ El pool no volvió a un único bloque libre (%d libres, %d usados)\n",
+               metrics.free_blocks, metrics.used_blocks);
+        errores++;
+    }
+
+    memory_client_destroy(client);
+    memory_pool_destroy(pool);
+
+    printf("  %s\n", errores ? "✗ FALLIDO" : "✓ Métricas consistentes");
+    return errores == 0;
+}
+
+int main() {
+    printf("=== TEST CONSISTENCIA DE MÉTRICAS INCREMENTALES ===\n");
+
+    int ok = probar_estrategia(ALLOC_FIRST_FIT, "FIRST_FIT");
+    ok = probar_estrategia(ALLOC_BEST_FIT, "BEST_FIT") && ok;
+    ok = probar_estrategia(ALLOC_WORST_FIT, "WORST_FIT") && ok;
+    ok = probar_estrategia(ALLOC_NEXT_FIT, "NEXT_FIT") && ok;
+
+    printf("=== Test %s ===\n", ok ? "completado" : "FALLIDO");
+    return ok ? 0 : 1;
+}
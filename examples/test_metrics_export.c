@@ -0,0 +1,132 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "../include/memory_pool.h"
+#include "../include/memory_client.h"
+#include "../include/memory_metrics.h"
+#include "../include/memory_export.h"
+
+// Exportador de métricas: texto de Prometheus, JSON, truncado con la
+// semántica de snprintf y servidor por socket Unix.
+
+static char salida[64 * 1024];
+
+// Conecta, envía la petición (puede ser vacía) y lee la respuesta completa
+static size_t consultar(const char* path, const char* peticion, char* respuesta, size_t capacidad) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path);
+    if (connect(fd, (struct sockaddr*)&address, sizeof(address)) != 0) {
+        close(fd);
+        return 0;
+    }
+    if (peticion) {
+        ssize_t enviado = write(fd, peticion, strlen(peticion));
+        (void)enviado;
+    }
+
+    size_t leido = 0;
+    ssize_t n;
+    while (leido + 1 < capacidad && (n = read(fd, respuesta + leido, capacidad - 1 - leido)) > 0) {
+        leido += (size_t)n;
+    }
+    respuesta[leido] = '\0';
+    close(fd);
+    return leido;
+}
+
+int main(void) {
+    printf("=== TEST EXPORTACIÓN DE MÉTRICAS ===\n");
+
+    memory_pool_t* pool = memory_pool_create(1024 * 1024, ALLOC_BEST_FIT);
+    memory_client_t* client = memory_client_create(3, pool);
+    if (!pool || !client) return 1;
+    int errores = 0;
+
+    if (memory_export_register_pool("cache", pool) != MEMORY_SUCCESS ||
+        memory_export_register_client("sesiones", client) != MEMORY_SUCCESS ||
+        memory_export_register_pool("nombre con espacios", pool) == MEMORY_SUCCESS) {
+        printf("✗ Registro incorrecto\n");
+        errores++;
+    }
+
+    void* bloques[10];
+    for (int i = 0; i < 10; i++) bloques[i] = memory_client_alloc(client, 100);
+    for (int i = 0; i < 10; i += 2) memory_client_free(client, bloques[i]);
+
+    // La tabla del cliente también es una asignación del pool
+    pool_metrics_t metricas;
+    memory_pool_get_metrics(pool, &metricas);
+    char asignaciones[96], en_json[64];
+    snprintf(asignaciones, sizeof(asignaciones), "memory_pool_allocations_total{pool=\"cache\"} %zu\n",
+             metricas.allocation_count);
+    snprintf(en_json, sizeof(en_json), "\"allocations_total\":%zu,", metricas.allocation_count);
+
+    size_t longitud = memory_export_render(MEMORY_EXPORT_PROMETHEUS, salida, sizeof(salida));
+    if (longitud >= sizeof(salida) || !strstr(salida, "# TYPE memory_pool_allocations_total counter\n") ||
+        !strstr(salida, asignaciones) ||
+        !strstr(salida, "memory_pool_frees_total{pool=\"cache\"} 5\n") ||
+        !strstr(salida, "memory_pool_total_bytes{pool=\"cache\"} 1048576\n") ||
+        !strstr(salida, "memory_client_allocated_blocks{client=\"sesiones\",id=\"3\",pool=\"cache\"} 5\n")) {
+        printf("✗ Exposición de Prometheus incompleta:\n%s\n", salida);
+        errores++;
+    }
+
+    // Truncado: devuelve la longitud completa y deja el buffer terminado
+    char corto[32];
+    if (memory_export_render(MEMORY_EXPORT_PROMETHEUS, corto, sizeof(corto)) != longitud ||
+        strlen(corto) != sizeof(corto) - 1 || memory_export_render(MEMORY_EXPORT_PROMETHEUS, NULL, 0) != longitud) {
+        printf("✗ Truncado incorrecto\n");
+        errores++;
+    }
+
+    memory_export_render(MEMORY_EXPORT_JSON, salida, sizeof(salida));
+    if (strncmp(salida, "{\"pools\":[{\"name\":\"cache\"", 25) != 0 || !strstr(salida, en_json) ||
+        !strstr(salida, "\"free_classes\":[") ||
+        !strstr(salida, "\"clients\":[{\"name\":\"sesiones\",\"id\":3,\"pool\":\"cache\",\"allocated_blocks\":5}]")) {
+        printf("✗ JSON incompleto:\n%s\n", salida);
+        errores++;
+    }
+
+    // Servidor: Prometheus por defecto, JSON si se pide
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/memory_export_%d.sock", (int)getpid());
+    if (memory_export_serve(path) != MEMORY_SUCCESS || memory_export_serve(path) == MEMORY_SUCCESS) {
+        printf("✗ Arranque del servidor incorrecto\n");
+        errores++;
+    }
+    char respuesta[64 * 1024];
+    memory_export_render(MEMORY_EXPORT_PROMETHEUS, salida, sizeof(salida));
+    if (consultar(path, NULL, respuesta, sizeof(respuesta)) == 0 || strcmp(respuesta, salida) != 0) {
+        printf("✗ El socket no sirvió la exposición de Prometheus\n");
+        errores++;
+    }
+    memory_export_render(MEMORY_EXPORT_JSON, salida, sizeof(salida));
+    if (consultar(path, "json\n", respuesta, sizeof(respuesta)) == 0 || strcmp(respuesta, salida) != 0) {
+        printf("✗ El socket no sirvió JSON\n");
+        errores++;
+    }
+    memory_export_stop();
+    if (access(path, F_OK) == 0) {
+        printf("✗ El socket sigue existiendo tras parar\n");
+        errores++;
+    }
+
+    // Destruir quita los objetos del registro
+    memory_client_destroy(client);
+    memory_pool_destroy(pool);
+    memory_export_render(MEMORY_EXPORT_JSON, salida, sizeof(salida));
+    if (strcmp(salida, "{\"pools\":[],\"clients\":[]}\n") != 0) {
+        printf("✗ Quedaron objetos destruidos en el registro: %s\n", salida);
+        errores++;
+    }
+
+    printf("=== Test %s ===\n", errores ? "FALLIDO" : "completado");
+    return errores ? 1 : 0;
+}
@@ -0,0 +1,131 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "../include/memory_pool.h"
+#include "../include/memory_metrics.h"
+
+#define POOL_SIZE (4 * 1024 * 1024)
+#define NUM_NODES 1000
+
+typedef struct nodo {
+    int valor;
+    int generacion;
+} nodo_t;
+
+typedef struct {
+    size_t count;
+    nodo_t nodos[];
+} raiz_t;
+
+static int construir_estado(memory_pool_t* pool) {
+    // La raíz se asigna directamente en el pool: sobrevive al proceso
+    raiz_t* raiz = memory_pool_alloc(pool, sizeof(raiz_t) + NUM_NODES * sizeof(nodo_t), 1);
+    if (!raiz) return 0;
+
+    raiz->count = NUM_NODES;
+    for (int i = 0; i < NUM_NODES; i++) {
+        raiz->nodos[i].valor = i * 7;
+    }
+
+    // Bloques temporales que se liberan para dejar huecos en el heap
+    void* temporales[16];
+    for (int i = 0; i < 16; i++) temporales[i] = memory_pool_alloc(pool, 100 + i * 10, 2);
+    for (int i = 0; i < 16; i += 2) memory_pool_free(pool, temporales[i], 2);
+
+    memory_pool_set_root(pool, raiz);
+    return 1;
+}
+
+static int verificar_estado(memory_pool_t* pool) {
+    raiz_t* raiz = memory_pool_get_root(pool);
+    if (!raiz || raiz->count != NUM_NODES) return 0;
+
+    for (int i = 0; i < NUM_NODES; i++) {
+        if (raiz->nodos[i].valor != i * 7) return 0;
+    }
+    return memory_pool_check(pool);
+}
+
+static int test_cierre_limpio(const char* path) {
+    printf("--- Cierre limpio y reapertura ---\n");
+
+    memory_pool_t* pool = memory_pool_create_persistent(path, POOL_SIZE, ALLOC_BEST_FIT);
+    if (!pool || !construir_estado(pool)) {
+        printf("✗ No se pudo construir el estado inicial\n");
+        return 0;
+    }
+
+    size_t used_before = memory_pool_get_used_memory(pool);
+    memory_pool_destroy(pool);
+
+    pool = memory_pool_open(path);
+    if (!pool) {
+        printf("✗ No se pudo reabrir el pool\n");
+        return 0;
+    }
+
+    int ok = verificar_estado(pool) &&
+             memory_pool_get_strategy(pool) == ALLOC_BEST_FIT &&
+             memory_pool_get_used_memory(pool) == used_before;
+    printf("%s Estado restaurado tras cierre limpio\n", ok ? "✓" : "✗");
+
+    // El pool reabierto sigue siendo utilizable
+    void* extra = memory_pool_alloc(pool, 256, 3);
+    ok = ok && extra && memory_pool_free(pool, extra, 3) == MEMORY_SUCCESS;
+
+    memory_pool_destroy(pool);
+    return ok;
+}
+
+static int test_recuperacion(const char* path) {
+    printf("--- Recuperación tras terminación abrupta ---\n");
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        memory_pool_t* pool = memory_pool_create_persistent(path, POOL_SIZE, ALLOC_FIRST_FIT);
+        if (!pool || !construir_estado(pool)) _exit(1);
+        _exit(0); // sin memory_pool_destroy: no hay marcador de cierre limpio
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        printf("✗ El proceso hijo no pudo construir el estado\n");
+        return 0;
+    }
+
+    memory_pool_t* pool = memory_pool_open(path);
+    if (!pool) {
+        printf("✗ No se pudo recuperar el pool\n");
+        return 0;
+    }
+
+    int ok = verificar_estado(pool);
+    printf("%s Estado recuperado con escaneo de recuperación\n", ok ? "✓" : "✗");
+
+    memory_pool_destroy(pool);
+    return ok;
+}
+
+int main() {
+    printf("=== TEST POOL PERSISTENTE ===\n");
+
+    char path[] = "/tmp/memory_pool_testXXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        printf("Error al crear archivo temporal\n");
+        return 1;
+    }
+    close(fd);
+
+    int ok = test_cierre_limpio(path);
+    ok = test_recuperacion(path) && ok;
+
+    unlink(path);
+
+    printf("=== Test %s ===\n", ok ? "completado" : "FALLIDO");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,154 @@
+#include <stdio.h>
+#include <stdint.h>
+#include "../include/memory_pool.h"
+#include "../include/memory_pool_group.h"
+#include "../include/memory_client.h"
+#include "../include/memory_metrics.h"
+
+#define NUM_SMALL 2000
+#define NUM_LARGE 8
+
+static int usados(memory_pool_group_t* group, size_t index) {
+    pool_metrics_t metrics;
+    memory_pool_get_metrics(memory_pool_group_get_pool(group, index), &metrics);
+    return metrics.used_blocks;
+}
+
+int main() {
+    printf("=== TEST GRUPOS DE POOLS POR TAMAÑO ===\n");
+
+    memory_pool_group_class_t classes[] = {
+        {256, 1024 * 1024, ALLOC_BEST_FIT, 0},
+        {64 * 1024, 8 * 1024 * 1024, ALLOC_FIRST_FIT, 0},
+        {SIZE_MAX, 32 * 1024 * 1024, ALLOC_WORST_FIT, 0},
+    };
+    memory_pool_group_t* group = memory_pool_group_create(classes, 3);
+    if (!group) {
+        printf("Error creando grupo\n");
+        return 1;
+    }
+    memory_pool_t* pool = memory_pool_group_as_pool(group);
+    int errores = 0;
+
+    if (memory_pool_group_get_count(group) != 3 || !memory_pool_is_valid(pool) ||
+        memory_pool_get_total_size(pool) != (1 + 8 + 32) * 1024 * 1024) {
+        printf("✗ Vista del grupo inconsistente\n");
+        errores++;
+    }
+
+    // Clases desordenadas: se rechazan
+    memory_pool_group_class_t desordenadas[] = {
+        {4096, 1024 * 1024, ALLOC_FIRST_FIT, 0},
+        {64, 1024 * 1024, ALLOC_FIRST_FIT, 0},
+    };
+    if (memory_pool_group_create(desordenadas, 2)) {
+        printf("✗ Se aceptaron clases desordenadas\n");
+        errores++;
+    }
+
+    // Enrutado por tamaño: objetos pequeños y grandes intercalados
+    void* small[NUM_SMALL];
+    void* large[NUM_LARGE];
+    void* medium = memory_pool_alloc(pool, 4096, 1);
+    for (int i = 0; i < NUM_SMALL; i++) {
+        small[i] = memory_pool_alloc(pool, 16 + (i % 8) * 16, 1);
+        if (!small[i]) errores++;
+        if (i % (NUM_SMALL / NUM_LARGE) == 0) {
+            large[i / (NUM_SMALL / NUM_LARGE)] = memory_pool_alloc(pool, 1024 * 1024, 1);
+        }
+    }
+    printf("Bloques por clase: %d / %d / %d\n", usados(group, 0), usados(group, 1), usados(group, 2));
+    if (usados(group, 0) != NUM_SMALL || usados(group, 1) != 1 || usados(group, 2) != NUM_LARGE) {
+        printf("✗ Enrutado por tamaño incorrecto\n");
+        errores++;
+    }
+
+    // Liberar los grandes con los pequeños vivos: su pool vuelve a un solo bloque libre
+    for (int i = 0; i < NUM_LARGE; i++) {
+        if (memory_pool_free(pool, large[i], 1) != MEMORY_SUCCESS) errores++;
+    }
+    pool_metrics_t metrics;
+    memory_pool_get_metrics(memory_pool_group_get_pool(group, 2), &metrics);
+    if (metrics.used_blocks != 0 || metrics.free_blocks != 1) {
+        printf("✗ El pool de objetos grandes quedó fragmentado (%d bloques libres)\n", metrics.free_blocks);
+        errores++;
+    }
+
+    // Liberación por dirección, también en bloque
+    if (memory_pool_free(pool, medium, 1) != MEMORY_SUCCESS) errores++;
+    if (memory_pool_free_bulk(pool, small, NUM_SMALL, 1) != NUM_SMALL) {
+        printf("✗ free_bulk no liberó todos los bloques\n");
+        errores++;
+    }
+    int fuera = 0;
+    if (memory_pool_free(pool, &fuera, 1) == MEMORY_SUCCESS) {
+        printf("✗ Se aceptó un puntero ajeno al grupo\n");
+        errores++;
+    }
+
+    // Desbordamiento: con la clase pequeña llena se usa la siguiente
+    size_t llenado = 0;
+    void* relleno[8192];
+    while (llenado < 8192 && (relleno[llenado] = memory_pool_alloc(pool, 200, 2))) llenado++;
+    if (llenado != 8192 || usados(group, 1) == 0) {
+        printf("✗ Sin desbordamiento a la clase siguiente (%zu asignaciones)\n", llenado);
+        errores++;
+    }
+    memory_pool_free_bulk(pool, relleno, llenado, 2);
+
+    // Sustituto directo de un pool para los clientes
+    memory_client_t* client = memory_client_create(3, pool);
+    if (!client) {
+        printf("✗ No se pudo crear el cliente sobre el grupo\n");
+        return 1;
+    }
+    for (int i = 0; i < 500; i++) {
+        size_t size = (i % 3 == 0) ? 48 : (i % 3 == 1) ? 8192 : 256 * 1024;
+        void* ptr = memory_client_alloc(client, size);
+        if (!ptr) errores++;
+        else if (i % 2 == 0 && memory_client_free(client, ptr) != MEMORY_SUCCESS) errores++;
+    }
+    if (memory_client_get_allocated_count(client) != 250) {
+        printf("✗ El cliente registra %zu bloques\n", memory_client_get_allocated_count(client));
+        errores++;
+    }
+
+    // Distribución libre, latencias y comprobación de listas también agregan las clases
+    pool_free_distribution_t distribucion;
+    memory_histogram_t latencia;
+    memory_pool_get_free_distribution(pool, &distribucion);
+    memory_pool_get_metrics(pool, &metrics);
+    size_t libres = 0;
+    for (int cls = 0; cls < MEMORY_SIZE_CLASSES; cls++) libres += distribucion.free_blocks[cls];
+    int estado = memory_pool_get_latency(pool, MEMORY_LATENCY_ALLOC, -1, &latencia);
+    if (distribucion.highest_class < 0 || libres != (size_t)metrics.free_blocks ||
+        distribucion.largest_free_block != metrics.largest_free_block) {
+        printf("✗ Distribución libre del grupo incompleta (clase máxima %d)\n", distribucion.highest_class);
+        errores++;
+    }
+    if (MEMORY_LATENCY_HISTOGRAMS && (estado != MEMORY_SUCCESS || latencia.total_count == 0)) {
+        printf("✗ Latencias del grupo vacías\n");
+        errores++;
+    }
+    if (!memory_pool_check(pool)) {
+        printf("✗ Comprobación de listas del grupo fallida\n");
+        errores++;
+    }
+    memory_client_free_all(client);
+    memory_client_destroy(client);
+
+    memory_pool_get_metrics(pool, &metrics);
+    printf("Métricas agregadas: %zu bytes totales, %d bloques usados, %zu asignaciones\n",
+           metrics.total_memory, metrics.used_blocks, metrics.allocation_count);
+    if (metrics.used_blocks != 0 || metrics.total_memory != memory_pool_get_total_size(pool) ||
+        !memory_pool_verify_metrics(pool)) {
+        printf("✗ Métricas agregadas inconsistentes\n");
+        errores++;
+    }
+
+    // Destruir la vista destruye el grupo completo
+    memory_pool_destroy(pool);
+
+    printf("=== Test %s ===\n", errores ? "FALLIDO" : "completado");
+    return errores ? 1 : 0;
+}
@@ -0,0 +1,122 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "../include/memory_pool.h"
+#include "../include/memory_metrics.h"
+
+// Instantáneas copy-on-write: el archivo refleja el pool en el instante de
+// la llamada aunque se siga escribiendo durante la copia, y memory_pool_open
+// lo restaura con su raíz.
+
+#define BLOQUES 64
+#define TAMANO_BLOQUE 4096
+
+int main(void) {
+    printf("=== TEST INSTANTÁNEAS COW ===\n");
+
+    char ruta[] = "/tmp/memory_snapshot_XXXXXX";
+    int fd = mkstemp(ruta);
+    if (fd < 0) return 1;
+    close(fd);
+    unlink(ruta);
+
+    memory_pool_t* pool = memory_pool_create(4 * 1024 * 1024, ALLOC_FIRST_FIT);
+    if (!pool) return 1;
+    int errores = 0;
+
+    unsigned char* bloques[BLOQUES];
+    for (int i = 0; i < BLOQUES; i++) {
+        bloques[i] = memory_pool_alloc(pool, TAMANO_BLOQUE, 1);
+        if (!bloques[i]) return 1;
+        memset(bloques[i], i + 1, TAMANO_BLOQUE);
+    }
+    // La raíz apunta a una tabla con los desplazamientos de los bloques
+    size_t* tabla = memory_pool_alloc(pool, BLOQUES * sizeof(size_t), 1);
+    for (int i = 0; i < BLOQUES; i++) tabla[i] = (size_t)(bloques[i] - (unsigned char*)tabla);
+
+    // Rechazos: raíz fuera del pool, ruta nula y manejador nulo
+    int ajeno;
+    if (memory_pool_snapshot(pool, ruta, &ajeno) || memory_pool_snapshot(pool, NULL, NULL) ||
+        memory_snapshot_wait(NULL, NULL) != MEMORY_ERROR_INVALID_PARAM) {
+        printf("✗ Parámetros inválidos aceptados\n");
+        errores++;
+    }
+
+    memory_snapshot_t* instantanea = memory_pool_snapshot(pool, ruta, tabla);
+    if (!instantanea) {
+        printf("✗ No se pudo iniciar la instantánea\n");
+        return 1;
+    }
+
+    // El pool sigue usable mientras el hijo escribe
+    for (int i = 0; i < BLOQUES; i += 2) memset(bloques[i], 0xFF, TAMANO_BLOQUE);
+    for (int i = 1; i < BLOQUES; i += 2) memory_pool_free(pool, bloques[i], 1);
+    void* nuevo = memory_pool_alloc(pool, 100000, 1);
+    if (!nuevo) errores++;
+
+    memory_snapshot_info_t info;
+    int estado = memory_snapshot_wait(instantanea, &info);
+    if (estado != MEMORY_SUCCESS) {
+        printf("✗ La instantánea falló: %d\n", estado);
+        return 1;
+    }
+    printf("Pausa: %llu ns, escritura: %llu ns, %zu bytes escritos\n",
+           (unsigned long long)info.pause_ns, (unsigned long long)info.write_ns, info.bytes_written);
+    // Solo se escribe hasta la frontera de cero, no el heap completo
+    if (info.bytes_written == 0 || info.bytes_written >= 4096 + 4 * 1024 * 1024) {
+        printf("✗ Bytes escritos inesperados\n");
+        errores++;
+    }
+
+    memory_pool_t* copia = memory_pool_open(ruta);
+    if (!copia) {
+        printf("✗ No se pudo abrir la instantánea\n");
+        return 1;
+    }
+    size_t* raiz = memory_pool_get_root(copia);
+    if (!raiz) {
+        printf("✗ Instantánea sin raíz\n");
+        errores++;
+    } else {
+        for (int i = 0; i < BLOQUES; i++) {
+            unsigned char* datos = (unsigned char*)raiz + raiz[i];
+            for (int j = 0; j < TAMANO_BLOQUE; j++) {
+                if (datos[j] != (unsigned char)(i + 1)) {
+                    printf("✗ Bloque %d alterado en la instantánea\n", i);
+                    errores++;
+                    break;
+                }
+            }
+        }
+    }
+
+    // La copia es un pool completo: mismos bloques en uso y asignable
+    pool_metrics_t original, restaurado;
+    memory_pool_get_metrics(copia, &restaurado);
+    if (!memory_pool_check(copia) || restaurado.used_blocks != BLOQUES + 1) {
+        printf("✗ Instantánea inconsistente (%d bloques en uso)\n", restaurado.used_blocks);
+        errores++;
+    }
+    memory_pool_get_metrics(pool, &original);
+    if (original.used_blocks == restaurado.used_blocks) {
+        printf("✗ Los cambios posteriores llegaron a la instantánea\n");
+        errores++;
+    }
+    void* extra = memory_pool_alloc(copia, 1000, 1);
+    if (!extra) errores++;
+    memory_pool_free(copia, extra, 1);
+
+    memory_pool_destroy(copia);
+    memory_pool_free(pool, nuevo, 1);
+    memory_pool_destroy(pool);
+    unlink(ruta);
+
+    if (errores) {
+        printf("✗ %d errores\n", errores);
+        return 1;
+    }
+    printf("✓ Instantáneas correctas\n");
+    return 0;
+}
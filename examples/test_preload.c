@@ -0,0 +1,191 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <dlfcn.h>
+#include <libgen.h>
+#include <limits.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "../include/memory_pool.h"
+
+// El proceso padre se vuelve a ejecutar con LD_PRELOAD=libmemory_preload.so;
+// el hijo comprueba que la API estándar se sirve desde el pool. Las funciones
+// del pool se buscan en la .so, no en la copia estática de este binario.
+
+#define THREADS 4
+#define THREAD_OPS 20000
+
+typedef memory_pool_t* (*get_pool_fn)(void);
+typedef size_t (*usable_size_fn)(const memory_pool_t*, const void*);
+
+static int alineado(const void* ptr, size_t alignment) {
+    return ((uintptr_t)ptr & (alignment - 1)) == 0;
+}
+
+static void* trabajador(void* arg) {
+    unsigned seed = (unsigned)(uintptr_t)arg;
+    void* vivos[64] = {0};
+    for (int i = 0; i < THREAD_OPS; i++) {
+        int slot = rand_r(&seed) % 64;
+        free(vivos[slot]);
+        vivos[slot] = malloc(1 + rand_r(&seed) % 4096);
+        if (!vivos[slot]) return (void*)1;
+        memset(vivos[slot], i, 1);
+    }
+    for (int i = 0; i < 64; i++) free(vivos[i]);
+    return NULL;
+}
+
+static int hijo(void) {
+    int errores = 0;
+
+    void* handle = dlopen(getenv("LD_PRELOAD"), RTLD_NOW | RTLD_NOLOAD);
+    get_pool_fn get_pool = handle ? (get_pool_fn)dlsym(handle, "memory_preload_get_pool") : NULL;
+    usable_size_fn pool_usable = handle ? (usable_size_fn)dlsym(handle, "memory_pool_usable_size") : NULL;
+    if (!get_pool || !pool_usable) {
+        printf("✗ La biblioteca no está precargada\n");
+        return 1;
+    }
+
+    char* p = malloc(100);
+    memory_pool_t* pool = get_pool();
+    if (!pool || !p || !alineado(p, 16) || malloc_usable_size(p) < 100 || pool_usable(pool, p) < 100) {
+        printf("✗ malloc no se sirve desde el pool\n");
+        errores++;
+    }
+
+    // Asignaciones internas de la libc también pasan por el pool
+    char* copia = strdup("interposición");
+    if (!copia || pool_usable(pool, copia) < strlen(copia) + 1) {
+        printf("✗ strdup no usa el pool\n");
+        errores++;
+    }
+    free(copia);
+
+    unsigned char* ceros = calloc(1000, 4);
+    for (int i = 0; ceros && i < 4000; i++) {
+        if (ceros[i]) {
+            printf("✗ calloc devolvió memoria sucia\n");
+            errores++;
+            break;
+        }
+    }
+    free(ceros);
+    volatile size_t enorme = SIZE_MAX / 2;
+    if (calloc(enorme, 4) != NULL) {
+        printf("✗ calloc no detectó el desbordamiento\n");
+        errores++;
+    }
+    // Cerca de SIZE_MAX el tamaño alineado da la vuelta: debe fallar, no
+    // devolver un bloque diminuto
+    enorme = SIZE_MAX - 4;
+    errno = 0;
+    if (malloc(enorme) != NULL || errno != ENOMEM || calloc(1, enorme) != NULL) {
+        printf("✗ malloc/calloc de SIZE_MAX - 4 no fallaron\n");
+        errores++;
+    }
+
+    // realloc conserva el contenido al crecer (en su sitio o moviendo) y al encoger
+    for (int i = 0; i < 100; i++) p[i] = (char)i;
+    char* bloqueo = malloc(64);
+    for (size_t size = 200; size <= 256 * 1024; size *= 2) {
+        p = realloc(p, size);
+        if (!p) break;
+        for (int i = 0; i < 100; i++) {
+            if (p[i] != (char)i) {
+                printf("✗ realloc perdió el contenido a %zu bytes\n", size);
+                errores++;
+                break;
+            }
+        }
+    }
+    p = realloc(p, 50);
+    if (!p || p[49] != 49 || malloc_usable_size(p) >= 1024) {
+        printf("✗ realloc no encogió el bloque\n");
+        errores++;
+    }
+    free(p);
+    free(bloqueo);
+
+    size_t alignments[] = {32, 64, 256, 4096};
+    for (size_t i = 0; i < sizeof(alignments) / sizeof(alignments[0]); i++) {
+        void* q = NULL;
+        if (posix_memalign(&q, alignments[i], 1000) != 0 || !alineado(q, alignments[i])) {
+            printf("✗ posix_memalign(%zu) incorrecto\n", alignments[i]);
+            errores++;
+        }
+        void* r = aligned_alloc(alignments[i], 3 * alignments[i]);
+        void* s = memalign(alignments[i], 24);
+        if (!r || !s || !alineado(r, alignments[i]) || !alineado(s, alignments[i])) {
+            printf("✗ aligned_alloc/memalign(%zu) incorrecto\n", alignments[i]);
+            errores++;
+        }
+        free(q);
+        free(r);
+        free(s);
+    }
+    void* invalido;
+    if (posix_memalign(&invalido, 24, 100) != EINVAL) {
+        printf("✗ posix_memalign aceptó una alineación inválida\n");
+        errores++;
+    }
+
+    pthread_t hilos[THREADS];
+    for (int i = 0; i < THREADS; i++) pthread_create(&hilos[i], NULL, trabajador, (void*)(uintptr_t)(i + 1));
+    for (int i = 0; i < THREADS; i++) {
+        void* resultado;
+        pthread_join(hilos[i], &resultado);
+        if (resultado) errores++;
+    }
+
+    printf("Hijo con LD_PRELOAD: %s\n", errores ? "errores" : "correcto");
+    return errores ? 1 : 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && strcmp(argv[1], "--hijo") == 0) return hijo();
+
+    printf("=== TEST INTERPOSICIÓN DE MALLOC (LD_PRELOAD) ===\n");
+
+    char exe[PATH_MAX], so[PATH_MAX + 32];
+    if (!realpath(argv[0], exe)) return 1;
+    snprintf(so, sizeof(so), "%s/libmemory_preload.so", dirname(strdup(exe)));
+    if (access(so, R_OK) != 0) {
+        printf("✗ No se encontró %s\n", so);
+        return 1;
+    }
+
+    setenv("LD_PRELOAD", so, 1);
+    setenv("MEMORY_PRELOAD_POOL_SIZE", "268435456", 1);
+    fflush(stdout);
+
+    int errores = 0;
+    pid_t pid = fork();
+    if (pid == 0) {
+        execl(exe, exe, "--hijo", (char*)NULL);
+        _exit(127);
+    }
+    int status;
+    waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        printf("✗ El proceso hijo falló (estado %d)\n", status);
+        errores++;
+    }
+
+    // Un binario sin modificar (y con fork/exec internos del shell)
+    FILE* out = popen("seq 1 20000 | sort -R | sort -n | tail -n 1", "r");
+    char line[64] = "";
+    if (!out || !fgets(line, sizeof(line), out) || atoi(line) != 20000) {
+        printf("✗ sort con LD_PRELOAD produjo '%s'\n", line);
+        errores++;
+    }
+    if (out) pclose(out);
+
+    printf("=== Test %s ===\n", errores ? "FALLIDO" : "completado");
+    return errores ? 1 : 0;
+}
@@ -0,0 +1,163 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "../include/memory_pool.h"
+#include "../include/memory_client.h"
+#include "../include/memory_metrics.h"
+#include "../include/memory_verify.h"
+
+// Pools y clientes sin sincronizar: mismas asignaciones sin tomar ningún
+// mutex, rechazo del verificador en segundo plano y cesión del dueño a otro
+// hilo. Con MEMORY_DEBUG el uso desde un hilo que no es el dueño aborta.
+// Un cliente normal compartido por varios hilos sigue tomando su mutex.
+
+#define OPERACIONES 200000
+
+static double ns_por_operacion(memory_pool_t* pool) {
+    void* bloques[64];
+    struct timespec inicio, fin;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    for (int i = 0; i < OPERACIONES / 64; i++) {
+        for (int j = 0; j < 64; j++) bloques[j] = memory_pool_alloc(pool, 32 + j, 1);
+        for (int j = 0; j < 64; j++) memory_pool_free(pool, bloques[j], 1);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    double ns = (fin.tv_sec - inicio.tv_sec) * 1e9 + (fin.tv_nsec - inicio.tv_nsec);
+    return ns / (OPERACIONES / 64 * 128);
+}
+
+typedef struct {
+    memory_pool_t* pool;
+    memory_client_t* cliente;
+    int errores;
+} trabajo_t;
+
+static void* trabajador(void* arg) {
+    trabajo_t* trabajo = arg;
+    for (int i = 0; i < 1000; i++) {
+        void* p = memory_client_alloc(trabajo->cliente, 48);
+        void* q = memory_pool_alloc(trabajo->pool, 96, 2);
+        if (!p || !q) trabajo->errores++;
+        memory_client_free(trabajo->cliente, p);
+        memory_pool_free(trabajo->pool, q, 2);
+    }
+    // El hilo principal vuelve a usarlos después del join
+    memory_pool_release_owner(trabajo->pool);
+    memory_client_release_owner(trabajo->cliente);
+    return NULL;
+}
+
+// Cliente normal compartido: su tabla sigue protegida por el mutex
+#define HILOS_COMPARTIDOS 4
+#define VIVOS_POR_HILO 500
+
+static void* compartido(void* arg) {
+    memory_client_t* cliente = arg;
+    void* vivos[VIVOS_POR_HILO];
+    for (int ronda = 0; ronda < 4; ronda++) {
+        for (int i = 0; i < VIVOS_POR_HILO; i++) vivos[i] = memory_client_alloc(cliente, 24 + i % 40);
+        if (ronda < 3) {
+            for (int i = 0; i < VIVOS_POR_HILO; i++) memory_client_free(cliente, vivos[i]);
+        }
+    }
+    return NULL;
+}
+
+int main(void) {
+    printf("=== TEST POOL SIN SINCRONIZAR ===\n");
+    int errores = 0;
+
+    memory_pool_t* normal = memory_pool_create(1024 * 1024, ALLOC_FIRST_FIT);
+    memory_pool_t* local = memory_pool_create_ex(1024 * 1024, ALLOC_FIRST_FIT, MEMORY_POOL_FLAG_UNSYNCHRONIZED);
+    if (!normal || !local) return 1;
+
+    double con_mutex = ns_por_operacion(normal);
+    double sin_mutex = ns_por_operacion(local);
+    printf("Con mutex: %.1f ns/op, sin sincronizar: %.1f ns/op\n", con_mutex, sin_mutex);
+
+    // Ninguna toma del mutex, pero el resto de contadores sigue igual
+    pool_cost_counters_t costes_normal, costes_local;
+    memory_pool_get_cost_counters(normal, &costes_normal);
+    memory_pool_get_cost_counters(local, &costes_local);
+    if (costes_local.lock_acquisitions != 0 || costes_normal.lock_acquisitions == 0) {
+        printf("✗ Tomas del mutex: %zu sin sincronizar, %zu con mutex\n",
+               costes_local.lock_acquisitions, costes_normal.lock_acquisitions);
+        errores++;
+    }
+    if (costes_local.searches != costes_normal.searches) {
+        printf("✗ Búsquedas distintas: %zu frente a %zu\n", costes_local.searches, costes_normal.searches);
+        errores++;
+    }
+
+    pool_metrics_t metricas;
+    memory_pool_get_metrics(local, &metricas);
+    if (metricas.used_blocks != 0 || !memory_pool_check(local)) {
+        printf("✗ Pool sin sincronizar inconsistente\n");
+        errores++;
+    }
+
+    // Ningún hilo de fondo puede recorrerlo
+    if (memory_pool_verify_start(local, 64, 1) != MEMORY_ERROR_INVALID_PARAM) {
+        printf("✗ Verificador en segundo plano aceptado\n");
+        errores++;
+        memory_pool_verify_stop(local);
+    }
+
+    // Cliente sin sincronizar sobre el pool local, usado por otro hilo y
+    // devuelto al principal
+    memory_client_t* cliente = memory_client_create_ex(1, local, MEMORY_CLIENT_FLAG_UNSYNCHRONIZED);
+    if (!cliente) return 1;
+    memory_pool_release_owner(local);
+
+    trabajo_t trabajo = {local, cliente, 0};
+    pthread_t hilo;
+    pthread_create(&hilo, NULL, trabajador, &trabajo);
+    pthread_join(hilo, NULL);
+    errores += trabajo.errores;
+
+    for (int i = 0; i < 100; i++) {
+        if (!memory_client_alloc(cliente, 64)) errores++;
+    }
+    if (memory_client_get_allocated_count(cliente) != 100) {
+        printf("✗ El cliente registra %zu bloques\n", memory_client_get_allocated_count(cliente));
+        errores++;
+    }
+    memory_client_free_all(cliente);
+    memory_client_destroy(cliente);
+
+    memory_pool_get_metrics(local, &metricas);
+    if (metricas.used_blocks != 0) {
+        printf("✗ Quedan %d bloques en uso\n", metricas.used_blocks);
+        errores++;
+    }
+
+    // Varios hilos sobre un mismo cliente sincronizado: ningún registro se pierde
+    memory_client_t* comun = memory_client_create(3, normal);
+    pthread_t hilos[HILOS_COMPARTIDOS];
+    for (int i = 0; i < HILOS_COMPARTIDOS; i++) pthread_create(&hilos[i], NULL, compartido, comun);
+    for (int i = 0; i < HILOS_COMPARTIDOS; i++) pthread_join(hilos[i], NULL);
+    size_t registrados = memory_client_get_allocated_count(comun);
+    if (registrados != HILOS_COMPARTIDOS * VIVOS_POR_HILO) {
+        printf("✗ El cliente compartido registra %zu bloques (esperados %d)\n",
+               registrados, HILOS_COMPARTIDOS * VIVOS_POR_HILO);
+        errores++;
+    }
+    memory_client_destroy(comun);
+    memory_pool_get_metrics(normal, &metricas);
+    if (metricas.used_blocks != 0 || !memory_pool_check(normal)) {
+        printf("✗ El cliente compartido dejó %d bloques en uso\n", metricas.used_blocks);
+        errores++;
+    }
+
+    memory_pool_destroy(normal);
+    memory_pool_destroy(local);
+
+    if (errores) {
+        printf("✗ %d errores\n", errores);
+        return 1;
+    }
+    printf("✓ Pool sin sincronizar correcto\n");
+    return 0;
+}
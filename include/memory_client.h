@@ -4,18 +4,51 @@
 #include "memory_config.h"
 #include "memory_pool.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 // Estructura del cliente
 typedef struct memory_client memory_client_t;
 
+// Flags de creación del cliente
+// SUBHEAP: el cliente reparte asignaciones pequeñas (<= 1 KiB) desde tramos
+// privados del pool sin tomar locks. Solo válido con un único hilo dueño.
+#define MEMORY_CLIENT_FLAG_SUBHEAP 0x1u
+// UNSYNCHRONIZED: el cliente no toma su mutex (mismas reglas de dueño que
+// MEMORY_POOL_FLAG_UNSYNCHRONIZED); suele combinarse con un pool sin
+// sincronizar del mismo hilo.
+#define MEMORY_CLIENT_FLAG_UNSYNCHRONIZED 0x2u
+// AFFINE: ningún bloque del cliente comparte línea de caché con bloques de
+// otros clientes. Las asignaciones pequeñas salen de tramos del sub-heap
+// alineados a línea (implica SUBHEAP y un único hilo dueño); las grandes se
+// alinean y redondean a MEMORY_CACHE_LINE. Evita el false sharing entre
+// hilos que escriben cada uno en sus propios objetos.
+#define MEMORY_CLIENT_FLAG_AFFINE 0x4u
+#define MEMORY_CLIENT_DEFAULT_SPAN (64 * 1024)
+
 // API del cliente
 MEMORY_API memory_client_t* memory_client_create(int id, memory_pool_t* pool);
+MEMORY_API memory_client_t* memory_client_create_ex(int id, memory_pool_t* pool, unsigned flags);
+MEMORY_API int memory_client_reserve(memory_client_t* client, size_t bytes);
 MEMORY_API void memory_client_destroy(memory_client_t* client);
 MEMORY_API void* memory_client_alloc(memory_client_t* client, size_t size);
+MEMORY_API void* memory_client_alloc_aligned(memory_client_t* client, size_t alignment, size_t size);
+// Con espera (ver memory_pool_alloc_wait) y sin bloquear: alloc_async
+// devuelve NULL si no hay memoria o hay hilos en cola, y arma el eventfd de
+// memory_pool_wait_fd para avisar de la próxima liberación
+MEMORY_API void* memory_client_alloc_wait(memory_client_t* client, size_t size, long timeout_ms);
+MEMORY_API void* memory_client_alloc_async(memory_client_t* client, size_t size);
 MEMORY_API int memory_client_free(memory_client_t* client, void* ptr);
 MEMORY_API void memory_client_free_all(memory_client_t* client);
 MEMORY_API int memory_client_get_id(const memory_client_t* client);
 MEMORY_API size_t memory_client_get_allocated_count(const memory_client_t* client);
 MEMORY_API memory_pool_t* memory_client_get_pool(const memory_client_t* client);
 MEMORY_API int memory_client_reassign_pool(memory_client_t* client, memory_pool_t* new_pool);
+MEMORY_API void memory_client_release_owner(memory_client_t* client);
+
+#ifdef __cplusplus
+}
+#endif
 
 #endif // MEMORY_CLIENT_H
@@ -12,6 +12,11 @@
 // Macros de alineación
 #define ALIGN_SIZE(size) (((size) + (MEMORY_ALIGNMENT-1)) & ~(MEMORY_ALIGNMENT-1))
 #define MIN_BLOCK_SIZE 32
+
+// Línea de caché: granularidad de la colocación por cliente (MEMORY_CLIENT_FLAG_AFFINE)
+#ifndef MEMORY_CACHE_LINE
+#define MEMORY_CACHE_LINE 64
+#endif
 #define MAGIC_NUMBER 0xDEADBEEF
 
 // Estrategias de asignación
@@ -19,9 +24,13 @@ typedef enum {
     ALLOC_FIRST_FIT = 0,
     ALLOC_BEST_FIT = 1,
     ALLOC_WORST_FIT = 2,
-    ALLOC_NEXT_FIT = 3
+    ALLOC_NEXT_FIT = 3,
+    ALLOC_ADAPTIVE = 4          // elige entre las cuatro según la carga observada
 } alloc_strategy_t;
 
+// Estrategias de búsqueda concretas (ALLOC_ADAPTIVE siempre usa una de ellas)
+#define ALLOC_STRATEGY_COUNT 4
+
 // Códigos de retorno estandarizados
 typedef enum {
     MEMORY_SUCCESS = 0,
@@ -37,14 +46,22 @@ typedef enum {
     MEMORY_LOG_DEBUG = 0,
     MEMORY_LOG_INFO = 1,
     MEMORY_LOG_WARN = 2,
-    MEMORY_LOG_ERROR = 3
+    MEMORY_LOG_ERROR = 3,
+    MEMORY_LOG_OFF = 4
 } memory_log_level_t;
 
-// Feature flags
-#ifdef MEMORY_DEBUG
-#define MEMORY_LOG(level, ...) memory_log_internal(level, __FILE__, __LINE__, __VA_ARGS__)
-#else
-#define MEMORY_LOG(level, ...)
+// Los puntos de log siempre se compilan; el nivel se elige en tiempo de
+// ejecución (memory_log_set_level). Por defecto DEBUG con MEMORY_DEBUG y
+// ninguno sin él. Solo se expande dentro de la librería.
+#define MEMORY_LOG(level, ...) \
+    do { \
+        if (__builtin_expect((int)(level) >= __atomic_load_n(&memory_log_threshold, __ATOMIC_RELAXED), 0)) \
+            memory_log_internal(level, __FILE__, __LINE__, __VA_ARGS__); \
+    } while (0)
+
+// Histogramas de latencia por operación (-DMEMORY_LATENCY_HISTOGRAMS=0 los elimina)
+#ifndef MEMORY_LATENCY_HISTOGRAMS
+#define MEMORY_LATENCY_HISTOGRAMS 1
 #endif
 
 // API visibility
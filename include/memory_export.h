@@ -0,0 +1,49 @@
+#ifndef MEMORY_EXPORT_H
+#define MEMORY_EXPORT_H
+
+#include "memory_config.h"
+#include "memory_pool.h"
+#include "memory_client.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Exportación de métricas para monitorización: los pools y clientes
+// registrados con un nombre se vuelcan en formato de exposición de
+// Prometheus o en JSON. Solo se leen contadores (seqlock de métricas y
+// snapshots de histogramas): exportar nunca recorre el heap ni toma el mutex
+// de un pool.
+//
+// Los nombres admiten letras, dígitos y "_.:-". Destruir un pool o cliente
+// registrado lo quita del registro.
+
+typedef enum {
+    MEMORY_EXPORT_PROMETHEUS = 0,
+    MEMORY_EXPORT_JSON = 1
+} memory_export_format_t;
+
+#define MEMORY_EXPORT_MAX_ENTRIES 64
+#define MEMORY_EXPORT_NAME_SIZE 64
+
+MEMORY_API int memory_export_register_pool(const char* name, memory_pool_t* pool);
+MEMORY_API int memory_export_register_client(const char* name, memory_client_t* client);
+MEMORY_API int memory_export_unregister(const void* pool_or_client);
+
+// Escribe el texto en buffer con la semántica de snprintf: devuelve la
+// longitud completa (sin el '\0'); si es >= capacity la salida se truncó
+MEMORY_API size_t memory_export_render(memory_export_format_t format, char* buffer, size_t capacity);
+
+// Sirve las métricas desde un hilo de fondo por un socket Unix. Cada conexión
+// recibe una exposición completa y se cierra; si lo primero que envía el
+// cliente empieza por "json" la respuesta es JSON, si no Prometheus:
+//
+//     socat - UNIX-CONNECT:/run/app/memory.sock
+MEMORY_API int memory_export_serve(const char* socket_path);
+MEMORY_API void memory_export_stop(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MEMORY_EXPORT_H
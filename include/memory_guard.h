@@ -0,0 +1,41 @@
+#ifndef MEMORY_GUARD_H
+#define MEMORY_GUARD_H
+
+#include "memory_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Asignador de muestreo con páginas de guarda (estilo GWP-ASan): en promedio
+// una de cada sample_rate asignaciones de memory_pool_alloc (hasta una página)
+// se coloca al final de su propia página, pegada a una página PROT_NONE. Al
+// liberarla la página se protege, de modo que un desbordamiento o un uso tras
+// liberar provoca un fallo que se reporta por stderr con el cliente, el tamaño
+// y los backtraces de asignación y liberación antes de terminar el proceso.
+// Las dobles liberaciones y las escrituras en el relleno final se reportan al
+// liberar sin terminar el proceso.
+//
+// La región de páginas se reserva en el primer memory_guard_start y se
+// conserva toda la vida del proceso (los bloques muestreados pueden seguir
+// vivos tras memory_guard_stop).
+
+typedef struct {
+    size_t sample_rate;
+    size_t slots;
+    size_t slots_in_use;
+    size_t sampled_allocations;
+    size_t skipped_allocations;     // muestreadas sin hueco libre: fueron al pool
+    size_t errors_detected;
+} memory_guard_stats_t;
+
+MEMORY_API int memory_guard_start(size_t sample_rate, size_t slots);
+MEMORY_API void memory_guard_stop(void);
+MEMORY_API int memory_guard_is_active(void);
+MEMORY_API void memory_guard_get_stats(memory_guard_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MEMORY_GUARD_H
@@ -0,0 +1,39 @@
+#ifndef MEMORY_HISTOGRAM_H
+#define MEMORY_HISTOGRAM_H
+
+#include "memory_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Histograma log-lineal (estilo HDR) para latencias en nanosegundos.
+// Cada potencia de dos se divide en MEMORY_HISTOGRAM_SUB_BUCKETS/2 cubetas
+// lineales, con un error relativo máximo de 1/16 hasta ~2^40 ns.
+#define MEMORY_HISTOGRAM_SUB_BUCKET_BITS 5
+#define MEMORY_HISTOGRAM_SUB_BUCKETS (1 << MEMORY_HISTOGRAM_SUB_BUCKET_BITS)
+#define MEMORY_HISTOGRAM_MAX_BITS 40
+#define MEMORY_HISTOGRAM_BUCKETS \
+    ((MEMORY_HISTOGRAM_MAX_BITS - MEMORY_HISTOGRAM_SUB_BUCKET_BITS + 2) * (MEMORY_HISTOGRAM_SUB_BUCKETS / 2))
+
+typedef struct {
+    uint64_t counts[MEMORY_HISTOGRAM_BUCKETS];
+    uint64_t total_count;
+    uint64_t sum;
+    uint64_t min;
+    uint64_t max;
+} memory_histogram_t;
+
+// API de histogramas (los valores se registran con operaciones atómicas)
+MEMORY_API void memory_histogram_reset(memory_histogram_t* histogram);
+MEMORY_API void memory_histogram_record(memory_histogram_t* histogram, uint64_t value);
+MEMORY_API void memory_histogram_snapshot(const memory_histogram_t* histogram, memory_histogram_t* out);
+MEMORY_API void memory_histogram_merge(memory_histogram_t* dst, const memory_histogram_t* src);
+MEMORY_API uint64_t memory_histogram_percentile(const memory_histogram_t* histogram, double percentile);
+MEMORY_API double memory_histogram_mean(const memory_histogram_t* histogram);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MEMORY_HISTOGRAM_H
@@ -0,0 +1,47 @@
+#ifndef MEMORY_KERNELS_H
+#define MEMORY_KERNELS_H
+
+#include "memory_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Núcleos de limpieza y copia que usa el pool (creación, asignación con
+// limpieza, realloc que mueve). Por encima del umbral de streaming escriben
+// con stores no temporales en la variante más ancha que admite la CPU
+// (elegida al primer uso): un bloque enorme no expulsa de la caché el
+// conjunto de trabajo del hilo que lo asigna. Por debajo equivalen a
+// memset/memcpy.
+
+typedef enum {
+    MEMORY_KERNEL_GENERIC = 0,      // memset/memcpy de la libc, sin streaming
+    MEMORY_KERNEL_SSE2 = 1,
+    MEMORY_KERNEL_AVX2 = 2,
+    MEMORY_KERNEL_AVX512 = 3
+} memory_kernel_isa_t;
+
+#define MEMORY_KERNEL_ISA_COUNT 4
+
+#ifndef MEMORY_STREAMING_THRESHOLD
+#define MEMORY_STREAMING_THRESHOLD (4 * 1024 * 1024)
+#endif
+
+MEMORY_API void memory_zero(void* dst, size_t size);
+MEMORY_API void memory_copy(void* dst, const void* src, size_t size);   // sin solape
+
+MEMORY_API memory_kernel_isa_t memory_kernels_get_isa(void);
+MEMORY_API const char* memory_kernels_isa_name(memory_kernel_isa_t isa);
+MEMORY_API int memory_kernels_isa_supported(memory_kernel_isa_t isa);
+
+// Fuerzan una variante (si la CPU la admite) o un umbral para todo el
+// proceso; pensadas para pruebas y benchmarks
+MEMORY_API int memory_kernels_set_isa(memory_kernel_isa_t isa);
+MEMORY_API void memory_kernels_set_streaming_threshold(size_t bytes);
+MEMORY_API size_t memory_kernels_get_streaming_threshold(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MEMORY_KERNELS_H
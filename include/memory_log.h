@@ -0,0 +1,37 @@
+#ifndef MEMORY_LOG_H
+#define MEMORY_LOG_H
+
+#include "memory_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Nivel mínimo de los mensajes internos de la librería (MEMORY_LOG_OFF los
+// desactiva). Comprobarlo cuesta una carga relajada en cada punto de log.
+MEMORY_API void memory_log_set_level(memory_log_level_t level);
+MEMORY_API memory_log_level_t memory_log_get_level(void);
+
+// Backend asíncrono: cada hilo escribe sus mensajes en un anillo propio sin
+// locks y un hilo de fondo los vuelca a path (stderr si es NULL) con marca de
+// tiempo, nivel, hilo y origen. Si un anillo se llena el mensaje se descarta
+// y se cuenta: el asignador nunca espera al disco. Sin backend activo los
+// mensajes se escriben de forma síncrona en stderr.
+typedef struct {
+    size_t written_messages;
+    size_t dropped_messages;
+    size_t thread_rings;
+} memory_log_stats_t;
+
+#define MEMORY_LOG_MESSAGE_SIZE 192
+#define MEMORY_LOG_DEFAULT_RING 1024
+
+MEMORY_API int memory_log_start_async(const char* path, size_t ring_messages);
+MEMORY_API int memory_log_stop_async(void);   // vuelca lo pendiente y cierra
+MEMORY_API void memory_log_get_stats(memory_log_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MEMORY_LOG_H
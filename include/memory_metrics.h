@@ -2,6 +2,11 @@
 #define MEMORY_METRICS_H
 
 #include "memory_config.h"
+#include "memory_histogram.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
 
 // Estructura para métricas del pool
 typedef struct {
@@ -18,12 +23,88 @@ typedef struct {
     size_t failed_allocations;
 } pool_metrics_t;
 
+// Coste acumulado de las operaciones del pool, para saber qué parte de una
+// asignación lenta domina: la búsqueda en las listas libres, las divisiones,
+// las fusiones (la del anterior recorre el heap desde el principio), la
+// limpieza a cero o la contención del mutex.
+typedef struct {
+    size_t searches;                // búsquedas en las listas libres
+    size_t search_steps;            // bloques libres examinados por esas búsquedas
+    size_t splits;                  // bloques divididos al asignar o recortar
+    size_t forward_merges;          // fusiones con el bloque siguiente
+    size_t backward_merges;         // fusiones con el bloque anterior
+    size_t backward_walk_steps;     // headers recorridos buscando el anterior
+    size_t bytes_zeroed;
+    size_t lock_acquisitions;
+    size_t lock_contended;          // tomas que encontraron el mutex ocupado
+} pool_cost_counters_t;
+
+// Distribución de bloques libres por clase de tamaño (potencias de dos):
+// la clase k agrupa tamaños en [2^k, 2^(k+1)).
+#define MEMORY_SIZE_CLASSES 64
+
+typedef struct {
+    size_t free_blocks[MEMORY_SIZE_CLASSES];
+    size_t free_bytes[MEMORY_SIZE_CLASSES];
+    // Mayor petición de la clase k que tendría éxito ahora (0 si ninguna)
+    size_t max_allocatable[MEMORY_SIZE_CLASSES];
+    // Cota inferior de asignaciones simultáneas de 2^k bytes que caben hoy
+    size_t guaranteed_allocations[MEMORY_SIZE_CLASSES];
+    size_t largest_free_block;
+    int highest_class;
+} pool_free_distribution_t;
+
+// Operaciones con histograma de latencia
+typedef enum {
+    MEMORY_LATENCY_ALLOC = 0,
+    MEMORY_LATENCY_FREE = 1,
+    MEMORY_LATENCY_LOCK_WAIT = 2
+} memory_latency_op_t;
+
+// Decisiones de ALLOC_ADAPTIVE. Las tasas y la fragmentación son las de la
+// última ventana cerrada; cost[s] es el coste suavizado de cada estrategia
+// concreta (solo comparable entre estrategias del mismo pool).
+typedef struct {
+    alloc_strategy_t current_strategy;
+    size_t windows;
+    size_t switches;                // cambios por mejor coste
+    size_t explorations;            // cambios para volver a medir una estrategia
+    double search_length;           // bloques examinados por asignación
+    double split_rate;
+    double fragmentation;           // porcentaje, como pool_metrics_t
+    double failure_rate;
+    double cost[ALLOC_STRATEGY_COUNT];
+    size_t windows_per_strategy[ALLOC_STRATEGY_COUNT];
+} memory_adaptive_stats_t;
+
 // API de métricas
+// Las consultas de métricas son O(1) y no bloquean a los hilos que asignan;
+// memory_pool_walk_metrics recorre el heap completo (solo para verificación).
 MEMORY_API void memory_pool_get_metrics(void* pool, pool_metrics_t* metrics);
+MEMORY_API void memory_pool_walk_metrics(void* pool, pool_metrics_t* metrics);
+MEMORY_API int memory_pool_verify_metrics(void* pool);
 MEMORY_API void memory_pool_print_metrics(void* pool);
 MEMORY_API int memory_pool_check(void* pool);
 MEMORY_API double memory_pool_get_fragmentation(void* pool);
+MEMORY_API void memory_pool_get_free_distribution(void* pool, pool_free_distribution_t* distribution);
+MEMORY_API void memory_pool_print_free_distribution(void* pool);
 MEMORY_API size_t memory_pool_get_used_memory(void* pool);
 MEMORY_API size_t memory_pool_get_free_memory(void* pool);
 
+// Contadores de coste; en un grupo, la suma de sus pools. Se leen sin
+// bloquear y cada uno es exacto, pero no forman un snapshot conjunto.
+MEMORY_API void memory_pool_get_cost_counters(void* pool, pool_cost_counters_t* counters);
+MEMORY_API void memory_pool_print_cost_counters(void* pool);
+
+// Latencias: strategy < 0 combina todas las estrategias. LOCK_WAIT es por pool.
+MEMORY_API int memory_pool_get_latency(void* pool, memory_latency_op_t op, int strategy, memory_histogram_t* out);
+MEMORY_API void memory_pool_reset_latency(void* pool);
+
+// MEMORY_ERROR_INVALID_PARAM si el pool no usa ALLOC_ADAPTIVE
+MEMORY_API int memory_pool_get_adaptive_stats(void* pool, memory_adaptive_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif // MEMORY_METRICS_H
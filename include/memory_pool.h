@@ -3,18 +3,76 @@
 
 #include "memory_config.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 // Estructura opaca del pool
 typedef struct memory_pool memory_pool_t;
 
+// Flags de creación del pool
+// LAZY: reserva el espacio con mmap(MAP_NORESERVE) sin tocarlo; la creación
+// es O(1) y la memoria se compromete a medida que se usa.
+#define MEMORY_POOL_FLAG_LAZY 0x1u
+// UNSYNCHRONIZED: el pool no toma su mutex; solo puede usarlo un hilo a la
+// vez. El primer hilo que lo usa queda como dueño y, compilado con
+// MEMORY_DEBUG, el uso desde otro hilo aborta. memory_pool_release_owner
+// lo cede (p. ej. tras pthread_join) y memory_pool_destroy no lo comprueba.
+#define MEMORY_POOL_FLAG_UNSYNCHRONIZED 0x2u
+
 // API principal del pool
 MEMORY_API memory_pool_t* memory_pool_create(size_t total_size, alloc_strategy_t strategy);
+MEMORY_API memory_pool_t* memory_pool_create_ex(size_t total_size, alloc_strategy_t strategy, unsigned flags);
 MEMORY_API void memory_pool_destroy(memory_pool_t* pool);
 MEMORY_API void* memory_pool_alloc(memory_pool_t* pool, size_t size, int client_id);
 MEMORY_API int memory_pool_free(memory_pool_t* pool, void* ptr, int client_id);
+MEMORY_API size_t memory_pool_free_bulk(memory_pool_t* pool, void* const* ptrs, size_t count, int client_id);
+MEMORY_API void* memory_pool_realloc(memory_pool_t* pool, void* ptr, size_t size, int client_id);
+MEMORY_API void* memory_pool_alloc_aligned(memory_pool_t* pool, size_t alignment, size_t size, int client_id);
+MEMORY_API size_t memory_pool_usable_size(const memory_pool_t* pool, const void* ptr);
 MEMORY_API int memory_pool_set_strategy(memory_pool_t* pool, alloc_strategy_t strategy);
 MEMORY_API alloc_strategy_t memory_pool_get_strategy(const memory_pool_t* pool);
 MEMORY_API size_t memory_pool_get_total_size(const memory_pool_t* pool);
 MEMORY_API int memory_pool_is_valid(const memory_pool_t* pool);
+MEMORY_API void memory_pool_release_owner(memory_pool_t* pool);
+
+// Asignación con espera: si el pool está lleno, el hilo espera en una cola
+// FIFO hasta que una liberación deje sitio o pasen timeout_ms (negativo:
+// sin límite; 0: un solo intento). Las asignaciones sin espera no hacen cola.
+// memory_pool_wait_fd devuelve un eventfd no bloqueante que se vuelve
+// legible al liberar memoria tras un memory_client_alloc_async fallido; el
+// bucle de eventos lo lee y reintenta. Ningún hilo puede estar esperando
+// cuando se destruye el pool.
+MEMORY_API void* memory_pool_alloc_wait(memory_pool_t* pool, size_t size, int client_id, long timeout_ms);
+MEMORY_API int memory_pool_wait_fd(memory_pool_t* pool);
+
+// Pools persistentes respaldados por archivo (mmap). memory_pool_destroy
+// realiza un cierre limpio y conserva el contenido para memory_pool_open.
+MEMORY_API memory_pool_t* memory_pool_create_persistent(const char* path, size_t total_size, alloc_strategy_t strategy);
+MEMORY_API memory_pool_t* memory_pool_open(const char* path);
+MEMORY_API int memory_pool_sync(memory_pool_t* pool);
+MEMORY_API int memory_pool_set_root(memory_pool_t* pool, void* ptr);
+MEMORY_API void* memory_pool_get_root(const memory_pool_t* pool);
+MEMORY_API int memory_pool_is_persistent(const memory_pool_t* pool);
+
+// Instantánea copy-on-write de un pool no persistente: congela el heap con
+// una pausa del orden de un fork y lo escribe en segundo plano en path con
+// el formato de memory_pool_create_persistent, así que memory_pool_open lo
+// restaura. root es lo que devolverá memory_pool_get_root (puede ser NULL).
+// El pool sigue usable mientras tanto; las páginas que se modifiquen durante
+// la escritura se duplican. Cada instantánea debe terminarse con
+// memory_snapshot_wait, que devuelve el resultado y libera el manejador.
+typedef struct memory_snapshot memory_snapshot_t;
+
+typedef struct {
+    uint64_t pause_ns;              // tiempo con el pool bloqueado
+    uint64_t write_ns;              // escritura en segundo plano, fsync incluido
+    size_t bytes_written;           // el heap a cero no ocupa disco
+} memory_snapshot_info_t;
+
+MEMORY_API memory_snapshot_t* memory_pool_snapshot(memory_pool_t* pool, const char* path, void* root);
+MEMORY_API int memory_snapshot_done(const memory_snapshot_t* snapshot);
+MEMORY_API int memory_snapshot_wait(memory_snapshot_t* snapshot, memory_snapshot_info_t* info);
 
 // Funciones de debug (solo disponibles en modo DEBUG)
 #ifdef MEMORY_DEBUG
@@ -22,4 +80,8 @@ MEMORY_API void memory_pool_dump(const memory_pool_t* pool);
 MEMORY_API void memory_pool_validate(const memory_pool_t* pool);
 #endif
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif // MEMORY_POOL_H
@@ -0,0 +1,43 @@
+#ifndef MEMORY_POOL_GROUP_H
+#define MEMORY_POOL_GROUP_H
+
+#include "memory_config.h"
+#include "memory_pool.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Grupo de pools segregados por tamaño: cada clase tiene su propio pool y su
+// estrategia. alloc elige la clase por tamaño pedido y free encuentra el pool
+// dueño por dirección, de modo que los objetos pequeños no fragmentan las
+// regiones grandes y cada pool tiene su propio mutex.
+typedef struct memory_pool_group memory_pool_group_t;
+
+#define MEMORY_POOL_GROUP_MAX_CLASSES 16
+
+// Una clase recibe las peticiones de tamaño <= max_size no cubiertas por la
+// clase anterior. Las clases van en orden creciente de max_size; la última
+// puede usar SIZE_MAX para aceptar cualquier tamaño.
+typedef struct {
+    size_t max_size;
+    size_t pool_size;
+    alloc_strategy_t strategy;
+    unsigned flags;             // MEMORY_POOL_FLAG_*
+} memory_pool_group_class_t;
+
+MEMORY_API memory_pool_group_t* memory_pool_group_create(const memory_pool_group_class_t* classes, size_t count);
+MEMORY_API void memory_pool_group_destroy(memory_pool_group_t* group);
+
+// Vista del grupo como memory_pool_t: se puede pasar a memory_client_create y
+// a las funciones de métricas (que agregan todas las clases).
+// memory_pool_destroy sobre esta vista destruye el grupo completo.
+MEMORY_API memory_pool_t* memory_pool_group_as_pool(memory_pool_group_t* group);
+MEMORY_API size_t memory_pool_group_get_count(const memory_pool_group_t* group);
+MEMORY_API memory_pool_t* memory_pool_group_get_pool(const memory_pool_group_t* group, size_t index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MEMORY_POOL_GROUP_H
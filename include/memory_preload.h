@@ -0,0 +1,39 @@
+#ifndef MEMORY_PRELOAD_H
+#define MEMORY_PRELOAD_H
+
+#include "memory_config.h"
+#include "memory_pool.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Biblioteca de interposición (libmemory_preload.so): exporta malloc, free,
+// calloc, realloc, posix_memalign, aligned_alloc, memalign, valloc, pvalloc,
+// reallocarray y malloc_usable_size sobre un pool perezoso, para ejecutar
+// binarios sin modificar con
+//
+//     LD_PRELOAD=libmemory_preload.so programa
+//
+// Variables de entorno leídas al arrancar:
+//   MEMORY_PRELOAD_POOL_SIZE   tamaño del pool en bytes (por defecto 16 GiB,
+//                              reservado con MAP_NORESERVE)
+//   MEMORY_PRELOAD_STRATEGY    first | best | worst | next | adaptive (por defecto first)
+//   MEMORY_GUARD_SAMPLE_RATE   activa memory_guard con 1 de cada N asignaciones
+//                              y MEMORY_PRELOAD_GUARD_SLOTS huecos
+//
+// Las asignaciones previas a la creación del pool se sirven desde un buffer
+// estático y nunca se liberan.
+
+#define MEMORY_PRELOAD_DEFAULT_POOL_SIZE ((size_t)16 * 1024 * 1024 * 1024)
+#define MEMORY_PRELOAD_BOOTSTRAP_SIZE (256 * 1024)
+#define MEMORY_PRELOAD_GUARD_SLOTS 1024
+
+// Pool que respalda malloc en el proceso (NULL si aún no se ha creado)
+MEMORY_API memory_pool_t* memory_preload_get_pool(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MEMORY_PRELOAD_H
@@ -0,0 +1,39 @@
+#ifndef MEMORY_PROFILER_H
+#define MEMORY_PROFILER_H
+
+#include <stdio.h>
+#include "memory_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Perfilador de heap por muestreo: en promedio una muestra cada
+// sample_interval bytes asignados (muestreo geométrico), con backtrace del
+// punto de asignación. Las muestras viven hasta que el bloque se libera y
+// salen de una reserva fija: sin hueco libre, la muestra se descarta.
+
+typedef enum {
+    MEMORY_PROFILE_COLLAPSED = 0,   // "cliente;frame;...;frame bytes" (flamegraph)
+    MEMORY_PROFILE_PPROF = 1        // formato heap legacy de pprof (heap_v2)
+} memory_profile_format_t;
+
+typedef struct {
+    size_t sample_interval;
+    size_t total_samples;
+    size_t live_samples;
+    size_t live_bytes_estimate;
+    size_t dropped_samples;         // descartadas por agotar la reserva fija
+} memory_profiler_stats_t;
+
+MEMORY_API int memory_profiler_start(size_t sample_interval);
+MEMORY_API void memory_profiler_stop(void);
+MEMORY_API int memory_profiler_is_active(void);
+MEMORY_API void memory_profiler_get_stats(memory_profiler_stats_t* stats);
+MEMORY_API int memory_profiler_dump(FILE* out, memory_profile_format_t format);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MEMORY_PROFILER_H
@@ -0,0 +1,174 @@
+#ifndef MEMORY_RESOURCE_HPP
+#define MEMORY_RESOURCE_HPP
+
+// Adaptadores C++17 (solo header) para usar el pool con contenedores estándar:
+//
+//   memory::client_resource   std::pmr::memory_resource sobre memory_client_t
+//   memory::pool_resource     std::pmr::memory_resource sobre memory_pool_t
+//   memory::allocator<T>      Allocator con estado sobre cualquiera de los dos
+//
+//   memory_client_t* client = memory_client_create(1, pool);
+//   memory::client_resource resource(client);
+//   std::pmr::vector<int> v(&resource);
+//
+//   std::vector<int, memory::allocator<int>> w{memory::allocator<int>(client)};
+//
+// Las alineaciones hasta MEMORY_ALIGNMENT usan la asignación normal; las
+// mayores, memory_*_alloc_aligned. Un fallo de asignación lanza std::bad_alloc.
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+
+#include "memory_pool.h"
+#include "memory_client.h"
+
+namespace memory {
+
+// Origen de la memoria: un cliente (con su contabilidad y sub-heap) o un pool
+// directamente con un client_id fijo
+class backend {
+public:
+    explicit backend(memory_client_t* client) noexcept
+        : client_(client), pool_(memory_client_get_pool(client)), client_id_(memory_client_get_id(client)) {}
+
+    backend(memory_pool_t* pool, int client_id) noexcept
+        : client_(nullptr), pool_(pool), client_id_(client_id) {}
+
+    void* allocate(std::size_t bytes, std::size_t alignment) const {
+        if (bytes == 0) bytes = 1;
+
+        void* ptr;
+        if (client_) {
+            ptr = alignment <= MEMORY_ALIGNMENT ? memory_client_alloc(client_, bytes)
+                                                : memory_client_alloc_aligned(client_, alignment, bytes);
+        } else {
+            ptr = alignment <= MEMORY_ALIGNMENT ? memory_pool_alloc(pool_, bytes, client_id_)
+                                                : memory_pool_alloc_aligned(pool_, alignment, bytes, client_id_);
+        }
+        if (!ptr) throw std::bad_alloc();
+        return ptr;
+    }
+
+    // El pool conoce el tamaño de cada bloque: bytes y alignment solo
+    // completan la interfaz de liberación con tamaño
+    void deallocate(void* ptr, std::size_t /*bytes*/, std::size_t /*alignment*/) const noexcept {
+        if (client_) memory_client_free(client_, ptr);
+        else memory_pool_free(pool_, ptr, client_id_);
+    }
+
+    memory_client_t* client() const noexcept { return client_; }
+    memory_pool_t* pool() const noexcept { return pool_; }
+    int client_id() const noexcept { return client_id_; }
+
+    friend bool operator==(const backend& a, const backend& b) noexcept {
+        return a.client_ == b.client_ && a.pool_ == b.pool_ && a.client_id_ == b.client_id_;
+    }
+    friend bool operator!=(const backend& a, const backend& b) noexcept { return !(a == b); }
+
+private:
+    memory_client_t* client_;
+    memory_pool_t* pool_;
+    int client_id_;
+};
+
+// =============================================================================
+// std::pmr::memory_resource
+// =============================================================================
+
+class client_resource : public std::pmr::memory_resource {
+public:
+    explicit client_resource(memory_client_t* client) noexcept : backend_(client) {}
+
+    memory_client_t* client() const noexcept { return backend_.client(); }
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        return backend_.allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override {
+        backend_.deallocate(ptr, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        auto* same = dynamic_cast<const client_resource*>(&other);
+        return same && same->backend_ == backend_;
+    }
+
+private:
+    backend backend_;
+};
+
+class pool_resource : public std::pmr::memory_resource {
+public:
+    explicit pool_resource(memory_pool_t* pool, int client_id = 0) noexcept : backend_(pool, client_id) {}
+
+    memory_pool_t* pool() const noexcept { return backend_.pool(); }
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        return backend_.allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override {
+        backend_.deallocate(ptr, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        auto* same = dynamic_cast<const pool_resource*>(&other);
+        return same && same->backend_ == backend_;
+    }
+
+private:
+    backend backend_;
+};
+
+// =============================================================================
+// Allocator con estado
+// =============================================================================
+// Las copias comparten el mismo origen; se propaga con el contenedor en copia,
+// movimiento y swap para no liberar nunca en un origen distinto.
+
+template <class T>
+class allocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    explicit allocator(memory_client_t* client) noexcept : backend_(client) {}
+    allocator(memory_pool_t* pool, int client_id) noexcept : backend_(pool, client_id) {}
+
+    template <class U>
+    allocator(const allocator<U>& other) noexcept : backend_(other.get_backend()) {}
+
+    T* allocate(std::size_t count) {
+        if (count > static_cast<std::size_t>(-1) / sizeof(T)) throw std::bad_array_new_length();
+        return static_cast<T*>(backend_.allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* ptr, std::size_t count) noexcept {
+        backend_.deallocate(ptr, count * sizeof(T), alignof(T));
+    }
+
+    const backend& get_backend() const noexcept { return backend_; }
+
+    template <class U>
+    friend bool operator==(const allocator& a, const allocator<U>& b) noexcept {
+        return a.get_backend() == b.get_backend();
+    }
+    template <class U>
+    friend bool operator!=(const allocator& a, const allocator<U>& b) noexcept {
+        return !(a == b);
+    }
+
+private:
+    backend backend_;
+};
+
+} // namespace memory
+
+#endif // MEMORY_RESOURCE_HPP
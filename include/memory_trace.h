@@ -0,0 +1,61 @@
+#ifndef MEMORY_TRACE_H
+#define MEMORY_TRACE_H
+
+#include "memory_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Registro de trazas de asignación: cada alloc/free/realloc se escribe en un
+// buffer circular en memoria (sin bloquear a los asignadores) y un hilo de
+// fondo lo vuelca a un archivo binario. Si el buffer se llena, los eventos se
+// descartan y se contabilizan en dropped_events.
+
+#define MEMORY_TRACE_MAGIC "MMTRACE"
+#define MEMORY_TRACE_VERSION 1
+
+typedef enum {
+    MEMORY_TRACE_ALLOC = 1,
+    MEMORY_TRACE_FREE = 2,
+    MEMORY_TRACE_REALLOC = 3
+} memory_trace_event_type_t;
+
+// Cabecera del archivo de traza
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t event_size;
+    uint64_t start_time_ns;
+} memory_trace_file_header_t;
+
+// Evento de traza (48 bytes). address es 0 en asignaciones fallidas;
+// old_address solo se usa en REALLOC.
+typedef struct {
+    uint64_t timestamp_ns;      // desde memory_trace_start
+    uint64_t address;
+    uint64_t old_address;
+    uint64_t size;
+    int32_t client_id;
+    uint32_t thread;            // índice secuencial del hilo en la traza
+    uint8_t type;               // memory_trace_event_type_t
+    uint8_t reserved[7];
+} memory_trace_event_t;
+
+typedef struct {
+    size_t recorded_events;
+    size_t dropped_events;
+    size_t written_events;
+} memory_trace_stats_t;
+
+// API del tracer (global para todos los pools del proceso)
+MEMORY_API int memory_trace_start(const char* path, size_t ring_capacity);
+MEMORY_API int memory_trace_stop(void);
+MEMORY_API int memory_trace_is_active(void);
+MEMORY_API void memory_trace_get_stats(memory_trace_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MEMORY_TRACE_H
@@ -0,0 +1,47 @@
+#ifndef MEMORY_VERIFY_H
+#define MEMORY_VERIFY_H
+
+#include "memory_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Verificador incremental del heap: recorre los bloques en orden de
+// direcciones en tramos acotados, soltando el mutex del pool entre tramos,
+// de modo que la pausa máxima depende del tamaño del tramo y no del pool.
+// En cada bloque comprueba el magic del header, que el tamaño no salga del
+// pool, que no haya dos bloques libres contiguos sin fusionar y que los
+// bloques libres estén enlazados en la lista de su clase.
+//
+// El cursor del recorrido sobrevive a las fusiones que ocurren entre tramos.
+// Un recorrido completo no es una instantánea: cada bloque se comprueba en el
+// estado que tenía al visitarlo.
+
+typedef struct {
+    size_t passes_completed;        // recorridos completos del heap
+    size_t blocks_checked;          // bloques revisados en el recorrido actual
+    size_t bytes_checked;           // posición alcanzada en el recorrido actual
+    size_t total_bytes;
+    size_t errors;                  // errores acumulados desde el primer tramo
+} memory_verify_progress_t;
+
+// Se llama con el mutex del pool tomado: no debe usar el pool
+typedef void (*memory_verify_error_fn)(void* pool, const void* block, const char* reason, void* user_data);
+
+// Revisa como mucho max_blocks bloques con un único lock. Devuelve los errores
+// encontrados en este tramo (negativo si los parámetros son inválidos).
+MEMORY_API int memory_pool_verify_step(void* pool, size_t max_blocks, memory_verify_progress_t* progress);
+MEMORY_API void memory_pool_verify_get_progress(void* pool, memory_verify_progress_t* progress);
+MEMORY_API int memory_pool_verify_set_handler(void* pool, memory_verify_error_fn handler, void* user_data);
+
+// Hilo de fondo que ejecuta un tramo cada interval_ms hasta
+// memory_pool_verify_stop o la destrucción del pool
+MEMORY_API int memory_pool_verify_start(void* pool, size_t blocks_per_step, unsigned interval_ms);
+MEMORY_API void memory_pool_verify_stop(void* pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MEMORY_VERIFY_H
@@ -0,0 +1,183 @@
+#include "memory_internal.h"
+#include "../include/memory_metrics.h"
+#include <stdlib.h>
+#include <string.h>
+
+// =============================================================================
+// POLÍTICA ADAPTATIVA
+// =============================================================================
+// La carga se observa en ventanas de ADAPTIVE_WINDOW asignaciones. Al cerrar
+// una ventana se calcula el coste de la estrategia que la atendió:
+//
+//     coste = pasos de búsqueda por asignación
+//           + fragmentación (%) / 10
+//           + tasa de fallos * 1000
+//
+// y se suaviza con los costes anteriores de esa misma estrategia. Las
+// estrategias sin medir se prueban primero; después se elige la de menor
+// coste, con un margen de histéresis para no oscilar, y cada
+// ADAPTIVE_EXPLORE_PERIOD ventanas se vuelve a medir la que lleva más tiempo
+// sin usarse (la carga puede haber cambiado).
+
+#define ADAPTIVE_WINDOW 4096
+#define ADAPTIVE_EXPLORE_PERIOD 8
+#define ADAPTIVE_HYSTERESIS 0.9     // la alternativa debe costar un 10% menos
+#define ADAPTIVE_SMOOTHING 0.5      // peso de la ventana nueva en el coste
+
+static const char* const adaptive_names[ALLOC_STRATEGY_COUNT] = {"FIRST_FIT", "BEST_FIT", "WORST_FIT", "NEXT_FIT"};
+
+pool_adaptive_t* adaptive_create(void) {
+    pool_adaptive_t* adaptive = calloc(1, sizeof(pool_adaptive_t));
+    if (!adaptive) MEMORY_LOG(MEMORY_LOG_ERROR, "No se pudo reservar el estado adaptativo");
+    return adaptive;
+}
+
+// Fragmentación de la memoria libre a partir de los contadores incrementales
+static double adaptive_fragmentation(const memory_pool_t* pool) {
+    if (pool->metrics.free_blocks <= 1 || pool->metrics.free_memory == 0) return 0.0;
+    double fragmentation = (1.0 - (double)pool->metrics.largest_free_block / pool->metrics.free_memory) * 100.0;
+    return fragmentation > 0.0 ? fragmentation : 0.0;
+}
+
+static alloc_strategy_t adaptive_choose(pool_adaptive_t* adaptive, alloc_strategy_t current) {
+    adaptive->exploring = 0;
+
+    // Primero se mide cada estrategia al menos una vez
+    for (int s = 0; s < ALLOC_STRATEGY_COUNT; s++) {
+        if (!adaptive->measured[s]) {
+            adaptive->exploring = 1;
+            return (alloc_strategy_t)s;
+        }
+    }
+
+    if (adaptive->windows % ADAPTIVE_EXPLORE_PERIOD == 0) {
+        int stalest = 0;
+        for (int s = 1; s < ALLOC_STRATEGY_COUNT; s++) {
+            if (adaptive->last_window[s] < adaptive->last_window[stalest]) stalest = s;
+        }
+        if (stalest != (int)current) {
+            adaptive->exploring = 1;
+            return (alloc_strategy_t)stalest;
+        }
+    }
+
+    int best = 0;
+    for (int s = 1; s < ALLOC_STRATEGY_COUNT; s++) {
+        if (adaptive->cost[s] < adaptive->cost[best]) best = s;
+    }
+    if (adaptive->cost[best] < adaptive->cost[current] * ADAPTIVE_HYSTERESIS) return (alloc_strategy_t)best;
+    return current;
+}
+
+static void adaptive_close_window(memory_pool_t* pool, pool_adaptive_t* adaptive) {
+    double allocations = (double)adaptive->window_allocations;
+    adaptive->search_length = (double)(pool->costs.search_steps - adaptive->window_start_steps) / allocations;
+    adaptive->split_rate = (double)adaptive->window_splits / allocations;
+    adaptive->failure_rate = (double)adaptive->window_failures / allocations;
+    adaptive->fragmentation = adaptive_fragmentation(pool);
+
+    alloc_strategy_t current = pool->strategy;
+    double cost = adaptive->search_length + adaptive->fragmentation / 10.0 + adaptive->failure_rate * 1000.0;
+    adaptive->cost[current] = adaptive->measured[current]
+        ? adaptive->cost[current] * (1.0 - ADAPTIVE_SMOOTHING) + cost * ADAPTIVE_SMOOTHING
+        : cost;
+    adaptive->measured[current]++;
+    adaptive->windows++;
+    adaptive->last_window[current] = adaptive->windows;
+
+    alloc_strategy_t next = adaptive_choose(adaptive, current);
+    if (next != current) {
+        if (adaptive->exploring) adaptive->explorations++;
+        else adaptive->switches++;
+        pool->strategy = next;
+        pool->next_fit = NULL;
+        MEMORY_LOG(MEMORY_LOG_INFO, "Estrategia adaptativa: %s -> %s (%s, coste %.2f frente a %.2f)",
+                   adaptive_names[current], adaptive_names[next],
+                   adaptive->exploring ? "exploración" : "mejor coste",
+                   adaptive->cost[current], adaptive->cost[next]);
+    }
+
+    adaptive->window_allocations = 0;
+    adaptive->window_start_steps = pool->costs.search_steps;
+    adaptive->window_splits = 0;
+    adaptive->window_failures = 0;
+}
+
+// Se llama con el mutex del pool y dentro de la sección de escritura de
+// métricas, así los lectores ven cada decisión junto a sus contadores
+void adaptive_account(memory_pool_t* pool, int failed, int split) {
+    pool_adaptive_t* adaptive = pool->adaptive;
+
+    adaptive->window_allocations++;
+    adaptive->window_failures += (size_t)failed;
+    adaptive->window_splits += (size_t)split;
+
+    if (adaptive->window_allocations >= ADAPTIVE_WINDOW) adaptive_close_window(pool, adaptive);
+}
+
+// =============================================================================
+// API PÚBLICA
+// =============================================================================
+
+static int adaptive_read(memory_pool_t* pool, memory_adaptive_stats_t* stats) {
+    unsigned seq_start, seq_end;
+    int found;
+
+    do {
+        seq_start = __atomic_load_n(&pool->metrics_seq, __ATOMIC_ACQUIRE);
+        if (seq_start & 1) continue; // escritura en curso
+
+        const pool_adaptive_t* adaptive = __atomic_load_n(&pool->adaptive, __ATOMIC_RELAXED);
+        found = adaptive != NULL;
+        if (found) {
+            stats->current_strategy = __atomic_load_n(&pool->strategy, __ATOMIC_RELAXED);
+            stats->windows = adaptive->windows;
+            stats->switches = adaptive->switches;
+            stats->explorations = adaptive->explorations;
+            stats->search_length = adaptive->search_length;
+            stats->split_rate = adaptive->split_rate;
+            stats->fragmentation = adaptive->fragmentation;
+            stats->failure_rate = adaptive->failure_rate;
+            for (int s = 0; s < ALLOC_STRATEGY_COUNT; s++) {
+                stats->cost[s] = adaptive->cost[s];
+                stats->windows_per_strategy[s] = adaptive->measured[s];
+            }
+        }
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        seq_end = __atomic_load_n(&pool->metrics_seq, __ATOMIC_RELAXED);
+    } while ((seq_start & 1) || seq_start != seq_end);
+
+    return found;
+}
+
+// En un grupo se suman los contadores de las clases adaptativas; la
+// estrategia, las tasas y los costes son los de la clase con más ventanas
+MEMORY_API int memory_pool_get_adaptive_stats(void* pool_ptr, memory_adaptive_stats_t* stats) {
+    memory_pool_t* pool = (memory_pool_t*)pool_ptr;
+    if (!pool || !stats) return MEMORY_ERROR_INVALID_PARAM;
+
+    memset(stats, 0, sizeof(memory_adaptive_stats_t));
+    if (!pool->group) {
+        return adaptive_read(pool, stats) ? MEMORY_SUCCESS : MEMORY_ERROR_INVALID_PARAM;
+    }
+
+    int found = 0;
+    size_t windows = 0, switches = 0, explorations = 0;
+    memory_pool_t* member;
+    for (size_t i = 0; (member = pool_group_member(pool, i)); i++) {
+        memory_adaptive_stats_t member_stats;
+        if (!adaptive_read(member, &member_stats)) continue;
+
+        if (!found || member_stats.windows > stats->windows) *stats = member_stats;
+        windows += member_stats.windows;
+        switches += member_stats.switches;
+        explorations += member_stats.explorations;
+        found = 1;
+    }
+
+    stats->windows = windows;
+    stats->switches = switches;
+    stats->explorations = explorations;
+    return found ? MEMORY_SUCCESS : MEMORY_ERROR_INVALID_PARAM;
+}
@@ -3,166 +3,215 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 // =============================================================================
-// ESTRUCTURAS DE TABLA HASH
+// TABLA DE BLOQUES DEL CLIENTE (direccionamiento abierto, Robin Hood)
 // =============================================================================
+// Los punteros se guardan en línea en un array que se asigna del propio pool,
+// junto a un byte de control por celda (0 = vacía, 0x80 | 7 bits de hash).
+// La búsqueda compara 16 bytes de control a la vez (SSE2 cuando está
+// disponible) y el borrado desplaza hacia atrás, sin lápidas.
 
-#define HASH_TABLE_INITIAL_CAPACITY 16
-#define HASH_TABLE_LOAD_FACTOR_THRESHOLD 0.75
-#define HASH_TABLE_GROWTH_FACTOR 2
-
-typedef struct hash_node {
-    void* ptr;
-    struct hash_node* next;
-} hash_node_t;
+#define CLIENT_TABLE_GROUP 16
+#define CLIENT_TABLE_MIN_CAPACITY 16
+#define CLIENT_TABLE_OWNER (-2)     // client_id de los arrays de la tabla
+#define CLIENT_TABLE_NOT_FOUND ((size_t)-1)
 
 typedef struct {
-    hash_node_t** buckets;
-    size_t bucket_count;
+    void** keys;            // capacity punteros; el array de control va detrás
+    uint8_t* tags;          // capacity + CLIENT_TABLE_GROUP bytes (espejo del inicio)
+    size_t capacity;
     size_t element_count;
-    double load_factor_threshold;
-} hash_table_t;
+    memory_pool_t* pool;    // pool del que se asignó el array
+} client_table_t;
 
 // =============================================================================
-// FUNCIONES INTERNAS DE TABLA HASH
+// FUNCIONES INTERNAS DE LA TABLA
 // =============================================================================
 
-static uint32_t hash_ptr(void* ptr) {
-    uintptr_t key = (uintptr_t)ptr;
+static uint64_t hash_ptr(const void* ptr) {
+    uint64_t key = (uint64_t)(uintptr_t)ptr;
 
     // Mezcla de bits más efectiva
-    key = (key ^ (key >> 30)) * UINT32_C(0xbf58476d1ce4e5b9);
-    key = (key ^ (key >> 27)) * UINT32_C(0x94d049bb133111eb);
-    key = key ^ (key >> 31);
-
-    return (uint32_t)key;
+    key = (key ^ (key >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+    key = (key ^ (key >> 27)) * UINT64_C(0x94d049bb133111eb);
+    return key ^ (key >> 31);
 }
 
-static hash_table_t* hash_table_create(size_t initial_capacity) {
-    hash_table_t* table = malloc(sizeof(hash_table_t));
-    if (!table) return NULL;
+static inline uint8_t table_tag(uint64_t hash) {
+    return (uint8_t)(0x80 | (hash >> 57));
+}
 
-    table->bucket_count = initial_capacity > 0 ? initial_capacity : HASH_TABLE_INITIAL_CAPACITY;
-    table->element_count = 0;
-    table->load_factor_threshold = HASH_TABLE_LOAD_FACTOR_THRESHOLD;
-    table->buckets = calloc(table->bucket_count, sizeof(hash_node_t*));
+static inline size_t table_home(const client_table_t* table, const void* ptr) {
+    return (size_t)hash_ptr(ptr) & (table->capacity - 1);
+}
 
-    if (!table->buckets) {
-        free(table);
-        return NULL;
+static inline void table_set_tag(client_table_t* table, size_t index, uint8_t tag) {
+    table->tags[index] = tag;
+    if (index < CLIENT_TABLE_GROUP) {
+        table->tags[table->capacity + index] = tag;
     }
+}
 
-    return table;
+// Máscaras de coincidencia y de celdas vacías de un grupo de 16 bytes
+static inline void table_group_match(const uint8_t* group, uint8_t tag,
+                                     uint32_t* match, uint32_t* empty) {
+#ifdef __SSE2__
+    __m128i control = _mm_loadu_si128((const __m128i*)group);
+    *match = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_set1_epi8((char)tag)));
+    *empty = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_setzero_si128()));
+#else
+    *match = 0;
+    *empty = 0;
+    for (int i = 0; i < CLIENT_TABLE_GROUP; i++) {
+        if (group[i] == tag) *match |= 1u << i;
+        if (group[i] == 0) *empty |= 1u << i;
+    }
+#endif
 }
 
-static void hash_table_destroy(hash_table_t* table) {
-    if (!table) return;
+static size_t table_find(const client_table_t* table, const void* ptr) {
+    if (!table->capacity) return CLIENT_TABLE_NOT_FOUND;
+
+    uint64_t hash = hash_ptr(ptr);
+    size_t mask = table->capacity - 1;
+    size_t pos = (size_t)hash & mask;
+    uint8_t tag = table_tag(hash);
+
+    // Sin lápidas, una celda vacía corta la secuencia de sondeo
+    for (;;) {
+        uint32_t match, empty;
+        table_group_match(&table->tags[pos], tag, &match, &empty);
+        if (empty) match &= (empty & -empty) - 1;
 
-    for (size_t i = 0; i < table->bucket_count; i++) {
-        hash_node_t* current = table->buckets[i];
-        while (current) {
-            hash_node_t* next = current->next;
-            free(current);
-            current = next;
+        while (match) {
+            size_t index = (pos + (size_t)__builtin_ctz(match)) & mask;
+            if (table->keys[index] == ptr) return index;
+            match &= match - 1;
         }
+
+        if (empty) return CLIENT_TABLE_NOT_FOUND;
+        pos = (pos + CLIENT_TABLE_GROUP) & mask;
+    }
+}
+
+// Inserción Robin Hood: el elemento más lejos de su posición ideal se queda
+static void table_place(client_table_t* table, void* ptr) {
+    size_t mask = table->capacity - 1;
+    uint64_t hash = hash_ptr(ptr);
+    size_t pos = (size_t)hash & mask;
+    uint8_t tag = table_tag(hash);
+    size_t distance = 0;
+
+    while (table->tags[pos]) {
+        size_t existing = (pos - table_home(table, table->keys[pos])) & mask;
+        if (existing < distance) {
+            void* displaced = table->keys[pos];
+            uint8_t displaced_tag = table->tags[pos];
+            table->keys[pos] = ptr;
+            table_set_tag(table, pos, tag);
+            ptr = displaced;
+            tag = displaced_tag;
+            distance = existing;
+        }
+        pos = (pos + 1) & mask;
+        distance++;
     }
 
-    free(table->buckets);
-    free(table);
+    table->keys[pos] = ptr;
+    table_set_tag(table, pos, tag);
 }
 
-static int hash_table_resize(hash_table_t* table) {
-    if (!table) return 0;
+static void table_release(client_table_t* table) {
+    if (table->keys) {
+        memory_pool_free(table->pool, table->keys, CLIENT_TABLE_OWNER);
+    }
+    table->keys = NULL;
+    table->tags = NULL;
+    table->capacity = 0;
+    table->element_count = 0;
+    table->pool = NULL;
+}
 
-    size_t new_capacity = table->bucket_count * HASH_TABLE_GROWTH_FACTOR;
-    hash_node_t** new_buckets = calloc(new_capacity, sizeof(hash_node_t*));
-    if (!new_buckets) {
-        MEMORY_LOG(MEMORY_LOG_ERROR, "No se pudo redimensionar tabla hash a %zu buckets", new_capacity);
+static int table_resize(client_table_t* table, memory_pool_t* pool, size_t new_capacity) {
+    size_t bytes = new_capacity * sizeof(void*) + new_capacity + CLIENT_TABLE_GROUP;
+    void** keys = memory_pool_alloc(pool, bytes, CLIENT_TABLE_OWNER);
+    if (!keys) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "No se pudo redimensionar tabla a %zu celdas", new_capacity);
         return 0;
     }
+    memset(keys, 0, bytes);
 
-    // Rehash todos los elementos
-    for (size_t i = 0; i < table->bucket_count; i++) {
-        hash_node_t* current = table->buckets[i];
-        while (current) {
-            hash_node_t* next = current->next;
-            uint32_t new_index = hash_ptr(current->ptr) % new_capacity;
-
-            // Insertar en nueva tabla
-            current->next = new_buckets[new_index];
-            new_buckets[new_index] = current;
+    client_table_t old = *table;
+    table->keys = keys;
+    table->tags = (uint8_t*)(keys + new_capacity);
+    table->capacity = new_capacity;
+    table->pool = pool;
 
-            current = next;
-        }
+    for (size_t i = 0; i < old.capacity; i++) {
+        if (old.tags[i]) table_place(table, old.keys[i]);
+    }
+    if (old.keys) {
+        memory_pool_free(old.pool, old.keys, CLIENT_TABLE_OWNER);
     }
 
-    free(table->buckets);
-    table->buckets = new_buckets;
-    table->bucket_count = new_capacity;
-
-    MEMORY_LOG(MEMORY_LOG_DEBUG, "Tabla hash redimensionada a %zu buckets", new_capacity);
+    MEMORY_LOG(MEMORY_LOG_DEBUG, "Tabla de cliente redimensionada a %zu celdas", new_capacity);
     return 1;
 }
 
-static int hash_table_insert(hash_table_t* table, void* ptr) {
+static int table_insert(client_table_t* table, memory_pool_t* pool, void* ptr) {
     if (!table || !ptr) return 0;
 
-    // Verificar factor de carga y redimensionar si es necesario
-    double load_factor = (double)table->element_count / table->bucket_count;
-    if (load_factor > HASH_TABLE_LOAD_FACTOR_THRESHOLD) {
-        if (!hash_table_resize(table)) {
-            MEMORY_LOG(MEMORY_LOG_WARN, "No se pudo redimensionar tabla hash, continuando con capacidad actual");
+    // Factor de carga máximo 0.8; si el pool no da para crecer se sigue
+    // mientras quede al menos una celda vacía
+    if ((table->element_count + 1) * 5 > table->capacity * 4) {
+        size_t new_capacity = table->capacity ? table->capacity * 2 : CLIENT_TABLE_MIN_CAPACITY;
+        if (!table_resize(table, pool, new_capacity) &&
+            table->element_count + 1 >= table->capacity) {
+            return 0;
         }
     }
 
-    uint32_t bucket_index = hash_ptr(ptr) % table->bucket_count;
-    hash_node_t* new_node = malloc(sizeof(hash_node_t));
-    if (!new_node) return 0;
-
-    new_node->ptr = ptr;
-    new_node->next = table->buckets[bucket_index];
-    table->buckets[bucket_index] = new_node;
+    table_place(table, ptr);
     table->element_count++;
-
-    MEMORY_LOG(MEMORY_LOG_DEBUG, "Bloque %p insertado en bucket %u (elementos: %zu)",
-               ptr, bucket_index, table->element_count);
     return 1;
 }
 
-static int hash_table_remove(hash_table_t* table, void* ptr) {
+// Borrado con desplazamiento hacia atrás: los siguientes elementos de la
+// secuencia retroceden una celda hasta uno vacío o en su posición ideal
+static int table_remove(client_table_t* table, void* ptr) {
     if (!table || !ptr) return 0;
 
-    uint32_t bucket_index = hash_ptr(ptr) % table->bucket_count;
-    hash_node_t** current = &table->buckets[bucket_index];
+    size_t index = table_find(table, ptr);
+    if (index == CLIENT_TABLE_NOT_FOUND) return 0;
 
-    while (*current) {
-        if ((*current)->ptr == ptr) {
-            hash_node_t* to_remove = *current;
-            *current = to_remove->next;
-            free(to_remove);
-            table->element_count--;
-            return 1;
-        }
-        current = &(*current)->next;
+    size_t mask = table->capacity - 1;
+    size_t next = (index + 1) & mask;
+    while (table->tags[next] && table_home(table, table->keys[next]) != next) {
+        table->keys[index] = table->keys[next];
+        table_set_tag(table, index, table->tags[next]);
+        index = next;
+        next = (next + 1) & mask;
     }
 
-    return 0;
+    table->keys[index] = NULL;
+    table_set_tag(table, index, 0);
+    table->element_count--;
+    return 1;
 }
 
-static void hash_table_clear(hash_table_t* table) {
-    if (!table) return;
+// Mutex del cliente; con MEMORY_CLIENT_FLAG_UNSYNCHRONIZED solo se comprueba
+// el hilo dueño
+static inline void client_lock(memory_client_t* client) {
+    if (client->flags & MEMORY_CLIENT_FLAG_UNSYNCHRONIZED) owner_check(&client->owner, "Cliente");
+    else pthread_mutex_lock(&client->mutex);
+}
 
-    for (size_t i = 0; i < table->bucket_count; i++) {
-        hash_node_t* current = table->buckets[i];
-        while (current) {
-            hash_node_t* next = current->next;
-            free(current);
-            current = next;
-        }
-        table->buckets[i] = NULL;
-    }
-    table->element_count = 0;
+static inline void client_unlock(memory_client_t* client) {
+    if (!(client->flags & MEMORY_CLIENT_FLAG_UNSYNCHRONIZED)) pthread_mutex_unlock(&client->mutex);
 }
 
 // =============================================================================
@@ -172,25 +221,26 @@ static void hash_table_clear(hash_table_t* table) {
 static void memory_client_free_all_unsafe(memory_client_t* client) {
     if (!client) return;
 
-    hash_table_t* table = (hash_table_t*)client->allocated_blocks;
-    if (!table || table->element_count == 0) {
+    subheap_release_all(client);
+
+    client_table_t* table = (client_table_t*)client->allocated_blocks;
+    if (!table || !table->keys) {
         return;
     }
 
-    MEMORY_LOG(MEMORY_LOG_INFO, "Cliente %d liberando %zu bloques de tabla hash",
+    MEMORY_LOG(MEMORY_LOG_INFO, "Cliente %d liberando %zu bloques de la tabla",
                client->id, table->element_count);
 
-    for (size_t i = 0; i < table->bucket_count; i++) {
-        hash_node_t* current = table->buckets[i];
-        while (current) {
-            if (current->ptr) {
-                memory_pool_free(client->pool, current->ptr, client->id);
-            }
-            current = current->next;
-        }
+    // Se compactan los punteros al inicio del array y se liberan con un único
+    // lock y una sola pasada de fusión
+    size_t count = 0;
+    for (size_t i = 0; i < table->capacity; i++) {
+        if (table->tags[i]) table->keys[count++] = table->keys[i];
     }
+    memory_pool_free_bulk(client->pool, table->keys, count, client->id);
 
-    hash_table_clear(table);
+    // El array vuelve al pool; se asigna de nuevo en la próxima inserción
+    table_release(table);
 }
 
 // =============================================================================
@@ -198,6 +248,10 @@ static void memory_client_free_all_unsafe(memory_client_t* client) {
 // =============================================================================
 
 MEMORY_API memory_client_t* memory_client_create(int id, memory_pool_t* pool) {
+    return memory_client_create_ex(id, pool, 0);
+}
+
+MEMORY_API memory_client_t* memory_client_create_ex(int id, memory_pool_t* pool, unsigned flags) {
     if (!pool || id < 0) {
         MEMORY_LOG(MEMORY_LOG_ERROR, "Parámetros inválidos para crear cliente");
         return NULL;
@@ -209,46 +263,69 @@ MEMORY_API memory_client_t* memory_client_create(int id, memory_pool_t* pool) {
         return NULL;
     }
 
-    client->allocated_blocks = hash_table_create(HASH_TABLE_INITIAL_CAPACITY);
+    client->allocated_blocks = calloc(1, sizeof(client_table_t));
     if (!client->allocated_blocks) {
-        MEMORY_LOG(MEMORY_LOG_ERROR, "No se pudo crear tabla hash del cliente");
+        MEMORY_LOG(MEMORY_LOG_ERROR, "No se pudo crear tabla del cliente");
         free(client);
         return NULL;
     }
 
     if (pthread_mutex_init(&client->mutex, NULL) != 0) {
         MEMORY_LOG(MEMORY_LOG_ERROR, "No se pudo inicializar mutex del cliente");
-        hash_table_destroy((hash_table_t*)client->allocated_blocks);
+        free(client->allocated_blocks);
         free(client);
         return NULL;
     }
 
     client->id = id;
     client->pool = pool;
-
-    MEMORY_LOG(MEMORY_LOG_INFO, "Cliente %d creado con tabla hash", id);
+    // La colocación afín reparte las asignaciones pequeñas desde el sub-heap
+    client->flags = (flags & MEMORY_CLIENT_FLAG_AFFINE) ? flags | MEMORY_CLIENT_FLAG_SUBHEAP : flags;
+    client->owner = NULL;
+    client->span_size = MEMORY_CLIENT_DEFAULT_SPAN;
+    client->spans = NULL;
+    client->active_span = NULL;
+    client->subheap_live = 0;
+
+    MEMORY_LOG(MEMORY_LOG_INFO, "Cliente %d creado", id);
     return client;
 }
 
 MEMORY_API void memory_client_destroy(memory_client_t* client) {
     if (!client) return;
+    export_forget(client);
 
-    pthread_mutex_lock(&client->mutex);
-    MEMORY_LOG(MEMORY_LOG_INFO, "Destruyendo cliente %d", client->id);
+    int id = client->id;
+    client->owner = NULL;
+    client_lock(client);
+    MEMORY_LOG(MEMORY_LOG_INFO, "Destruyendo cliente %d", id);
 
     memory_client_free_all_unsafe(client);
 
-    if (client->allocated_blocks) {
-        hash_table_destroy((hash_table_t*)client->allocated_blocks);
-        client->allocated_blocks = NULL;
-    }
+    free(client->allocated_blocks);
+    client->allocated_blocks = NULL;
 
-    pthread_mutex_unlock(&client->mutex);
+    client_unlock(client);
     pthread_mutex_destroy(&client->mutex);
 
     free(client);
 
-    MEMORY_LOG(MEMORY_LOG_INFO, "Cliente %d destruido correctamente", client->id);
+    MEMORY_LOG(MEMORY_LOG_INFO, "Cliente %d destruido correctamente", id);
+}
+
+// Registra en la tabla del cliente un bloque recién asignado del pool
+static void* client_track(memory_client_t* client, void* block) {
+    if (!block) return NULL;
+
+    client_lock(client);
+    if (!table_insert((client_table_t*)client->allocated_blocks, client->pool, block)) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "No se pudo insertar bloque en la tabla del cliente");
+        memory_pool_free(client->pool, block, client->id);
+        client_unlock(client);
+        return NULL;
+    }
+    client_unlock(client);
+    return block;
 }
 
 MEMORY_API void* memory_client_alloc(memory_client_t* client, size_t size) {
@@ -257,18 +334,55 @@ MEMORY_API void* memory_client_alloc(memory_client_t* client, size_t size) {
         return NULL;
     }
 
-    void* block = memory_pool_alloc(client->pool, size, client->id);
-    if (block) {
-        pthread_mutex_lock(&client->mutex);
-        if (!hash_table_insert((hash_table_t*)client->allocated_blocks, block)) {
-            MEMORY_LOG(MEMORY_LOG_ERROR, "No se pudo insertar bloque en tabla hash");
-            memory_pool_free(client->pool, block, client->id);
-            pthread_mutex_unlock(&client->mutex);
-            return NULL;
-        }
-        pthread_mutex_unlock(&client->mutex);
+    // Sub-heap privado: sin locks; si no cabe se sigue por el pool
+    if (client->flags & MEMORY_CLIENT_FLAG_SUBHEAP) {
+        void* local = subheap_alloc(client, size);
+        if (local) return local;
     }
-    return block;
+
+    // Fuera del sub-heap un bloque afín ocupa sus propias líneas de caché
+    if (client->flags & MEMORY_CLIENT_FLAG_AFFINE) {
+        return client_track(client, memory_pool_alloc_aligned(client->pool, MEMORY_CACHE_LINE,
+                                                              affine_size(size), client->id));
+    }
+
+    return client_track(client, memory_pool_alloc(client->pool, size, client->id));
+}
+
+static void* client_attempt(void* context, size_t size) {
+    return memory_client_alloc((memory_client_t*)context, size);
+}
+
+MEMORY_API void* memory_client_alloc_wait(memory_client_t* client, size_t size, long timeout_ms) {
+    if (!client || size == 0) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "Parámetros inválidos para client_alloc_wait");
+        return NULL;
+    }
+    return pool_alloc_wait(client->pool, size, timeout_ms, client_attempt, client);
+}
+
+MEMORY_API void* memory_client_alloc_async(memory_client_t* client, size_t size) {
+    if (!client || size == 0) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "Parámetros inválidos para client_alloc_async");
+        return NULL;
+    }
+    return pool_alloc_async(client->pool, size, client_attempt, client);
+}
+
+// Los tramos del sub-heap solo garantizan MEMORY_ALIGNMENT: alineaciones
+// mayores van siempre al pool
+MEMORY_API void* memory_client_alloc_aligned(memory_client_t* client, size_t alignment, size_t size) {
+    if (!client) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "Cliente inválido");
+        return NULL;
+    }
+    if (alignment <= MEMORY_ALIGNMENT) return memory_client_alloc(client, size);
+    if (client->flags & MEMORY_CLIENT_FLAG_AFFINE) {
+        if (alignment < MEMORY_CACHE_LINE) alignment = MEMORY_CACHE_LINE;
+        size = affine_size(size);
+    }
+
+    return client_track(client, memory_pool_alloc_aligned(client->pool, alignment, size, client->id));
 }
 
 MEMORY_API int memory_client_free(memory_client_t* client, void* ptr) {
@@ -277,17 +391,22 @@ MEMORY_API int memory_client_free(memory_client_t* client, void* ptr) {
         return MEMORY_ERROR_INVALID_PARAM;
     }
 
+    if (client->spans) {
+        int local = subheap_free(client, ptr);
+        if (local <= MEMORY_SUCCESS) return local;
+    }
+
     int result = memory_pool_free(client->pool, ptr, client->id);
     if (result == MEMORY_SUCCESS) {
-        pthread_mutex_lock(&client->mutex);
-        if (hash_table_remove((hash_table_t*)client->allocated_blocks, ptr)) {
-            MEMORY_LOG(MEMORY_LOG_DEBUG, "Cliente %d removió bloque %p de tabla hash",
+        client_lock(client);
+        if (table_remove((client_table_t*)client->allocated_blocks, ptr)) {
+            MEMORY_LOG(MEMORY_LOG_DEBUG, "Cliente %d removió bloque %p de la tabla",
                        client->id, ptr);
         } else {
             MEMORY_LOG(MEMORY_LOG_WARN, "Cliente %d intentó liberar bloque %p no registrado",
                        client->id, ptr);
         }
-        pthread_mutex_unlock(&client->mutex);
+        client_unlock(client);
     }
     return result;
 }
@@ -298,9 +417,9 @@ MEMORY_API void memory_client_free_all(memory_client_t* client) {
         return;
     }
 
-    pthread_mutex_lock(&client->mutex);
+    client_lock(client);
     memory_client_free_all_unsafe(client);
-    pthread_mutex_unlock(&client->mutex);
+    client_unlock(client);
 
     MEMORY_LOG(MEMORY_LOG_INFO, "Cliente %d liberó todos los bloques", client->id);
 }
@@ -308,12 +427,25 @@ MEMORY_API void memory_client_free_all(memory_client_t* client) {
 MEMORY_API size_t memory_client_get_allocated_count(const memory_client_t* client) {
     if (!client || !client->allocated_blocks) return 0;
 
-    pthread_mutex_lock((pthread_mutex_t*)&client->mutex);
-    size_t count = ((hash_table_t*)client->allocated_blocks)->element_count;
-    pthread_mutex_unlock((pthread_mutex_t*)&client->mutex);
+    client_lock((memory_client_t*)client);
+    size_t count = ((client_table_t*)client->allocated_blocks)->element_count + client->subheap_live;
+    client_unlock((memory_client_t*)client);
     return count;
 }
 
+MEMORY_API int memory_client_reserve(memory_client_t* client, size_t bytes) {
+    if (!client || bytes == 0) return MEMORY_ERROR_INVALID_PARAM;
+
+    int result = subheap_enable(client, bytes);
+    MEMORY_LOG(MEMORY_LOG_INFO, "Cliente %d con sub-heap privado de tramos de %zu bytes",
+               client->id, client->span_size);
+    return result;
+}
+
+MEMORY_API void memory_client_release_owner(memory_client_t* client) {
+    if (client) __atomic_store_n(&client->owner, NULL, __ATOMIC_RELAXED);
+}
+
 MEMORY_API int memory_client_get_id(const memory_client_t* client) {
     return client ? client->id : -1;
 }
@@ -327,10 +459,10 @@ MEMORY_API int memory_client_reassign_pool(memory_client_t* client, memory_pool_
         return MEMORY_ERROR_INVALID_PARAM;
     }
 
-    pthread_mutex_lock(&client->mutex);
+    client_lock(client);
     memory_client_free_all_unsafe(client);
     client->pool = new_pool;
-    pthread_mutex_unlock(&client->mutex);
+    client_unlock(client);
 
     MEMORY_LOG(MEMORY_LOG_INFO, "Cliente %d reasignado a nuevo pool", client->id);
     return MEMORY_SUCCESS;
@@ -0,0 +1,542 @@
+#include "memory_internal.h"
+#include "../include/memory_export.h"
+#include "../include/memory_metrics.h"
+#include "../include/memory_histogram.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+// =============================================================================
+// REGISTRO
+// =============================================================================
+// Un array fijo bajo un mutex propio: renderizar y destruir un objeto
+// registrado se excluyen, así el hilo servidor nunca lee un pool liberado.
+
+typedef enum {
+    EXPORT_POOL = 0,
+    EXPORT_CLIENT = 1
+} export_kind_t;
+
+typedef struct {
+    export_kind_t kind;
+    const void* object;
+    char name[MEMORY_EXPORT_NAME_SIZE];
+} export_entry_t;
+
+static pthread_mutex_t export_mutex = PTHREAD_MUTEX_INITIALIZER;
+static export_entry_t export_entries[MEMORY_EXPORT_MAX_ENTRIES];
+static size_t export_count = 0;
+
+static int export_name_is_valid(const char* name) {
+    size_t length = strlen(name);
+    if (length == 0 || length >= MEMORY_EXPORT_NAME_SIZE) return 0;
+    for (size_t i = 0; i < length; i++) {
+        char c = name[i];
+        if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+              c == '_' || c == '.' || c == ':' || c == '-')) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int export_register(export_kind_t kind, const char* name, const void* object) {
+    if (!name || !object || !export_name_is_valid(name)) return MEMORY_ERROR_INVALID_PARAM;
+
+    pthread_mutex_lock(&export_mutex);
+    for (size_t i = 0; i < export_count; i++) {
+        if (export_entries[i].object == object) {
+            // Registrar de nuevo solo cambia el nombre
+            strcpy(export_entries[i].name, name);
+            pthread_mutex_unlock(&export_mutex);
+            return MEMORY_SUCCESS;
+        }
+    }
+    if (export_count == MEMORY_EXPORT_MAX_ENTRIES) {
+        pthread_mutex_unlock(&export_mutex);
+        MEMORY_LOG(MEMORY_LOG_ERROR, "Registro de exportación lleno (%d entradas)", MEMORY_EXPORT_MAX_ENTRIES);
+        return MEMORY_ERROR_OUT_OF_MEMORY;
+    }
+
+    export_entry_t* entry = &export_entries[export_count++];
+    entry->kind = kind;
+    entry->object = object;
+    strcpy(entry->name, name);
+    pthread_mutex_unlock(&export_mutex);
+    return MEMORY_SUCCESS;
+}
+
+// Llamado al destruir pools y clientes
+void export_forget(const void* object) {
+    memory_export_unregister(object);
+}
+
+static const char* export_pool_name(const memory_pool_t* pool) {
+    for (size_t i = 0; i < export_count; i++) {
+        if (export_entries[i].kind == EXPORT_POOL && export_entries[i].object == pool) {
+            return export_entries[i].name;
+        }
+    }
+    return NULL;
+}
+
+// =============================================================================
+// RENDERIZADO
+// =============================================================================
+
+typedef struct {
+    char* buffer;
+    size_t capacity;
+    size_t length;                  // longitud completa, aunque no quepa
+} export_writer_t;
+
+__attribute__((format(printf, 2, 3)))
+static void export_printf(export_writer_t* writer, const char* format, ...) {
+    size_t available = writer->length < writer->capacity ? writer->capacity - writer->length : 0;
+    char* target = available ? writer->buffer + writer->length : NULL;
+
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(target, available, format, args);
+    va_end(args);
+    if (written > 0) writer->length += (size_t)written;
+}
+
+typedef struct {
+    const char* op;
+    memory_latency_op_t kind;
+} export_latency_t;
+
+static const export_latency_t export_latencies[] = {
+    {"alloc", MEMORY_LATENCY_ALLOC},
+    {"free", MEMORY_LATENCY_FREE},
+    {"lock_wait", MEMORY_LATENCY_LOCK_WAIT},
+};
+
+static const double export_quantiles[] = {0.5, 0.9, 0.99, 0.999};
+
+#define EXPORT_LATENCY_COUNT (sizeof(export_latencies) / sizeof(export_latencies[0]))
+#define EXPORT_QUANTILE_COUNT (sizeof(export_quantiles) / sizeof(export_quantiles[0]))
+
+// Contadores y gauges del pool: nombre, tipo, ayuda y valor
+typedef struct {
+    const char* name;
+    const char* type;
+    const char* help;
+} export_metric_t;
+
+static const export_metric_t export_pool_metrics[] = {
+    {"memory_pool_total_bytes", "gauge", "Tamaño total del pool"},
+    {"memory_pool_used_bytes", "gauge", "Bytes en bloques usados, headers incluidos"},
+    {"memory_pool_free_bytes", "gauge", "Bytes en bloques libres, headers incluidos"},
+    {"memory_pool_used_blocks", "gauge", "Bloques en uso"},
+    {"memory_pool_free_blocks", "gauge", "Bloques libres"},
+    {"memory_pool_largest_free_block_bytes", "gauge", "Mayor bloque libre"},
+    {"memory_pool_fragmentation_ratio", "gauge", "Fragmentación de la memoria libre (0-1)"},
+    {"memory_pool_allocations_total", "counter", "Asignaciones intentadas"},
+    {"memory_pool_frees_total", "counter", "Liberaciones"},
+    {"memory_pool_failed_allocations_total", "counter", "Asignaciones fallidas"},
+    {"memory_pool_search_steps_total", "counter", "Bloques libres examinados por las búsquedas"},
+    {"memory_pool_splits_total", "counter", "Bloques divididos"},
+    {"memory_pool_forward_merges_total", "counter", "Fusiones con el bloque siguiente"},
+    {"memory_pool_backward_merges_total", "counter", "Fusiones con el bloque anterior"},
+    {"memory_pool_backward_walk_steps_total", "counter", "Headers recorridos buscando el bloque anterior"},
+    {"memory_pool_zeroed_bytes_total", "counter", "Bytes limpiados a cero"},
+    {"memory_pool_lock_acquisitions_total", "counter", "Tomas del mutex del pool"},
+    {"memory_pool_lock_contended_total", "counter", "Tomas del mutex que tuvieron que esperar"},
+};
+
+#define EXPORT_POOL_METRIC_COUNT (sizeof(export_pool_metrics) / sizeof(export_pool_metrics[0]))
+
+static void export_pool_values(memory_pool_t* pool, double values[EXPORT_POOL_METRIC_COUNT]) {
+    pool_metrics_t metrics;
+    memory_pool_get_metrics(pool, &metrics);
+
+    values[0] = (double)metrics.total_memory;
+    values[1] = (double)metrics.used_memory;
+    values[2] = (double)metrics.free_memory;
+    values[3] = (double)metrics.used_blocks;
+    values[4] = (double)metrics.free_blocks;
+    values[5] = (double)metrics.largest_free_block;
+    values[6] = metrics.fragmentation / 100.0;
+    values[7] = (double)metrics.allocation_count;
+    values[8] = (double)metrics.free_count;
+    values[9] = (double)metrics.failed_allocations;
+
+    pool_cost_counters_t costs;
+    memory_pool_get_cost_counters(pool, &costs);
+    values[10] = (double)costs.search_steps;
+    values[11] = (double)costs.splits;
+    values[12] = (double)costs.forward_merges;
+    values[13] = (double)costs.backward_merges;
+    values[14] = (double)costs.backward_walk_steps;
+    values[15] = (double)costs.bytes_zeroed;
+    values[16] = (double)costs.lock_acquisitions;
+    values[17] = (double)costs.lock_contended;
+}
+
+static const char* const export_strategy_names[ALLOC_STRATEGY_COUNT] = {"first_fit", "best_fit", "worst_fit", "next_fit"};
+
+// Decisiones de ALLOC_ADAPTIVE: solo los pools que lo usan tienen estas series
+static void export_prometheus_adaptive(export_writer_t* writer) {
+    memory_adaptive_stats_t stats[MEMORY_EXPORT_MAX_ENTRIES];
+    int adaptive[MEMORY_EXPORT_MAX_ENTRIES] = {0};
+    for (size_t i = 0; i < export_count; i++) {
+        adaptive[i] = export_entries[i].kind == EXPORT_POOL &&
+                      memory_pool_get_adaptive_stats((void*)export_entries[i].object, &stats[i]) == MEMORY_SUCCESS;
+    }
+
+    export_printf(writer, "# HELP memory_pool_adaptive_strategy Estrategia elegida por ALLOC_ADAPTIVE\n"
+                          "# TYPE memory_pool_adaptive_strategy gauge\n");
+    for (size_t i = 0; i < export_count; i++) {
+        if (!adaptive[i]) continue;
+        for (int s = 0; s < ALLOC_STRATEGY_COUNT; s++) {
+            export_printf(writer, "memory_pool_adaptive_strategy{pool=\"%s\",strategy=\"%s\"} %d\n",
+                          export_entries[i].name, export_strategy_names[s], (int)stats[i].current_strategy == s);
+        }
+    }
+
+    export_printf(writer, "# HELP memory_pool_adaptive_cost Coste suavizado de cada estrategia\n"
+                          "# TYPE memory_pool_adaptive_cost gauge\n");
+    for (size_t i = 0; i < export_count; i++) {
+        if (!adaptive[i]) continue;
+        for (int s = 0; s < ALLOC_STRATEGY_COUNT; s++) {
+            if (!stats[i].windows_per_strategy[s]) continue;
+            export_printf(writer, "memory_pool_adaptive_cost{pool=\"%s\",strategy=\"%s\"} %.17g\n",
+                          export_entries[i].name, export_strategy_names[s], stats[i].cost[s]);
+        }
+    }
+
+    export_printf(writer, "# HELP memory_pool_adaptive_windows_total Ventanas de observación cerradas\n"
+                          "# TYPE memory_pool_adaptive_windows_total counter\n");
+    for (size_t i = 0; i < export_count; i++) {
+        if (!adaptive[i]) continue;
+        export_printf(writer, "memory_pool_adaptive_windows_total{pool=\"%s\"} %zu\n",
+                      export_entries[i].name, stats[i].windows);
+    }
+
+    export_printf(writer, "# HELP memory_pool_adaptive_switches_total Cambios de estrategia\n"
+                          "# TYPE memory_pool_adaptive_switches_total counter\n");
+    for (size_t i = 0; i < export_count; i++) {
+        if (!adaptive[i]) continue;
+        export_printf(writer, "memory_pool_adaptive_switches_total{pool=\"%s\",reason=\"cost\"} %zu\n"
+                              "memory_pool_adaptive_switches_total{pool=\"%s\",reason=\"exploration\"} %zu\n",
+                      export_entries[i].name, stats[i].switches, export_entries[i].name, stats[i].explorations);
+    }
+
+    export_printf(writer, "# HELP memory_pool_adaptive_search_length Bloques examinados por asignación en la última ventana\n"
+                          "# TYPE memory_pool_adaptive_search_length gauge\n");
+    for (size_t i = 0; i < export_count; i++) {
+        if (!adaptive[i]) continue;
+        export_printf(writer, "memory_pool_adaptive_search_length{pool=\"%s\"} %.17g\n",
+                      export_entries[i].name, stats[i].search_length);
+    }
+}
+
+static void export_prometheus(export_writer_t* writer) {
+    // Una lectura de métricas por pool: todas sus series salen del mismo instante
+    double values[MEMORY_EXPORT_MAX_ENTRIES][EXPORT_POOL_METRIC_COUNT];
+    for (size_t i = 0; i < export_count; i++) {
+        if (export_entries[i].kind == EXPORT_POOL) {
+            export_pool_values((memory_pool_t*)export_entries[i].object, values[i]);
+        }
+    }
+
+    for (size_t m = 0; m < EXPORT_POOL_METRIC_COUNT; m++) {
+        export_printf(writer, "# HELP %s %s\n# TYPE %s %s\n", export_pool_metrics[m].name,
+                      export_pool_metrics[m].help, export_pool_metrics[m].name, export_pool_metrics[m].type);
+        for (size_t i = 0; i < export_count; i++) {
+            if (export_entries[i].kind != EXPORT_POOL) continue;
+            export_printf(writer, "%s{pool=\"%s\"} %.17g\n", export_pool_metrics[m].name,
+                          export_entries[i].name, values[i][m]);
+        }
+    }
+
+    export_printf(writer, "# HELP memory_pool_free_class_blocks Bloques libres por clase de tamaño (2^class)\n"
+                          "# TYPE memory_pool_free_class_blocks gauge\n");
+    for (size_t i = 0; i < export_count; i++) {
+        if (export_entries[i].kind != EXPORT_POOL) continue;
+        pool_free_distribution_t distribution;
+        memory_pool_get_free_distribution((void*)export_entries[i].object, &distribution);
+        for (int cls = 0; cls <= distribution.highest_class; cls++) {
+            if (!distribution.free_blocks[cls]) continue;
+            export_printf(writer, "memory_pool_free_class_blocks{pool=\"%s\",class=\"%d\"} %zu\n",
+                          export_entries[i].name, cls, distribution.free_blocks[cls]);
+        }
+    }
+
+    export_printf(writer, "# HELP memory_pool_latency_seconds Latencia de operaciones del pool\n"
+                          "# TYPE memory_pool_latency_seconds summary\n");
+    for (size_t i = 0; i < export_count; i++) {
+        if (export_entries[i].kind != EXPORT_POOL) continue;
+        for (size_t l = 0; l < EXPORT_LATENCY_COUNT; l++) {
+            memory_histogram_t histogram;
+            if (memory_pool_get_latency((void*)export_entries[i].object, export_latencies[l].kind, -1,
+                                        &histogram) != MEMORY_SUCCESS) {
+                continue;
+            }
+            const char* name = export_entries[i].name;
+            const char* op = export_latencies[l].op;
+            for (size_t q = 0; q < EXPORT_QUANTILE_COUNT; q++) {
+                export_printf(writer, "memory_pool_latency_seconds{pool=\"%s\",op=\"%s\",quantile=\"%g\"} %.9f\n",
+                              name, op, export_quantiles[q],
+                              memory_histogram_percentile(&histogram, export_quantiles[q] * 100) / 1e9);
+            }
+            export_printf(writer, "memory_pool_latency_seconds_sum{pool=\"%s\",op=\"%s\"} %.9f\n",
+                          name, op, histogram.sum / 1e9);
+            export_printf(writer, "memory_pool_latency_seconds_count{pool=\"%s\",op=\"%s\"} %llu\n",
+                          name, op, (unsigned long long)histogram.total_count);
+        }
+    }
+
+    export_prometheus_adaptive(writer);
+
+    export_printf(writer, "# HELP memory_client_allocated_blocks Bloques vivos del cliente\n"
+                          "# TYPE memory_client_allocated_blocks gauge\n");
+    for (size_t i = 0; i < export_count; i++) {
+        if (export_entries[i].kind != EXPORT_CLIENT) continue;
+        const memory_client_t* client = export_entries[i].object;
+        const char* pool_name = export_pool_name(memory_client_get_pool(client));
+        export_printf(writer, "memory_client_allocated_blocks{client=\"%s\",id=\"%d\",pool=\"%s\"} %zu\n",
+                      export_entries[i].name, memory_client_get_id(client), pool_name ? pool_name : "",
+                      memory_client_get_allocated_count(client));
+    }
+}
+
+static void export_json(export_writer_t* writer) {
+    export_printf(writer, "{\"pools\":[");
+    int first = 1;
+    for (size_t i = 0; i < export_count; i++) {
+        if (export_entries[i].kind != EXPORT_POOL) continue;
+        memory_pool_t* pool = (memory_pool_t*)export_entries[i].object;
+
+        export_printf(writer, "%s{\"name\":\"%s\"", first ? "" : ",", export_entries[i].name);
+        first = 0;
+
+        // Los nombres de JSON son los de Prometheus sin el prefijo común
+        double values[EXPORT_POOL_METRIC_COUNT];
+        export_pool_values(pool, values);
+        for (size_t m = 0; m < EXPORT_POOL_METRIC_COUNT; m++) {
+            export_printf(writer, ",\"%s\":%.17g", export_pool_metrics[m].name + strlen("memory_pool_"), values[m]);
+        }
+
+        pool_free_distribution_t distribution;
+        memory_pool_get_free_distribution(pool, &distribution);
+        export_printf(writer, ",\"free_classes\":[");
+        int first_class = 1;
+        for (int cls = 0; cls <= distribution.highest_class; cls++) {
+            if (!distribution.free_blocks[cls]) continue;
+            export_printf(writer, "%s{\"class\":%d,\"blocks\":%zu,\"bytes\":%zu}", first_class ? "" : ",",
+                          cls, distribution.free_blocks[cls], distribution.free_bytes[cls]);
+            first_class = 0;
+        }
+        export_printf(writer, "],\"latency_ns\":{");
+
+        int first_latency = 1;
+        for (size_t l = 0; l < EXPORT_LATENCY_COUNT; l++) {
+            memory_histogram_t histogram;
+            if (memory_pool_get_latency(pool, export_latencies[l].kind, -1, &histogram) != MEMORY_SUCCESS) continue;
+            export_printf(writer, "%s\"%s\":{\"count\":%llu,\"mean\":%.1f,\"p50\":%llu,\"p99\":%llu,\"max\":%llu}",
+                          first_latency ? "" : ",", export_latencies[l].op,
+                          (unsigned long long)histogram.total_count, memory_histogram_mean(&histogram),
+                          (unsigned long long)memory_histogram_percentile(&histogram, 50),
+                          (unsigned long long)memory_histogram_percentile(&histogram, 99),
+                          (unsigned long long)(histogram.total_count ? histogram.max : 0));
+            first_latency = 0;
+        }
+        export_printf(writer, "}");
+
+        memory_adaptive_stats_t adaptive;
+        if (memory_pool_get_adaptive_stats(pool, &adaptive) == MEMORY_SUCCESS) {
+            export_printf(writer, ",\"adaptive\":{\"strategy\":\"%s\",\"windows\":%zu,\"switches\":%zu,"
+                                  "\"explorations\":%zu,\"search_length\":%.17g,\"split_rate\":%.17g,"
+                                  "\"failure_rate\":%.17g,\"cost\":{",
+                          export_strategy_names[adaptive.current_strategy], adaptive.windows, adaptive.switches,
+                          adaptive.explorations, adaptive.search_length, adaptive.split_rate, adaptive.failure_rate);
+            int first_cost = 1;
+            for (int s = 0; s < ALLOC_STRATEGY_COUNT; s++) {
+                if (!adaptive.windows_per_strategy[s]) continue;
+                export_printf(writer, "%s\"%s\":%.17g", first_cost ? "" : ",", export_strategy_names[s],
+                              adaptive.cost[s]);
+                first_cost = 0;
+            }
+            export_printf(writer, "}}");
+        }
+        export_printf(writer, "}");
+    }
+
+    export_printf(writer, "],\"clients\":[");
+    first = 1;
+    for (size_t i = 0; i < export_count; i++) {
+        if (export_entries[i].kind != EXPORT_CLIENT) continue;
+        const memory_client_t* client = export_entries[i].object;
+        const char* pool_name = export_pool_name(memory_client_get_pool(client));
+
+        export_printf(writer, "%s{\"name\":\"%s\",\"id\":%d,\"pool\":%s%s%s,\"allocated_blocks\":%zu}",
+                      first ? "" : ",", export_entries[i].name, memory_client_get_id(client),
+                      pool_name ? "\"" : "", pool_name ? pool_name : "null", pool_name ? "\"" : "",
+                      memory_client_get_allocated_count(client));
+        first = 0;
+    }
+    export_printf(writer, "]}\n");
+}
+
+// =============================================================================
+// SERVIDOR
+// =============================================================================
+
+#define EXPORT_POLL_MS 100
+#define EXPORT_REQUEST_MS 50
+#define EXPORT_INITIAL_BUFFER (64 * 1024)
+
+static pthread_mutex_t export_server_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_t export_server;
+static int export_running = 0;
+static int export_listen_fd = -1;
+static char export_socket_path[sizeof(((struct sockaddr_un*)0)->sun_path)];
+
+static void export_answer(int fd) {
+    // Petición opcional: se espera poco para no retener a clientes mudos
+    char request[16] = {0};
+    struct pollfd readable = {fd, POLLIN, 0};
+    if (poll(&readable, 1, EXPORT_REQUEST_MS) > 0) {
+        ssize_t received = read(fd, request, sizeof(request) - 1);
+        (void)received;
+    }
+    memory_export_format_t format = strncmp(request, "json", 4) == 0 ? MEMORY_EXPORT_JSON : MEMORY_EXPORT_PROMETHEUS;
+
+    size_t capacity = EXPORT_INITIAL_BUFFER;
+    char* text = malloc(capacity);
+    size_t length = text ? memory_export_render(format, text, capacity) : 0;
+    if (text && length >= capacity) {
+        free(text);
+        capacity = length + 1;
+        text = malloc(capacity);
+        length = text ? memory_export_render(format, text, capacity) : 0;
+        if (length >= capacity) length = capacity - 1;
+    }
+
+    for (size_t sent = 0; text && sent < length;) {
+        ssize_t written = send(fd, text + sent, length - sent, MSG_NOSIGNAL);
+        if (written <= 0) break;
+        sent += (size_t)written;
+    }
+    free(text);
+}
+
+static void* export_server_main(void* arg) {
+    (void)arg;
+    struct pollfd listening = {export_listen_fd, POLLIN, 0};
+
+    while (__atomic_load_n(&export_running, __ATOMIC_ACQUIRE)) {
+        if (poll(&listening, 1, EXPORT_POLL_MS) <= 0) continue;
+
+        int fd = accept(export_listen_fd, NULL, NULL);
+        if (fd < 0) continue;
+        export_answer(fd);
+        close(fd);
+    }
+    return NULL;
+}
+
+// =============================================================================
+// API PÚBLICA
+// =============================================================================
+
+MEMORY_API int memory_export_register_pool(const char* name, memory_pool_t* pool) {
+    return export_register(EXPORT_POOL, name, pool);
+}
+
+MEMORY_API int memory_export_register_client(const char* name, memory_client_t* client) {
+    return export_register(EXPORT_CLIENT, name, client);
+}
+
+MEMORY_API int memory_export_unregister(const void* object) {
+    if (!object) return MEMORY_ERROR_INVALID_PARAM;
+
+    pthread_mutex_lock(&export_mutex);
+    for (size_t i = 0; i < export_count; i++) {
+        if (export_entries[i].object == object) {
+            // Se conserva el orden de registro en la salida
+            memmove(&export_entries[i], &export_entries[i + 1], (export_count - i - 1) * sizeof(export_entry_t));
+            export_count--;
+            pthread_mutex_unlock(&export_mutex);
+            return MEMORY_SUCCESS;
+        }
+    }
+    pthread_mutex_unlock(&export_mutex);
+    return MEMORY_ERROR_INVALID_PARAM;
+}
+
+MEMORY_API size_t memory_export_render(memory_export_format_t format, char* buffer, size_t capacity) {
+    export_writer_t writer = {buffer, buffer ? capacity : 0, 0};
+
+    pthread_mutex_lock(&export_mutex);
+    if (format == MEMORY_EXPORT_JSON) export_json(&writer);
+    else export_prometheus(&writer);
+    pthread_mutex_unlock(&export_mutex);
+
+    if (writer.capacity && writer.length >= writer.capacity) buffer[writer.capacity - 1] = '\0';
+    return writer.length;
+}
+
+MEMORY_API int memory_export_serve(const char* socket_path) {
+    if (!socket_path || strlen(socket_path) >= sizeof(export_socket_path)) return MEMORY_ERROR_INVALID_PARAM;
+
+    pthread_mutex_lock(&export_server_mutex);
+    if (export_running) {
+        pthread_mutex_unlock(&export_server_mutex);
+        MEMORY_LOG(MEMORY_LOG_ERROR, "El exportador ya está sirviendo en %s", export_socket_path);
+        return MEMORY_ERROR_INVALID_PARAM;
+    }
+
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, socket_path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    unlink(socket_path);
+    if (fd < 0 || bind(fd, (struct sockaddr*)&address, sizeof(address)) != 0 || listen(fd, 16) != 0) {
+        if (fd >= 0) close(fd);
+        pthread_mutex_unlock(&export_server_mutex);
+        MEMORY_LOG(MEMORY_LOG_ERROR, "No se pudo escuchar en %s", socket_path);
+        return MEMORY_ERROR_INVALID_PARAM;
+    }
+
+    export_listen_fd = fd;
+    strcpy(export_socket_path, socket_path);
+    __atomic_store_n(&export_running, 1, __ATOMIC_RELEASE);
+    if (pthread_create(&export_server, NULL, export_server_main, NULL) != 0) {
+        export_running = 0;
+        close(fd);
+        unlink(socket_path);
+        export_listen_fd = -1;
+        pthread_mutex_unlock(&export_server_mutex);
+        return MEMORY_ERROR_OUT_OF_MEMORY;
+    }
+    pthread_mutex_unlock(&export_server_mutex);
+
+    MEMORY_LOG(MEMORY_LOG_INFO, "Métricas servidas en %s", socket_path);
+    return MEMORY_SUCCESS;
+}
+
+MEMORY_API void memory_export_stop(void) {
+    pthread_mutex_lock(&export_server_mutex);
+    if (!export_running) {
+        pthread_mutex_unlock(&export_server_mutex);
+        return;
+    }
+
+    __atomic_store_n(&export_running, 0, __ATOMIC_RELEASE);
+    pthread_join(export_server, NULL);
+    close(export_listen_fd);
+    unlink(export_socket_path);
+    export_listen_fd = -1;
+    pthread_mutex_unlock(&export_server_mutex);
+}
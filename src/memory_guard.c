@@ -0,0 +1,364 @@
+#include "memory_internal.h"
+#include "../include/memory_guard.h"
+#include "../include/memory_kernels.h"
+#include "../include/memory_trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <execinfo.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+// =============================================================================
+// REGIÓN DE HUECOS CON GUARDA
+// =============================================================================
+// Disposición: [guarda][hueco 0][guarda][hueco 1] ... [hueco n-1][guarda].
+// El hueco i ocupa la página 2i+1; las páginas pares son siempre PROT_NONE.
+// Los huecos libres esperan en una cola FIFO: el que se liberó hace más
+// tiempo se reutiliza primero, para que un uso tras liberar tenga la mayor
+// ventana posible de fallar.
+
+#define GUARD_MAX_FRAMES 16
+#define GUARD_SLACK_PATTERN 0xAC
+#define GUARD_REPORT_SIZE 512
+
+typedef enum {
+    GUARD_SLOT_EMPTY = 0,
+    GUARD_SLOT_USED = 1,
+    GUARD_SLOT_FREED = 2
+} guard_slot_state_t;
+
+typedef struct {
+    guard_slot_state_t state;
+    int client_id;
+    size_t size;
+    char* ptr;
+    pid_t alloc_thread;
+    pid_t free_thread;
+    int alloc_depth;
+    int free_depth;
+    void* alloc_frames[GUARD_MAX_FRAMES];
+    void* free_frames[GUARD_MAX_FRAMES];
+} guard_slot_t;
+
+// 0 = muestreo inactivo; los límites de la región permiten a free
+// reconocer un bloque muestreado con dos comparaciones
+size_t guard_sample_rate = 0;
+char* guard_region_start = NULL;
+char* guard_region_end = NULL;
+
+static pthread_mutex_t guard_mutex = PTHREAD_MUTEX_INITIALIZER;
+static size_t guard_page_size = 0;
+static size_t guard_slot_count = 0;
+static guard_slot_t* guard_slots = NULL;
+static size_t* guard_queue = NULL;
+static size_t guard_queue_head = 0;
+static size_t guard_queue_length = 0;
+static size_t guard_in_use = 0;
+static size_t guard_sampled = 0;
+static size_t guard_skipped = 0;
+static size_t guard_errors = 0;
+static struct sigaction guard_previous_action;
+
+static __thread int64_t guard_countdown = 0;
+static __thread uint64_t guard_rng = 0;
+
+static char* slot_page(size_t slot) {
+    return guard_region_start + (2 * slot + 1) * guard_page_size;
+}
+
+// Cuenta atrás uniforme en [1, 2 * rate - 1]: una muestra cada rate de media
+static int64_t guard_next_countdown(void) {
+    size_t rate = __atomic_load_n(&guard_sample_rate, __ATOMIC_RELAXED);
+    if (!guard_rng) guard_rng = (uint64_t)(uintptr_t)&guard_rng ^ memory_now_ns();
+    guard_rng ^= guard_rng << 13;
+    guard_rng ^= guard_rng >> 7;
+    guard_rng ^= guard_rng << 17;
+    return rate > 1 ? (int64_t)(1 + guard_rng % (2 * rate - 1)) : 1;
+}
+
+// La cuenta de un hilo nuevo se sortea en su primera asignación: empezar en
+// 0 muestrearía siempre la primera de cada hilo
+int guard_sample_tick(void) {
+    if (!guard_countdown) guard_countdown = guard_next_countdown();
+    if (--guard_countdown > 0) return 0;
+
+    guard_countdown = guard_next_countdown();
+    return 1;
+}
+
+// =============================================================================
+// REPORTES (también desde el manejador de señales: solo write y snprintf)
+// =============================================================================
+
+static void guard_write(const char* text) {
+    ssize_t written = write(STDERR_FILENO, text, strlen(text));
+    (void)written;
+}
+
+static void guard_report(const char* kind, const guard_slot_t* slot, const void* address) {
+    char line[GUARD_REPORT_SIZE];
+    __atomic_add_fetch(&guard_errors, 1, __ATOMIC_RELAXED);
+
+    snprintf(line, sizeof(line), "\n=== memory_guard: %s en %p ===\n", kind, address);
+    guard_write(line);
+    if (!slot) return;
+
+    long offset = (long)((const char*)address - slot->ptr);
+    snprintf(line, sizeof(line),
+             "Bloque de %zu bytes en %p del cliente %d (acceso en el desplazamiento %ld)\n",
+             slot->size, (void*)slot->ptr, slot->client_id, offset);
+    guard_write(line);
+
+    snprintf(line, sizeof(line), "Asignado por el hilo %d en:\n", (int)slot->alloc_thread);
+    guard_write(line);
+    backtrace_symbols_fd((void* const*)slot->alloc_frames, slot->alloc_depth, STDERR_FILENO);
+
+    if (slot->state == GUARD_SLOT_FREED) {
+        snprintf(line, sizeof(line), "Liberado por el hilo %d en:\n", (int)slot->free_thread);
+        guard_write(line);
+        backtrace_symbols_fd((void* const*)slot->free_frames, slot->free_depth, STDERR_FILENO);
+    }
+}
+
+// Hueco más cercano a una dirección que cae en una página de guarda
+static guard_slot_t* guard_nearest_slot(const char* address, size_t page_index) {
+    guard_slot_t* left = page_index >= 2 ? &guard_slots[page_index / 2 - 1] : NULL;
+    guard_slot_t* right = page_index / 2 < guard_slot_count ? &guard_slots[page_index / 2] : NULL;
+    if (left && left->state == GUARD_SLOT_EMPTY) left = NULL;
+    if (right && right->state == GUARD_SLOT_EMPTY) right = NULL;
+    if (!left || !right) return left ? left : right;
+
+    size_t left_distance = (size_t)(address - (left->ptr + left->size));
+    size_t right_distance = (size_t)(right->ptr - address);
+    return left_distance <= right_distance ? left : right;
+}
+
+static void guard_signal_handler(int signal_number, siginfo_t* info, void* context) {
+    char* address = info->si_addr;
+
+    if (address >= guard_region_start && address < guard_region_end) {
+        size_t page_index = (size_t)(address - guard_region_start) / guard_page_size;
+        if (page_index % 2 == 0) {
+            guard_slot_t* slot = guard_nearest_slot(address, page_index);
+            guard_report(slot && address < slot->ptr ? "desbordamiento por debajo" : "desbordamiento de búfer",
+                         slot, address);
+        } else {
+            guard_slot_t* slot = &guard_slots[(page_index - 1) / 2];
+            guard_report(slot->state == GUARD_SLOT_FREED ? "uso tras liberar" : "acceso inválido",
+                         slot, address);
+        }
+
+        // Al reintentar la instrucción el fallo se repite con el manejador previo
+        sigaction(SIGSEGV, &guard_previous_action, NULL);
+        return;
+    }
+
+    // Fallo ajeno: se delega en el manejador que hubiera antes
+    if (guard_previous_action.sa_flags & SA_SIGINFO) {
+        guard_previous_action.sa_sigaction(signal_number, info, context);
+    } else if (guard_previous_action.sa_handler == SIG_DFL) {
+        sigaction(SIGSEGV, &guard_previous_action, NULL);
+    } else if (guard_previous_action.sa_handler != SIG_IGN) {
+        guard_previous_action.sa_handler(signal_number);
+    }
+}
+
+// =============================================================================
+// INTERFAZ INTERNA (usada por memory_pool.c)
+// =============================================================================
+
+// NULL si el tamaño no cabe en una página o no queda hueco: la asignación
+// sigue entonces por el pool
+void* guard_alloc(size_t size, int client_id) {
+    if (size > guard_page_size) return NULL;
+
+    void* frames[GUARD_MAX_FRAMES];
+    int depth = backtrace(frames, GUARD_MAX_FRAMES);
+
+    pthread_mutex_lock(&guard_mutex);
+    if (!guard_queue_length) {
+        guard_skipped++;
+        pthread_mutex_unlock(&guard_mutex);
+        return NULL;
+    }
+    size_t index = guard_queue[guard_queue_head];
+    guard_queue_head = (guard_queue_head + 1) % guard_slot_count;
+    guard_queue_length--;
+    guard_in_use++;
+    guard_sampled++;
+    pthread_mutex_unlock(&guard_mutex);
+
+    // Sin poder abrir la página el hueco vuelve a la cola y asigna el pool
+    char* page = slot_page(index);
+    if (mprotect(page, guard_page_size, PROT_READ | PROT_WRITE) != 0) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "mprotect falló al abrir el hueco %zu: %s", index, strerror(errno));
+        pthread_mutex_lock(&guard_mutex);
+        guard_queue[(guard_queue_head + guard_queue_length) % guard_slot_count] = index;
+        guard_queue_length++;
+        guard_in_use--;
+        guard_sampled--;
+        guard_skipped++;
+        pthread_mutex_unlock(&guard_mutex);
+        return NULL;
+    }
+
+    // Al final de la página para que el primer byte desbordado caiga en la guarda
+    size_t aligned_size = ALIGN_SIZE(size);
+    char* ptr = page + guard_page_size - aligned_size;
+    memory_zero(ptr, size);
+    memset(ptr + size, GUARD_SLACK_PATTERN, aligned_size - size);
+
+    guard_slot_t* slot = &guard_slots[index];
+    slot->client_id = client_id;
+    slot->size = size;
+    slot->ptr = ptr;
+    slot->alloc_thread = (pid_t)syscall(SYS_gettid);
+    slot->alloc_depth = depth;
+    memcpy(slot->alloc_frames, frames, depth * sizeof(void*));
+    slot->free_depth = 0;
+    __atomic_store_n(&slot->state, GUARD_SLOT_USED, __ATOMIC_RELEASE);
+
+    MEMORY_LOG(MEMORY_LOG_DEBUG, "Cliente %d: asignación de %zu bytes muestreada en %p",
+               client_id, size, (void*)ptr);
+    return ptr;
+}
+
+int guard_free(void* ptr, int client_id) {
+    char* address = ptr;
+    size_t page_index = (size_t)(address - guard_region_start) / guard_page_size;
+    guard_slot_t* slot = page_index % 2 ? &guard_slots[(page_index - 1) / 2] : NULL;
+
+    if (!slot || slot->ptr != address || slot->state != GUARD_SLOT_USED) {
+        guard_report(slot && slot->ptr == address && slot->state == GUARD_SLOT_FREED ?
+                     "doble liberación" : "liberación de puntero inválido", slot, ptr);
+        return MEMORY_ERROR_CORRUPTION;
+    }
+
+    if (slot->client_id != client_id) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "Cliente %d intentó liberar bloque del cliente %d",
+                   client_id, slot->client_id);
+        return MEMORY_ERROR_CLIENT_INVALID;
+    }
+
+    // Escrituras pequeñas tras el final que no llegaron a la guarda
+    size_t aligned_size = ALIGN_SIZE(slot->size);
+    for (size_t i = slot->size; i < aligned_size; i++) {
+        if ((unsigned char)address[i] != GUARD_SLACK_PATTERN) {
+            guard_report("desbordamiento de búfer", slot, address + i);
+            break;
+        }
+    }
+
+    // Validado: la traza se emite antes de que el hueco vuelva a la cola
+    if (__atomic_load_n(&trace_active, __ATOMIC_RELAXED)) {
+        trace_record(MEMORY_TRACE_FREE, ptr, NULL, 0, client_id);
+    }
+
+    slot->free_thread = (pid_t)syscall(SYS_gettid);
+    slot->free_depth = backtrace(slot->free_frames, GUARD_MAX_FRAMES);
+    __atomic_store_n(&slot->state, GUARD_SLOT_FREED, __ATOMIC_RELEASE);
+    if (mprotect(slot_page((size_t)(slot - guard_slots)), guard_page_size, PROT_NONE) != 0) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "mprotect falló al cerrar el hueco de %p: %s; "
+                   "un uso tras liberar no se detectará", ptr, strerror(errno));
+    }
+
+    pthread_mutex_lock(&guard_mutex);
+    guard_queue[(guard_queue_head + guard_queue_length) % guard_slot_count] = (size_t)(slot - guard_slots);
+    guard_queue_length++;
+    guard_in_use--;
+    pthread_mutex_unlock(&guard_mutex);
+    return MEMORY_SUCCESS;
+}
+
+size_t guard_usable_size(const void* ptr) {
+    size_t page_index = (size_t)((const char*)ptr - guard_region_start) / guard_page_size;
+    if (page_index % 2 == 0) return 0;
+
+    const guard_slot_t* slot = &guard_slots[(page_index - 1) / 2];
+    return slot->state == GUARD_SLOT_USED && slot->ptr == ptr ? slot->size : 0;
+}
+
+// =============================================================================
+// API PÚBLICA
+// =============================================================================
+
+static int guard_reserve(size_t slots) {
+    guard_page_size = (size_t)sysconf(_SC_PAGESIZE);
+    size_t region_size = (2 * slots + 1) * guard_page_size;
+
+    char* region = mmap(NULL, region_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    guard_slots = calloc(slots, sizeof(guard_slot_t));
+    guard_queue = malloc(slots * sizeof(size_t));
+    if (region == MAP_FAILED || !guard_slots || !guard_queue) {
+        if (region != MAP_FAILED) munmap(region, region_size);
+        free(guard_slots);
+        free(guard_queue);
+        guard_slots = NULL;
+        guard_queue = NULL;
+        return MEMORY_ERROR_OUT_OF_MEMORY;
+    }
+
+    for (size_t i = 0; i < slots; i++) guard_queue[i] = i;
+    guard_queue_head = 0;
+    guard_queue_length = slots;
+    guard_slot_count = slots;
+    guard_region_end = region + region_size;
+    __atomic_store_n(&guard_region_start, region, __ATOMIC_RELEASE);
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_sigaction = guard_signal_handler;
+    action.sa_flags = SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGSEGV, &action, &guard_previous_action);
+    return MEMORY_SUCCESS;
+}
+
+MEMORY_API int memory_guard_start(size_t sample_rate, size_t slots) {
+    if (sample_rate == 0 || slots == 0) return MEMORY_ERROR_INVALID_PARAM;
+
+    pthread_mutex_lock(&guard_mutex);
+    if (!guard_region_start) {
+        // Primera llamada de backtrace fuera de los caminos de asignación
+        void* warmup[1];
+        backtrace(warmup, 1);
+
+        int result = guard_reserve(slots);
+        if (result != MEMORY_SUCCESS) {
+            pthread_mutex_unlock(&guard_mutex);
+            MEMORY_LOG(MEMORY_LOG_ERROR, "No se pudo reservar la región de guarda (%zu huecos)", slots);
+            return result;
+        }
+    }
+    __atomic_store_n(&guard_sample_rate, sample_rate, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&guard_mutex);
+
+    MEMORY_LOG(MEMORY_LOG_INFO, "Muestreo con guarda activo: 1 de cada %zu asignaciones, %zu huecos",
+               sample_rate, guard_slot_count);
+    return MEMORY_SUCCESS;
+}
+
+MEMORY_API void memory_guard_stop(void) {
+    __atomic_store_n(&guard_sample_rate, 0, __ATOMIC_RELEASE);
+}
+
+MEMORY_API int memory_guard_is_active(void) {
+    return __atomic_load_n(&guard_sample_rate, __ATOMIC_RELAXED) != 0;
+}
+
+MEMORY_API void memory_guard_get_stats(memory_guard_stats_t* stats) {
+    if (!stats) return;
+
+    pthread_mutex_lock(&guard_mutex);
+    stats->sample_rate = guard_sample_rate;
+    stats->slots = guard_slot_count;
+    stats->slots_in_use = guard_in_use;
+    stats->sampled_allocations = guard_sampled;
+    stats->skipped_allocations = guard_skipped;
+    stats->errors_detected = __atomic_load_n(&guard_errors, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&guard_mutex);
+}
@@ -0,0 +1,98 @@
+#include "memory_internal.h"
+#include "../include/memory_histogram.h"
+#include <string.h>
+
+#define HALF_SUB_BUCKETS (MEMORY_HISTOGRAM_SUB_BUCKETS / 2)
+
+// Índice de cubeta: magnitud k (desplazamiento) y sub-cubeta v >> k
+static size_t histogram_index(uint64_t value) {
+    if (value < MEMORY_HISTOGRAM_SUB_BUCKETS) return (size_t)value;
+
+    int magnitude = 63 - __builtin_clzll(value) - MEMORY_HISTOGRAM_SUB_BUCKET_BITS + 1;
+    size_t index = (size_t)magnitude * HALF_SUB_BUCKETS + (size_t)(value >> magnitude);
+    return index < MEMORY_HISTOGRAM_BUCKETS ? index : MEMORY_HISTOGRAM_BUCKETS - 1;
+}
+
+// Mayor valor representado por una cubeta
+static uint64_t histogram_bucket_value(size_t index) {
+    if (index < MEMORY_HISTOGRAM_SUB_BUCKETS) return index;
+
+    size_t magnitude = index / HALF_SUB_BUCKETS - 1;
+    uint64_t sub_bucket = index - magnitude * HALF_SUB_BUCKETS;
+    return ((sub_bucket + 1) << magnitude) - 1;
+}
+
+MEMORY_API void memory_histogram_reset(memory_histogram_t* histogram) {
+    if (!histogram) return;
+    memset(histogram, 0, sizeof(memory_histogram_t));
+    histogram->min = UINT64_MAX;
+}
+
+MEMORY_API void memory_histogram_record(memory_histogram_t* histogram, uint64_t value) {
+    if (!histogram) return;
+
+    __atomic_fetch_add(&histogram->counts[histogram_index(value)], 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&histogram->total_count, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&histogram->sum, value, __ATOMIC_RELAXED);
+
+    uint64_t current = __atomic_load_n(&histogram->min, __ATOMIC_RELAXED);
+    while (value < current &&
+           !__atomic_compare_exchange_n(&histogram->min, &current, value, 1,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+
+    current = __atomic_load_n(&histogram->max, __ATOMIC_RELAXED);
+    while (value > current &&
+           !__atomic_compare_exchange_n(&histogram->max, &current, value, 1,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+MEMORY_API void memory_histogram_snapshot(const memory_histogram_t* histogram, memory_histogram_t* out) {
+    if (!histogram || !out) return;
+
+    for (size_t i = 0; i < MEMORY_HISTOGRAM_BUCKETS; i++) {
+        out->counts[i] = __atomic_load_n(&histogram->counts[i], __ATOMIC_RELAXED);
+    }
+    out->total_count = __atomic_load_n(&histogram->total_count, __ATOMIC_RELAXED);
+    out->sum = __atomic_load_n(&histogram->sum, __ATOMIC_RELAXED);
+    out->min = __atomic_load_n(&histogram->min, __ATOMIC_RELAXED);
+    out->max = __atomic_load_n(&histogram->max, __ATOMIC_RELAXED);
+}
+
+MEMORY_API void memory_histogram_merge(memory_histogram_t* dst, const memory_histogram_t* src) {
+    if (!dst || !src) return;
+
+    for (size_t i = 0; i < MEMORY_HISTOGRAM_BUCKETS; i++) {
+        dst->counts[i] += src->counts[i];
+    }
+    dst->total_count += src->total_count;
+    dst->sum += src->sum;
+    if (src->min < dst->min) dst->min = src->min;
+    if (src->max > dst->max) dst->max = src->max;
+}
+
+MEMORY_API uint64_t memory_histogram_percentile(const memory_histogram_t* histogram, double percentile) {
+    if (!histogram || histogram->total_count == 0) return 0;
+
+    if (percentile < 0.0) percentile = 0.0;
+    if (percentile > 100.0) percentile = 100.0;
+
+    uint64_t target = (uint64_t)((percentile / 100.0) * (double)histogram->total_count + 0.5);
+    if (target == 0) target = 1;
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < MEMORY_HISTOGRAM_BUCKETS; i++) {
+        seen += histogram->counts[i];
+        if (seen >= target) {
+            uint64_t value = histogram_bucket_value(i);
+            return value < histogram->max ? value : histogram->max;
+        }
+    }
+    return histogram->max;
+}
+
+MEMORY_API double memory_histogram_mean(const memory_histogram_t* histogram) {
+    if (!histogram || histogram->total_count == 0) return 0.0;
+    return (double)histogram->sum / (double)histogram->total_count;
+}
@@ -1,47 +1,339 @@
 #ifndef MEMORY_INTERNAL_H
 #define MEMORY_INTERNAL_H
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include "../include/memory_config.h"
 #include "../include/memory_pool.h"
 #include "../include/memory_client.h"
 #include "../include/memory_metrics.h"
 
 #include <pthread.h>
+#include <time.h>
+
+// Desplazamiento nulo para enlaces de la lista libre
+#define BLOCK_OFFSET_NULL ((size_t)-1)
+
+// Número de clases de la lista libre segregada (una por potencia de dos)
+#define FREE_LIST_CLASSES 64
 
 // Estructura del header de bloque (interna)
+// Los enlaces next/prev son desplazamientos desde memory_block para que el
+// heap sea independiente de la dirección en que se mapea (pools persistentes).
+// Su tamaño es múltiplo de MEMORY_ALIGNMENT para que los datos que le siguen
+// queden alineados también con alineaciones mayores que 8.
 typedef struct block_header {
-    size_t size;
-    struct block_header* next;
-    struct block_header* prev;
+    _Alignas(MEMORY_ALIGNMENT) size_t size;
+    size_t next;
+    size_t prev;
     uint8_t used;
+    uint8_t flags;
     uint32_t magic;
     int client_id;
 } block_header_t;
 
+// Bits de block_header_t.flags (se limpian al volver a la lista libre)
+#define BLOCK_FLAG_SAMPLED 0x01     // asignación registrada por el perfilador
+
+// Histogramas de latencia del pool (alloc/free por estrategia, espera de lock)
+typedef struct {
+    memory_histogram_t alloc[ALLOC_STRATEGY_COUNT];
+    memory_histogram_t free[ALLOC_STRATEGY_COUNT];
+    memory_histogram_t lock_wait;
+} pool_latency_t;
+
+// Estado de ALLOC_ADAPTIVE: contadores de la ventana en curso y coste
+// estimado de cada estrategia concreta (se actualiza con el mutex del pool y
+// dentro de la sección de escritura de métricas)
+typedef struct {
+    size_t window_allocations;
+    size_t window_start_steps;      // search_steps al abrir la ventana
+    size_t window_splits;
+    size_t window_failures;
+
+    size_t windows;
+    size_t switches;
+    size_t explorations;
+    int exploring;
+    double cost[ALLOC_STRATEGY_COUNT];
+    size_t measured[ALLOC_STRATEGY_COUNT];
+    size_t last_window[ALLOC_STRATEGY_COUNT];
+
+    double search_length;
+    double split_rate;
+    double fragmentation;
+    double failure_rate;
+} pool_adaptive_t;
+
+// Origen de la memoria del pool
+typedef enum {
+    POOL_BACKING_HEAP = 0,
+    POOL_BACKING_FILE = 1,
+    POOL_BACKING_MMAP = 2       // reserva anónima MAP_NORESERVE (creación perezosa)
+} pool_backing_t;
+
 // Estructura completa del pool (interna)
 struct memory_pool {
     void* memory_block;
     size_t total_size;
-    block_header_t* free_list;
-    alloc_strategy_t strategy;
+    block_header_t* free_lists[FREE_LIST_CLASSES];
+    uint64_t free_class_mask;
+    alloc_strategy_t strategy;      // siempre una estrategia concreta
     block_header_t* next_fit;
+    pool_adaptive_t* adaptive;      // no NULL con ALLOC_ADAPTIVE
+    pool_adaptive_t* adaptive_state; // reserva de adaptive; vive hasta pool_fini
     pthread_mutex_t mutex;
-    pool_metrics_t metrics;
+    int unsynchronized;             // MEMORY_POOL_FLAG_UNSYNCHRONIZED: sin mutex
+    const void* owner;              // hilo dueño de un pool sin sincronizar
     int active;
+
+    // Métricas mantenidas incrementalmente bajo el mutex y publicadas con un
+    // seqlock: los lectores no bloquean a los hilos que asignan.
+    pool_metrics_t metrics;
+    unsigned metrics_seq;
+    int largest_free_count;
+    size_t free_class_blocks[FREE_LIST_CLASSES];
+    size_t free_class_bytes[FREE_LIST_CLASSES];
+
+    // Coste de las operaciones: búsquedas, divisiones, fusiones, bytes
+    // limpiados y tomas del mutex (ver COST_ADD)
+    pool_cost_counters_t costs;
+
+    pool_latency_t* latency;
+
+    // Desde este desplazamiento el heap no se ha escrito nunca y ya está a
+    // cero: las asignaciones no necesitan limpiarlo
+    size_t zero_frontier;
+
+    // Respaldo de memoria (heap, reserva anónima o archivo mapeado)
+    pool_backing_t backing;
+    int fd;
+    void* mapping;
+    size_t mapping_size;
+
+    // No NULL si el pool es la vista de un grupo: alloc/free se delegan en
+    // los pools de cada clase y memory_block queda vacío
+    struct memory_pool_group* group;
+
+    // Verificador incremental: desplazamiento del próximo header a revisar
+    // (block_retire lo corrige al fusionar) y estado creado al primer uso
+    size_t verify_cursor;
+    struct pool_verify* verify;
+
+    // Cola de hilos que esperan memoria y eventfd; se crea al primer uso
+    struct pool_wait* waits;
 };
 
+// Tramo del pool reservado como sub-heap privado de un cliente
+typedef struct client_span client_span_t;
+
 // Estructura completa del cliente (interna)
 struct memory_client {
     int id;
     memory_pool_t* pool;
     void* allocated_blocks;
     pthread_mutex_t mutex;
+
+    // Sub-heap privado: asignaciones pequeñas sin locks (un único hilo dueño)
+    unsigned flags;
+    const void* owner;              // hilo dueño con MEMORY_CLIENT_FLAG_UNSYNCHRONIZED
+    size_t span_size;
+    client_span_t* spans;
+    client_span_t* active_span;
+    size_t subheap_live;
 };
 
+// Clase de tamaño de un bloque libre: floor(log2(size))
+static inline int size_class(size_t size) {
+    return size ? FREE_LIST_CLASSES - 1 - __builtin_clzll((unsigned long long)size) : 0;
+}
+
+// Escritura de métricas (solo con el mutex del pool tomado). Las lecturas
+// concurrentes usan pool_metrics_snapshot.
+#define METRIC_SET(pool, field, value) \
+    __atomic_store_n(&(pool)->metrics.field, (value), __ATOMIC_RELAXED)
+#define METRIC_ADD(pool, field, delta) METRIC_SET(pool, field, (pool)->metrics.field + (delta))
+#define METRIC_SUB(pool, field, delta) METRIC_SET(pool, field, (pool)->metrics.field - (delta))
+
+// Contadores por clase de la lista libre (mismas reglas que METRIC_*)
+#define CLASS_METRIC_ADD(pool, array, cls, delta) \
+    __atomic_store_n(&(pool)->array[(cls)], (pool)->array[(cls)] + (delta), __ATOMIC_RELAXED)
+
+// Los contadores de coste los escribe quien tiene el mutex; cada uno se lee
+// con una carga relajada, sin seqlock (son monótonos e independientes)
+#define COST_ADD(pool, field, delta) \
+    __atomic_store_n(&(pool)->costs.field, (pool)->costs.field + (delta), __ATOMIC_RELAXED)
+
+static inline void metrics_write_begin(memory_pool_t* pool) {
+    __atomic_store_n(&pool->metrics_seq, pool->metrics_seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static inline void metrics_write_end(memory_pool_t* pool) {
+    __atomic_store_n(&pool->metrics_seq, pool->metrics_seq + 1, __ATOMIC_RELEASE);
+}
+
+// Reloj monotónico para medir latencias
+static inline uint64_t memory_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * UINT64_C(1000000000) + (uint64_t)ts.tv_nsec;
+}
+
+#if MEMORY_LATENCY_HISTOGRAMS
+#define LATENCY_START() memory_now_ns()
+#define LATENCY_RECORD(pool, kind, strategy, start) \
+    memory_histogram_record(&(pool)->latency->kind[(strategy)], memory_now_ns() - (start))
+#else
+#define LATENCY_START() 0
+#define LATENCY_RECORD(pool, kind, strategy, start) ((void)(start))
+#endif
+
+// Identifica al hilo actual: la dirección de una variable por hilo
+extern __thread char memory_thread_token;
+extern void owner_violation(const char* what);
+
+// Dueño de un pool o cliente sin sincronizar: lo reclama el primer hilo que
+// lo usa. Solo se comprueba con MEMORY_DEBUG; en producción no cuesta nada.
+static inline void owner_check(const void** owner, const char* what) {
+#ifdef MEMORY_DEBUG
+    const void* self = &memory_thread_token;
+    const void* expected = NULL;
+    if (!__atomic_compare_exchange_n(owner, &expected, self, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED) &&
+        expected != self) {
+        owner_violation(what);
+    }
+#else
+    (void)owner;
+    (void)what;
+#endif
+}
+
+// Toma del mutex del pool; la espera solo se mide si el lock está ocupado.
+// Un pool sin sincronizar no tiene nada que tomar.
+static inline void pool_lock(memory_pool_t* pool) {
+    if (pool->unsynchronized) {
+        owner_check(&pool->owner, "Pool");
+        return;
+    }
+    if (pthread_mutex_trylock(&pool->mutex) == 0) {
+#if MEMORY_LATENCY_HISTOGRAMS
+        memory_histogram_record(&pool->latency->lock_wait, 0);
+#endif
+    } else {
+#if MEMORY_LATENCY_HISTOGRAMS
+        uint64_t start = memory_now_ns();
+        pthread_mutex_lock(&pool->mutex);
+        memory_histogram_record(&pool->latency->lock_wait, memory_now_ns() - start);
+#else
+        pthread_mutex_lock(&pool->mutex);
+#endif
+        COST_ADD(pool, lock_contended, 1);
+    }
+    COST_ADD(pool, lock_acquisitions, 1);
+}
+
+static inline void pool_unlock(memory_pool_t* pool) {
+    if (pool->unsynchronized) return;
+    pthread_mutex_unlock(&pool->mutex);
+}
+
+// Conversión entre desplazamientos y headers
+static inline block_header_t* block_from_offset(const memory_pool_t* pool, size_t offset) {
+    if (offset == BLOCK_OFFSET_NULL) return NULL;
+    return (block_header_t*)((char*)pool->memory_block + offset);
+}
+
+static inline size_t block_to_offset(const memory_pool_t* pool, const block_header_t* block) {
+    if (!block) return BLOCK_OFFSET_NULL;
+    return (size_t)((const char*)block - (const char*)pool->memory_block);
+}
+
+static inline block_header_t* block_get_next(const memory_pool_t* pool, const block_header_t* block) {
+    return block_from_offset(pool, block->next);
+}
+
+static inline block_header_t* block_get_prev(const memory_pool_t* pool, const block_header_t* block) {
+    return block_from_offset(pool, block->prev);
+}
+
+// Invalida el header de un bloque absorbido por survivor en una fusión; si el
+// verificador incremental iba a continuar por él, continúa por survivor
+static inline void block_retire(memory_pool_t* pool, block_header_t* dead, block_header_t* survivor) {
+    dead->magic = 0;
+    if (pool->verify_cursor == block_to_offset(pool, dead)) {
+        pool->verify_cursor = block_to_offset(pool, survivor);
+    }
+}
+
 // Funciones internas (no exportadas)
 extern int block_is_valid(const block_header_t* block);
 extern int block_in_pool(const memory_pool_t* pool, const block_header_t* block);
 extern void add_to_free_list(memory_pool_t* pool, block_header_t* block);
-extern void memory_log_internal(memory_log_level_t level, const char* file, int line, const char* format, ...);
+extern int pool_init(memory_pool_t* pool, void* memory, size_t total_size, alloc_strategy_t strategy);
+extern void pool_fini(memory_pool_t* pool);
+extern void pool_init_first_block(memory_pool_t* pool);
+extern size_t pool_rebuild_free_list(memory_pool_t* pool);
+extern void pool_metrics_snapshot(const memory_pool_t* pool, pool_metrics_t* metrics);
+extern void pool_reset_counters(memory_pool_t* pool);
+extern void persist_close(memory_pool_t* pool);
+extern void* pool_group_alloc(memory_pool_t* view, size_t size, int client_id);
+extern int pool_group_free(memory_pool_t* view, void* ptr, int client_id);
+extern size_t pool_group_free_bulk(memory_pool_t* view, void* const* ptrs, size_t count, int client_id);
+extern memory_pool_t* pool_group_member(const memory_pool_t* view, size_t index);
+extern void* pool_group_realloc(memory_pool_t* view, void* ptr, size_t size, int client_id);
+extern void* pool_group_alloc_aligned(memory_pool_t* view, size_t alignment, size_t size, int client_id);
+extern size_t pool_group_usable_size(const memory_pool_t* view, const void* ptr);
+extern void pool_group_destroy_view(memory_pool_t* view);
+extern void pool_verify_release(memory_pool_t* pool);
+extern void export_forget(const void* object);
+extern pool_adaptive_t* adaptive_create(void);
+extern void adaptive_account(memory_pool_t* pool, int failed, int split);
+// Tamaño redondeado a líneas de caché completas (colocación afín)
+static inline size_t affine_size(size_t size) {
+    return (size + MEMORY_CACHE_LINE - 1) & ~(size_t)(MEMORY_CACHE_LINE - 1);
+}
+
+// Espera de memoria (memory_wait.c): attempt asigna sin esperar
+extern void* pool_alloc_wait(memory_pool_t* pool, size_t size, long timeout_ms,
+                             void* (*attempt)(void* context, size_t size), void* context);
+extern void* pool_alloc_async(memory_pool_t* pool, size_t size,
+                              void* (*attempt)(void* context, size_t size), void* context);
+extern void pool_wait_notify(memory_pool_t* pool);
+extern void pool_wait_release(memory_pool_t* pool);
+
+// Tras liberar memoria: sin nadie esperando cuesta una carga
+static inline void pool_release_notify(memory_pool_t* pool) {
+    if (__atomic_load_n(&pool->waits, __ATOMIC_ACQUIRE)) pool_wait_notify(pool);
+}
+
+extern int subheap_enable(memory_client_t* client, size_t span_size);
+extern void* subheap_alloc(memory_client_t* client, size_t size);
+extern int subheap_free(memory_client_t* client, void* ptr);
+extern void subheap_release_all(memory_client_t* client);
+extern size_t profiler_interval;
+extern int profiler_sample_tick(size_t size);
+extern void profiler_record_alloc(void* ptr, size_t size, int client_id);
+extern void profiler_record_free(void* ptr);
+extern int trace_active;
+extern void trace_record(uint8_t type, const void* address, const void* old_address,
+                         size_t size, int client_id);
+extern size_t guard_sample_rate;
+extern char* guard_region_start;
+extern char* guard_region_end;
+extern int guard_sample_tick(void);
+extern void* guard_alloc(size_t size, int client_id);
+extern int guard_free(void* ptr, int client_id);
+extern size_t guard_usable_size(const void* ptr);
+extern int memory_log_threshold;
+extern void memory_log_internal(memory_log_level_t level, const char* file, int line, const char* format, ...)
+    __attribute__((format(printf, 4, 5)));
+
+// Bloque servido por el asignador de muestreo con guarda
+static inline int guard_owns(const void* ptr) {
+    return (const char*)ptr >= guard_region_start && (const char*)ptr < guard_region_end;
+}
 
 #endif // MEMORY_INTERNAL_H
@@ -0,0 +1,268 @@
+#include "memory_internal.h"
+#include "../include/memory_kernels.h"
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define KERNELS_X86 1
+#else
+#define KERNELS_X86 0
+#endif
+
+// =============================================================================
+// NÚCLEOS
+// =============================================================================
+// Por debajo del umbral de streaming se usa memset/memcpy: la libc ya elige
+// su propia variante vectorial con stores normales y las nuestras no la
+// mejoraban (ver benchmark_kernels). Por encima, cada variante alinea el
+// destino con la libc, escribe el cuerpo en bloques de cuatro vectores con
+// stores no temporales (van a memoria sin pasar por la caché) y termina con
+// un sfence para que el bloque sea visible antes de devolverlo.
+
+#define KERNEL_MIN_SIZE 256         // el alineamiento y la cola caben de sobra
+
+typedef void (*zero_kernel_t)(void* dst, size_t size);
+typedef void (*copy_kernel_t)(void* dst, const void* src, size_t size);
+
+// Sin stores no temporales portables: la variante genérica es la libc
+static void zero_generic(void* dst, size_t size) {
+    memset(dst, 0, size);
+}
+
+static void copy_generic(void* dst, const void* src, size_t size) {
+    memcpy(dst, src, size);
+}
+
+#if KERNELS_X86
+
+__attribute__((target("sse2")))
+static void zero_sse2(void* dst, size_t size) {
+    char* p = dst;
+    size_t head = (size_t)(-(uintptr_t)p & 15);
+    memset(p, 0, head);
+    p += head;
+    size -= head;
+
+    char* end = p + (size & ~(size_t)63);
+    const __m128i zero = _mm_setzero_si128();
+    for (; p < end; p += 64) {
+        _mm_stream_si128((__m128i*)p, zero);
+        _mm_stream_si128((__m128i*)(p + 16), zero);
+        _mm_stream_si128((__m128i*)(p + 32), zero);
+        _mm_stream_si128((__m128i*)(p + 48), zero);
+    }
+    _mm_sfence();
+    memset(p, 0, size & 63);
+}
+
+__attribute__((target("sse2")))
+static void copy_sse2(void* dst, const void* src, size_t size) {
+    char* d = dst;
+    const char* s = src;
+    size_t head = (size_t)(-(uintptr_t)d & 15);
+    memcpy(d, s, head);
+    d += head;
+    s += head;
+    size -= head;
+
+    char* end = d + (size & ~(size_t)63);
+    for (; d < end; d += 64, s += 64) {
+        __m128i v0 = _mm_loadu_si128((const __m128i*)s);
+        __m128i v1 = _mm_loadu_si128((const __m128i*)(s + 16));
+        __m128i v2 = _mm_loadu_si128((const __m128i*)(s + 32));
+        __m128i v3 = _mm_loadu_si128((const __m128i*)(s + 48));
+        _mm_stream_si128((__m128i*)d, v0);
+        _mm_stream_si128((__m128i*)(d + 16), v1);
+        _mm_stream_si128((__m128i*)(d + 32), v2);
+        _mm_stream_si128((__m128i*)(d + 48), v3);
+    }
+    _mm_sfence();
+    memcpy(d, s, size & 63);
+}
+
+__attribute__((target("avx2")))
+static void zero_avx2(void* dst, size_t size) {
+    char* p = dst;
+    size_t head = (size_t)(-(uintptr_t)p & 31);
+    memset(p, 0, head);
+    p += head;
+    size -= head;
+
+    char* end = p + (size & ~(size_t)127);
+    const __m256i zero = _mm256_setzero_si256();
+    for (; p < end; p += 128) {
+        _mm256_stream_si256((__m256i*)p, zero);
+        _mm256_stream_si256((__m256i*)(p + 32), zero);
+        _mm256_stream_si256((__m256i*)(p + 64), zero);
+        _mm256_stream_si256((__m256i*)(p + 96), zero);
+    }
+    _mm_sfence();
+    _mm256_zeroupper();
+    memset(p, 0, size & 127);
+}
+
+__attribute__((target("avx2")))
+static void copy_avx2(void* dst, const void* src, size_t size) {
+    char* d = dst;
+    const char* s = src;
+    size_t head = (size_t)(-(uintptr_t)d & 31);
+    memcpy(d, s, head);
+    d += head;
+    s += head;
+    size -= head;
+
+    char* end = d + (size & ~(size_t)127);
+    for (; d < end; d += 128, s += 128) {
+        __m256i v0 = _mm256_loadu_si256((const __m256i*)s);
+        __m256i v1 = _mm256_loadu_si256((const __m256i*)(s + 32));
+        __m256i v2 = _mm256_loadu_si256((const __m256i*)(s + 64));
+        __m256i v3 = _mm256_loadu_si256((const __m256i*)(s + 96));
+        _mm256_stream_si256((__m256i*)d, v0);
+        _mm256_stream_si256((__m256i*)(d + 32), v1);
+        _mm256_stream_si256((__m256i*)(d + 64), v2);
+        _mm256_stream_si256((__m256i*)(d + 96), v3);
+    }
+    _mm_sfence();
+    _mm256_zeroupper();
+    memcpy(d, s, size & 127);
+}
+
+__attribute__((target("avx512f")))
+static void zero_avx512(void* dst, size_t size) {
+    char* p = dst;
+    size_t head = (size_t)(-(uintptr_t)p & 63);
+    memset(p, 0, head);
+    p += head;
+    size -= head;
+
+    char* end = p + (size & ~(size_t)255);
+    const __m512i zero = _mm512_setzero_si512();
+    for (; p < end; p += 256) {
+        _mm512_stream_si512((__m512i*)p, zero);
+        _mm512_stream_si512((__m512i*)(p + 64), zero);
+        _mm512_stream_si512((__m512i*)(p + 128), zero);
+        _mm512_stream_si512((__m512i*)(p + 192), zero);
+    }
+    _mm_sfence();
+    _mm256_zeroupper();
+    memset(p, 0, size & 255);
+}
+
+__attribute__((target("avx512f")))
+static void copy_avx512(void* dst, const void* src, size_t size) {
+    char* d = dst;
+    const char* s = src;
+    size_t head = (size_t)(-(uintptr_t)d & 63);
+    memcpy(d, s, head);
+    d += head;
+    s += head;
+    size -= head;
+
+    char* end = d + (size & ~(size_t)255);
+    for (; d < end; d += 256, s += 256) {
+        __m512i v0 = _mm512_loadu_si512(s);
+        __m512i v1 = _mm512_loadu_si512(s + 64);
+        __m512i v2 = _mm512_loadu_si512(s + 128);
+        __m512i v3 = _mm512_loadu_si512(s + 192);
+        _mm512_stream_si512((__m512i*)d, v0);
+        _mm512_stream_si512((__m512i*)(d + 64), v1);
+        _mm512_stream_si512((__m512i*)(d + 128), v2);
+        _mm512_stream_si512((__m512i*)(d + 192), v3);
+    }
+    _mm_sfence();
+    _mm256_zeroupper();
+    memcpy(d, s, size & 255);
+}
+
+#endif
+
+// =============================================================================
+// SELECCIÓN
+// =============================================================================
+
+static const struct {
+    const char* name;
+    zero_kernel_t zero;
+    copy_kernel_t copy;
+} kernel_table[MEMORY_KERNEL_ISA_COUNT] = {
+    {"generic", zero_generic, copy_generic},
+#if KERNELS_X86
+    {"sse2", zero_sse2, copy_sse2},
+    {"avx2", zero_avx2, copy_avx2},
+    {"avx512", zero_avx512, copy_avx512},
+#else
+    {"sse2", NULL, NULL},
+    {"avx2", NULL, NULL},
+    {"avx512", NULL, NULL},
+#endif
+};
+
+static int kernel_isa = -1;                 // -1 hasta el primer uso
+static size_t kernel_streaming_threshold = MEMORY_STREAMING_THRESHOLD;
+
+MEMORY_API int memory_kernels_isa_supported(memory_kernel_isa_t isa) {
+    switch (isa) {
+        case MEMORY_KERNEL_GENERIC: return 1;
+#if KERNELS_X86
+        // cpuid, y XGETBV para saber si el sistema guarda los registros anchos
+        case MEMORY_KERNEL_SSE2: __builtin_cpu_init(); return __builtin_cpu_supports("sse2") != 0;
+        case MEMORY_KERNEL_AVX2: __builtin_cpu_init(); return __builtin_cpu_supports("avx2") != 0;
+        case MEMORY_KERNEL_AVX512: __builtin_cpu_init(); return __builtin_cpu_supports("avx512f") != 0;
+#endif
+        default: return 0;
+    }
+}
+
+static memory_kernel_isa_t kernels_resolve(void) {
+    int isa = __atomic_load_n(&kernel_isa, __ATOMIC_ACQUIRE);
+    if (isa >= 0) return (memory_kernel_isa_t)isa;
+
+    isa = MEMORY_KERNEL_ISA_COUNT - 1;
+    while (isa > MEMORY_KERNEL_GENERIC && !memory_kernels_isa_supported((memory_kernel_isa_t)isa)) isa--;
+
+    // Dos hilos pueden resolver a la vez: ambos llegan al mismo resultado
+    int expected = -1;
+    __atomic_compare_exchange_n(&kernel_isa, &expected, isa, 0, __ATOMIC_RELEASE, __ATOMIC_ACQUIRE);
+    return (memory_kernel_isa_t)__atomic_load_n(&kernel_isa, __ATOMIC_ACQUIRE);
+}
+
+static int kernels_stream(size_t size) {
+    return size >= KERNEL_MIN_SIZE && size >= __atomic_load_n(&kernel_streaming_threshold, __ATOMIC_RELAXED);
+}
+
+MEMORY_API void memory_zero(void* dst, size_t size) {
+    if (kernels_stream(size)) kernel_table[kernels_resolve()].zero(dst, size);
+    else memset(dst, 0, size);
+}
+
+MEMORY_API void memory_copy(void* dst, const void* src, size_t size) {
+    if (kernels_stream(size)) kernel_table[kernels_resolve()].copy(dst, src, size);
+    else memcpy(dst, src, size);
+}
+
+MEMORY_API memory_kernel_isa_t memory_kernels_get_isa(void) {
+    return kernels_resolve();
+}
+
+MEMORY_API const char* memory_kernels_isa_name(memory_kernel_isa_t isa) {
+    if ((unsigned)isa >= MEMORY_KERNEL_ISA_COUNT) return "desconocida";
+    return kernel_table[isa].name;
+}
+
+MEMORY_API int memory_kernels_set_isa(memory_kernel_isa_t isa) {
+    if ((unsigned)isa >= MEMORY_KERNEL_ISA_COUNT || !memory_kernels_isa_supported(isa)) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "Variante de núcleos no disponible: %d", isa);
+        return MEMORY_ERROR_INVALID_PARAM;
+    }
+    __atomic_store_n(&kernel_isa, (int)isa, __ATOMIC_RELEASE);
+    MEMORY_LOG(MEMORY_LOG_INFO, "Núcleos de memoria: %s", kernel_table[isa].name);
+    return MEMORY_SUCCESS;
+}
+
+MEMORY_API void memory_kernels_set_streaming_threshold(size_t bytes) {
+    __atomic_store_n(&kernel_streaming_threshold, bytes, __ATOMIC_RELAXED);
+}
+
+MEMORY_API size_t memory_kernels_get_streaming_threshold(void) {
+    return __atomic_load_n(&kernel_streaming_threshold, __ATOMIC_RELAXED);
+}
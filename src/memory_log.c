@@ -0,0 +1,264 @@
+#include "memory_internal.h"
+#include "../include/memory_log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#ifdef MEMORY_DEBUG
+int memory_log_threshold = MEMORY_LOG_DEBUG;
+#else
+int memory_log_threshold = MEMORY_LOG_OFF;
+#endif
+
+static const char* const log_level_names[] = {"DEBUG", "INFO", "WARN", "ERROR"};
+
+// =============================================================================
+// ANILLOS POR HILO
+// =============================================================================
+// Cada anillo tiene un único productor (el hilo dueño) y un único consumidor
+// (el volcador). El mensaje se formatea al registrarlo porque los argumentos
+// no sobreviven a la llamada; la marca de tiempo, el nivel y el origen se
+// formatean al volcar. Los anillos se reservan con mmap para no volver a
+// entrar en malloc (que puede ser el propio pool con LD_PRELOAD) y nunca se
+// liberan: al terminar un hilo su anillo queda libre para el siguiente.
+
+typedef struct {
+    uint64_t timestamp_ns;
+    const char* file;
+    int line;
+    int level;
+    char message[MEMORY_LOG_MESSAGE_SIZE];
+} log_record_t;
+
+typedef struct log_ring {
+    struct log_ring* next_ring;
+    int owned;
+    pid_t thread;
+    size_t mask;
+    size_t head;                    // solo lo avanza el productor
+    size_t tail;                    // solo lo avanza el volcador
+    log_record_t records[];
+} log_ring_t;
+
+static log_ring_t* log_rings = NULL;
+static __thread log_ring_t* log_thread_ring = NULL;
+static pthread_key_t log_ring_key;
+static pthread_once_t log_key_once = PTHREAD_ONCE_INIT;
+
+static pthread_mutex_t log_mutex = PTHREAD_MUTEX_INITIALIZER;
+static int log_async_active = 0;
+static int log_running = 0;
+static int log_writers = 0;
+static size_t log_ring_capacity = MEMORY_LOG_DEFAULT_RING;
+static FILE* log_file = NULL;
+static pthread_t log_drainer;
+static uint64_t log_start_ns = 0;
+
+static size_t log_written = 0;
+static size_t log_dropped = 0;
+static size_t log_ring_count = 0;
+
+static void log_ring_release(void* ring) {
+    __atomic_store_n(&((log_ring_t*)ring)->owned, 0, __ATOMIC_RELEASE);
+}
+
+static void log_key_create(void) {
+    pthread_key_create(&log_ring_key, log_ring_release);
+}
+
+static log_ring_t* log_thread_ring_get(void) {
+    if (log_thread_ring) return log_thread_ring;
+    pthread_once(&log_key_once, log_key_create);
+
+    log_ring_t* ring;
+    for (ring = __atomic_load_n(&log_rings, __ATOMIC_ACQUIRE); ring; ring = ring->next_ring) {
+        int expected = 0;
+        if (__atomic_compare_exchange_n(&ring->owned, &expected, 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) break;
+    }
+
+    if (!ring) {
+        size_t capacity = __atomic_load_n(&log_ring_capacity, __ATOMIC_RELAXED);
+        void* memory = mmap(NULL, sizeof(log_ring_t) + capacity * sizeof(log_record_t),
+                            PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) return NULL;
+
+        ring = memory;
+        ring->owned = 1;
+        ring->mask = capacity - 1;
+        ring->next_ring = __atomic_load_n(&log_rings, __ATOMIC_RELAXED);
+        while (!__atomic_compare_exchange_n(&log_rings, &ring->next_ring, ring, 1,
+                                            __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+        }
+        __atomic_add_fetch(&log_ring_count, 1, __ATOMIC_RELAXED);
+    }
+
+    ring->thread = (pid_t)syscall(SYS_gettid);
+    pthread_setspecific(log_ring_key, ring);
+    log_thread_ring = ring;
+    return ring;
+}
+
+// Devuelve 0 si el hilo no tiene anillo y el mensaje debe ir por la vía síncrona
+static int log_enqueue(memory_log_level_t level, const char* file, int line, const char* format, va_list args) {
+    log_ring_t* ring = log_thread_ring_get();
+    if (!ring) return 0;
+
+    size_t head = ring->head;
+    if (head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) > ring->mask) {
+        __atomic_add_fetch(&log_dropped, 1, __ATOMIC_RELAXED);
+        return 1;
+    }
+
+    log_record_t* record = &ring->records[head & ring->mask];
+    record->timestamp_ns = memory_now_ns();
+    record->file = file;
+    record->line = line;
+    record->level = level;
+    vsnprintf(record->message, sizeof(record->message), format, args);
+
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+    return 1;
+}
+
+void memory_log_internal(memory_log_level_t level, const char* file, int line, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+
+    if (__atomic_load_n(&log_async_active, __ATOMIC_ACQUIRE)) {
+        __atomic_add_fetch(&log_writers, 1, __ATOMIC_SEQ_CST);
+        int queued = __atomic_load_n(&log_async_active, __ATOMIC_SEQ_CST) &&
+                     log_enqueue(level, file, line, format, args);
+        __atomic_sub_fetch(&log_writers, 1, __ATOMIC_RELEASE);
+        if (queued) {
+            va_end(args);
+            return;
+        }
+    }
+
+    fprintf(stderr, "[MEMORY-%s] %s:%d: ", log_level_names[level], file, line);
+    vfprintf(stderr, format, args);
+    fprintf(stderr, "\n");
+    va_end(args);
+}
+
+// =============================================================================
+// VOLCADOR
+// =============================================================================
+
+static size_t log_drain(void) {
+    size_t drained = 0;
+
+    for (log_ring_t* ring = __atomic_load_n(&log_rings, __ATOMIC_ACQUIRE); ring; ring = ring->next_ring) {
+        size_t tail = ring->tail;
+        size_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+        for (; tail != head; tail++) {
+            const log_record_t* record = &ring->records[tail & ring->mask];
+            uint64_t elapsed = record->timestamp_ns - log_start_ns;
+            fprintf(log_file, "[%llu.%06llu] [MEMORY-%s] [hilo %d] %s:%d: %s\n",
+                    (unsigned long long)(elapsed / 1000000000),
+                    (unsigned long long)(elapsed % 1000000000 / 1000),
+                    log_level_names[record->level], (int)ring->thread,
+                    record->file, record->line, record->message);
+            drained++;
+        }
+        __atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+    }
+
+    if (drained) {
+        fflush(log_file);
+        __atomic_add_fetch(&log_written, drained, __ATOMIC_RELAXED);
+    }
+    return drained;
+}
+
+static void* log_drainer_main(void* arg) {
+    (void)arg;
+    const struct timespec pause = {0, 2 * 1000 * 1000};
+
+    while (__atomic_load_n(&log_running, __ATOMIC_ACQUIRE)) {
+        if (!log_drain()) nanosleep(&pause, NULL);
+    }
+    log_drain();
+    return NULL;
+}
+
+// =============================================================================
+// API PÚBLICA
+// =============================================================================
+
+MEMORY_API void memory_log_set_level(memory_log_level_t level) {
+    __atomic_store_n(&memory_log_threshold, (int)level, __ATOMIC_RELAXED);
+}
+
+MEMORY_API memory_log_level_t memory_log_get_level(void) {
+    return (memory_log_level_t)__atomic_load_n(&memory_log_threshold, __ATOMIC_RELAXED);
+}
+
+MEMORY_API int memory_log_start_async(const char* path, size_t ring_messages) {
+    pthread_mutex_lock(&log_mutex);
+    if (log_async_active) {
+        pthread_mutex_unlock(&log_mutex);
+        return MEMORY_ERROR_INVALID_PARAM;
+    }
+
+    // Capacidad redondeada a potencia de dos; solo afecta a los anillos nuevos
+    size_t capacity = 2;
+    size_t requested = ring_messages ? ring_messages : MEMORY_LOG_DEFAULT_RING;
+    while (capacity < requested) capacity <<= 1;
+    __atomic_store_n(&log_ring_capacity, capacity, __ATOMIC_RELAXED);
+
+    log_file = path ? fopen(path, "a") : stderr;
+    if (!log_file) {
+        pthread_mutex_unlock(&log_mutex);
+        return MEMORY_ERROR_INVALID_PARAM;
+    }
+
+    log_start_ns = memory_now_ns();
+    log_written = log_dropped = 0;
+    __atomic_store_n(&log_running, 1, __ATOMIC_RELEASE);
+    if (pthread_create(&log_drainer, NULL, log_drainer_main, NULL) != 0) {
+        if (log_file != stderr) fclose(log_file);
+        log_file = NULL;
+        log_running = 0;
+        pthread_mutex_unlock(&log_mutex);
+        return MEMORY_ERROR_OUT_OF_MEMORY;
+    }
+
+    __atomic_store_n(&log_async_active, 1, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&log_mutex);
+    return MEMORY_SUCCESS;
+}
+
+MEMORY_API int memory_log_stop_async(void) {
+    pthread_mutex_lock(&log_mutex);
+    if (!log_async_active) {
+        pthread_mutex_unlock(&log_mutex);
+        return MEMORY_ERROR_INVALID_PARAM;
+    }
+
+    // Sin escritores en curso el volcado final no pierde mensajes
+    __atomic_store_n(&log_async_active, 0, __ATOMIC_SEQ_CST);
+    while (__atomic_load_n(&log_writers, __ATOMIC_SEQ_CST)) sched_yield();
+
+    __atomic_store_n(&log_running, 0, __ATOMIC_RELEASE);
+    pthread_join(log_drainer, NULL);
+
+    int result = MEMORY_SUCCESS;
+    if (log_file != stderr && fclose(log_file) != 0) result = MEMORY_ERROR_CORRUPTION;
+    log_file = NULL;
+    pthread_mutex_unlock(&log_mutex);
+    return result;
+}
+
+MEMORY_API void memory_log_get_stats(memory_log_stats_t* stats) {
+    if (!stats) return;
+    stats->written_messages = __atomic_load_n(&log_written, __ATOMIC_RELAXED);
+    stats->dropped_messages = __atomic_load_n(&log_dropped, __ATOMIC_RELAXED);
+    stats->thread_rings = __atomic_load_n(&log_ring_count, __ATOMIC_RELAXED);
+}
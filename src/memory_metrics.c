@@ -3,11 +3,93 @@
 #include <stdio.h>
 #include <string.h>
 
+// Lectura consistente de los contadores sin tomar el mutex del pool (seqlock)
+void pool_metrics_snapshot(const memory_pool_t* pool, pool_metrics_t* metrics) {
+    unsigned seq_start, seq_end;
+
+    do {
+        seq_start = __atomic_load_n(&pool->metrics_seq, __ATOMIC_ACQUIRE);
+        if (seq_start & 1) continue; // escritura en curso
+
+        metrics->total_memory = __atomic_load_n(&pool->metrics.total_memory, __ATOMIC_RELAXED);
+        metrics->used_memory = __atomic_load_n(&pool->metrics.used_memory, __ATOMIC_RELAXED);
+        metrics->free_memory = __atomic_load_n(&pool->metrics.free_memory, __ATOMIC_RELAXED);
+        metrics->used_blocks = __atomic_load_n(&pool->metrics.used_blocks, __ATOMIC_RELAXED);
+        metrics->free_blocks = __atomic_load_n(&pool->metrics.free_blocks, __ATOMIC_RELAXED);
+        metrics->largest_free_block = __atomic_load_n(&pool->metrics.largest_free_block, __ATOMIC_RELAXED);
+        metrics->allocation_count = __atomic_load_n(&pool->metrics.allocation_count, __ATOMIC_RELAXED);
+        metrics->free_count = __atomic_load_n(&pool->metrics.free_count, __ATOMIC_RELAXED);
+        metrics->failed_allocations = __atomic_load_n(&pool->metrics.failed_allocations, __ATOMIC_RELAXED);
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        seq_end = __atomic_load_n(&pool->metrics_seq, __ATOMIC_RELAXED);
+    } while ((seq_start & 1) || seq_start != seq_end);
+
+    metrics->block_count = metrics->used_blocks + metrics->free_blocks;
+}
+
+static void compute_fragmentation(pool_metrics_t* metrics) {
+    if (metrics->free_blocks > 1 && metrics->free_memory > 0) {
+        double fragmentation = (1.0 - ((double)metrics->largest_free_block / metrics->free_memory)) * 100.0;
+        metrics->fragmentation = fragmentation > 0.0 ? fragmentation : 0.0;
+    } else {
+        metrics->fragmentation = 0.0;
+    }
+}
+
+// Suma las métricas de un pool de un grupo; el mayor bloque libre es el máximo
+static void accumulate_metrics(pool_metrics_t* total, const pool_metrics_t* member) {
+    total->total_memory += member->total_memory;
+    total->used_memory += member->used_memory;
+    total->free_memory += member->free_memory;
+    total->block_count += member->block_count;
+    total->free_blocks += member->free_blocks;
+    total->used_blocks += member->used_blocks;
+    if (member->largest_free_block > total->largest_free_block) {
+        total->largest_free_block = member->largest_free_block;
+    }
+    total->allocation_count += member->allocation_count;
+    total->free_count += member->free_count;
+    total->failed_allocations += member->failed_allocations;
+}
+
+// O(1): lee los contadores incrementales sin recorrer el heap
 MEMORY_API void memory_pool_get_metrics(void* pool_ptr, pool_metrics_t* metrics) {
     memory_pool_t* pool = (memory_pool_t*)pool_ptr;
     if (!pool || !metrics) return;
 
-    pthread_mutex_lock(&pool->mutex);
+    memset(metrics, 0, sizeof(pool_metrics_t));
+    if (pool->group) {
+        pool_metrics_t member_metrics;
+        memory_pool_t* member;
+        for (size_t i = 0; (member = pool_group_member(pool, i)); i++) {
+            pool_metrics_snapshot(member, &member_metrics);
+            accumulate_metrics(metrics, &member_metrics);
+        }
+    } else {
+        pool_metrics_snapshot(pool, metrics);
+    }
+    compute_fragmentation(metrics);
+}
+
+// Modo de verificación: recorre todos los headers del heap bajo el mutex
+MEMORY_API void memory_pool_walk_metrics(void* pool_ptr, pool_metrics_t* metrics) {
+    memory_pool_t* pool = (memory_pool_t*)pool_ptr;
+    if (!pool || !metrics) return;
+
+    if (pool->group) {
+        pool_metrics_t member_metrics;
+        memory_pool_t* member;
+        memset(metrics, 0, sizeof(pool_metrics_t));
+        for (size_t i = 0; (member = pool_group_member(pool, i)); i++) {
+            memory_pool_walk_metrics(member, &member_metrics);
+            accumulate_metrics(metrics, &member_metrics);
+        }
+        compute_fragmentation(metrics);
+        return;
+    }
+
+    pool_lock(pool);
 
     memset(metrics, 0, sizeof(pool_metrics_t));
     metrics->total_memory = pool->total_size;
@@ -37,18 +119,57 @@ MEMORY_API void memory_pool_get_metrics(void* pool_ptr, pool_metrics_t* metrics)
         if (block_total_size == 0) break;
         current += block_total_size;
     }
-    if (metrics->free_blocks > 1 && metrics->free_memory > 0) {
-        double fragmentation = (1.0 - ((double)metrics->largest_free_block / metrics->free_memory)) * 100.0;
-        metrics->fragmentation = fragmentation > 0.0 ? fragmentation : 0.0;
-    } else {
-        metrics->fragmentation = 0.0;
-    }
+    compute_fragmentation(metrics);
 
     metrics->allocation_count = pool->metrics.allocation_count;
     metrics->free_count = pool->metrics.free_count;
     metrics->failed_allocations = pool->metrics.failed_allocations;
 
-    pthread_mutex_unlock(&pool->mutex);
+    pool_unlock(pool);
+}
+
+// Compara los contadores incrementales con un recorrido completo del heap
+MEMORY_API int memory_pool_verify_metrics(void* pool_ptr) {
+    memory_pool_t* pool = (memory_pool_t*)pool_ptr;
+    if (!pool) return 0;
+
+    if (pool->group) {
+        memory_pool_t* member;
+        for (size_t i = 0; (member = pool_group_member(pool, i)); i++) {
+            if (!memory_pool_verify_metrics(member)) return 0;
+        }
+        return 1;
+    }
+
+    pool_metrics_t walked, counted;
+    memory_pool_walk_metrics(pool, &walked);
+    memory_pool_get_metrics(pool, &counted);
+
+    int ok = walked.used_memory == counted.used_memory &&
+             walked.free_memory == counted.free_memory &&
+             walked.used_blocks == counted.used_blocks &&
+             walked.free_blocks == counted.free_blocks &&
+             walked.largest_free_block == counted.largest_free_block &&
+             walked.used_memory + walked.free_memory == walked.total_memory;
+
+    // Los contadores por clase deben sumar los totales
+    pool_free_distribution_t distribution;
+    memory_pool_get_free_distribution(pool, &distribution);
+    size_t class_blocks = 0, class_bytes = 0;
+    for (int cls = 0; cls < MEMORY_SIZE_CLASSES; cls++) {
+        class_blocks += distribution.free_blocks[cls];
+        class_bytes += distribution.free_bytes[cls];
+    }
+    ok = ok && class_blocks == (size_t)walked.free_blocks && class_bytes == walked.free_memory;
+
+    if (!ok) {
+        MEMORY_LOG(MEMORY_LOG_ERROR,
+                   "Métricas inconsistentes: usada %zu/%zu, libre %zu/%zu, mayor libre %zu/%zu",
+                   counted.used_memory, walked.used_memory,
+                   counted.free_memory, walked.free_memory,
+                   counted.largest_free_block, walked.largest_free_block);
+    }
+    return ok;
 }
 
 MEMORY_API void memory_pool_print_metrics(void* pool_ptr) {
@@ -73,44 +194,199 @@ MEMORY_API void memory_pool_print_metrics(void* pool_ptr) {
     printf("Asignaciones fallidas: %zu\n", metrics.failed_allocations);
 }
 
+static void accumulate_costs(pool_cost_counters_t* total, const memory_pool_t* pool) {
+    total->searches += __atomic_load_n(&pool->costs.searches, __ATOMIC_RELAXED);
+    total->search_steps += __atomic_load_n(&pool->costs.search_steps, __ATOMIC_RELAXED);
+    total->splits += __atomic_load_n(&pool->costs.splits, __ATOMIC_RELAXED);
+    total->forward_merges += __atomic_load_n(&pool->costs.forward_merges, __ATOMIC_RELAXED);
+    total->backward_merges += __atomic_load_n(&pool->costs.backward_merges, __ATOMIC_RELAXED);
+    total->backward_walk_steps += __atomic_load_n(&pool->costs.backward_walk_steps, __ATOMIC_RELAXED);
+    total->bytes_zeroed += __atomic_load_n(&pool->costs.bytes_zeroed, __ATOMIC_RELAXED);
+    total->lock_acquisitions += __atomic_load_n(&pool->costs.lock_acquisitions, __ATOMIC_RELAXED);
+    total->lock_contended += __atomic_load_n(&pool->costs.lock_contended, __ATOMIC_RELAXED);
+}
+
+MEMORY_API void memory_pool_get_cost_counters(void* pool_ptr, pool_cost_counters_t* counters) {
+    memory_pool_t* pool = (memory_pool_t*)pool_ptr;
+    if (!counters) return;
+
+    memset(counters, 0, sizeof(pool_cost_counters_t));
+    if (!pool) return;
+
+    if (pool->group) {
+        memory_pool_t* member;
+        for (size_t i = 0; (member = pool_group_member(pool, i)); i++) accumulate_costs(counters, member);
+    } else {
+        accumulate_costs(counters, pool);
+    }
+}
+
+MEMORY_API void memory_pool_print_cost_counters(void* pool_ptr) {
+    pool_cost_counters_t costs;
+    memory_pool_get_cost_counters(pool_ptr, &costs);
+
+    printf("\n=== COSTE DE LAS OPERACIONES ===\n");
+    printf("Búsquedas: %zu (%.2f bloques examinados por búsqueda)\n", costs.searches,
+           costs.searches ? (double)costs.search_steps / costs.searches : 0.0);
+    printf("Divisiones: %zu\n", costs.splits);
+    printf("Fusiones con el siguiente: %zu\n", costs.forward_merges);
+    printf("Fusiones con el anterior: %zu (%zu headers recorridos)\n",
+           costs.backward_merges, costs.backward_walk_steps);
+    printf("Bytes limpiados: %zu\n", costs.bytes_zeroed);
+    printf("Tomas del mutex: %zu (%zu con espera)\n", costs.lock_acquisitions, costs.lock_contended);
+}
+
+// Contadores por clase de la lista libre segregada (sin recorrer el heap ni
+// tomar el mutex)
+static void free_distribution_snapshot(memory_pool_t* pool, pool_free_distribution_t* distribution) {
+    unsigned seq_start, seq_end;
+
+    do {
+        seq_start = __atomic_load_n(&pool->metrics_seq, __ATOMIC_ACQUIRE);
+        if (seq_start & 1) continue; // escritura en curso
+
+        for (int cls = 0; cls < MEMORY_SIZE_CLASSES; cls++) {
+            distribution->free_blocks[cls] = __atomic_load_n(&pool->free_class_blocks[cls], __ATOMIC_RELAXED);
+            distribution->free_bytes[cls] = __atomic_load_n(&pool->free_class_bytes[cls], __ATOMIC_RELAXED);
+        }
+        distribution->largest_free_block = __atomic_load_n(&pool->metrics.largest_free_block, __ATOMIC_RELAXED);
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        seq_end = __atomic_load_n(&pool->metrics_seq, __ATOMIC_RELAXED);
+    } while ((seq_start & 1) || seq_start != seq_end);
+}
+
+// Distribución de bloques libres; en un grupo, suma de las clases de todos
+// los miembros con el mayor bloque libre de cualquiera de ellos
+MEMORY_API void memory_pool_get_free_distribution(void* pool_ptr, pool_free_distribution_t* distribution) {
+    memory_pool_t* pool = (memory_pool_t*)pool_ptr;
+    if (!pool || !distribution) return;
+
+    memset(distribution, 0, sizeof(pool_free_distribution_t));
+    if (pool->group) {
+        pool_free_distribution_t member_distribution;
+        memory_pool_t* member;
+        for (size_t i = 0; (member = pool_group_member(pool, i)); i++) {
+            free_distribution_snapshot(member, &member_distribution);
+            for (int cls = 0; cls < MEMORY_SIZE_CLASSES; cls++) {
+                distribution->free_blocks[cls] += member_distribution.free_blocks[cls];
+                distribution->free_bytes[cls] += member_distribution.free_bytes[cls];
+            }
+            if (member_distribution.largest_free_block > distribution->largest_free_block) {
+                distribution->largest_free_block = member_distribution.largest_free_block;
+            }
+        }
+    } else {
+        free_distribution_snapshot(pool, distribution);
+    }
+
+    // Mayor petición de usuario que cabe en el mayor bloque libre
+    size_t largest_request = 0;
+    if (distribution->largest_free_block > sizeof(block_header_t)) {
+        largest_request = (distribution->largest_free_block - sizeof(block_header_t)) & ~(size_t)(MEMORY_ALIGNMENT - 1);
+    }
+
+    distribution->highest_class = -1;
+    for (int cls = 0; cls < MEMORY_SIZE_CLASSES; cls++) {
+        if (distribution->free_blocks[cls]) distribution->highest_class = cls;
+
+        size_t class_min = (size_t)1 << cls;
+        if (cls >= (int)(sizeof(size_t) * 8 - 1) || class_min > largest_request) continue;
+
+        size_t class_max = (class_min << 1) - 1;
+        distribution->max_allocatable[cls] = class_max < largest_request ? class_max : largest_request;
+
+        // Cada bloque de la clase j mide al menos 2^j: cota inferior conservadora
+        size_t request_total = sizeof(block_header_t) + ALIGN_SIZE(class_min);
+        for (int j = cls; j < MEMORY_SIZE_CLASSES && j < (int)(sizeof(size_t) * 8 - 1); j++) {
+            if (!distribution->free_blocks[j]) continue;
+            size_t per_block = (sizeof(block_header_t) + ((size_t)1 << j)) / request_total;
+            distribution->guaranteed_allocations[cls] += distribution->free_blocks[j] * per_block;
+        }
+    }
+}
+
+MEMORY_API void memory_pool_print_free_distribution(void* pool_ptr) {
+    pool_free_distribution_t distribution;
+    memory_pool_get_free_distribution(pool_ptr, &distribution);
+
+    printf("\n=== DISTRIBUCIÓN DE BLOQUES LIBRES ===\n");
+    printf("%-22s %10s %14s %16s %14s\n",
+           "Clase (bytes)", "Bloques", "Bytes libres", "Máx. asignable", "Garantizadas");
+
+    for (int cls = 0; cls <= distribution.highest_class; cls++) {
+        if (!distribution.free_blocks[cls] && !distribution.max_allocatable[cls]) continue;
+
+        char range[48];
+        snprintf(range, sizeof(range), "[%zu, %zu)", (size_t)1 << cls, (size_t)1 << (cls + 1));
+        printf("%-22s %10zu %14zu %16zu %14zu\n", range,
+               distribution.free_blocks[cls], distribution.free_bytes[cls],
+               distribution.max_allocatable[cls], distribution.guaranteed_allocations[cls]);
+    }
+    printf("Mayor bloque libre: %zu bytes\n", distribution.largest_free_block);
+}
+
 MEMORY_API int memory_pool_check(void* pool_ptr) {
     memory_pool_t* pool = (memory_pool_t*)pool_ptr;
     if (!pool) return 0;
 
-    pthread_mutex_lock(&pool->mutex);
+    if (pool->group) {
+        memory_pool_t* member;
+        for (size_t i = 0; (member = pool_group_member(pool, i)); i++) {
+            if (!memory_pool_check(member)) return 0;
+        }
+        return 1;
+    }
+
+    pool_lock(pool);
 
     int errors = 0;
-    block_header_t* current = pool->free_list;
-    int iteration = 0;
 
-    while (current && iteration < 1000) {
-        if (!block_is_valid(current)) {
-            MEMORY_LOG(MEMORY_LOG_ERROR, "Bloque inválido en free_list: %p", (void*)current);
-            errors++;
-            break;
+    for (int cls = 0; cls < FREE_LIST_CLASSES; cls++) {
+        block_header_t* current = pool->free_lists[cls];
+        // Una lista más larga que su contador de bloques indica un ciclo
+        size_t limit = pool->free_class_blocks[cls];
+        size_t iteration = 0;
+
+        while (current && iteration <= limit) {
+            if (!block_in_pool(pool, current)) {
+                MEMORY_LOG(MEMORY_LOG_ERROR, "Bloque fuera del pool en free_list: %p", (void*)current);
+                errors++;
+                break;
+            }
+
+            if (!block_is_valid(current)) {
+                MEMORY_LOG(MEMORY_LOG_ERROR, "Bloque inválido en free_list: %p", (void*)current);
+                errors++;
+                break;
+            }
+
+            if (current->used) {
+                MEMORY_LOG(MEMORY_LOG_ERROR, "Bloque marcado como usado en free_list: %p", (void*)current);
+                errors++;
+            }
+
+            if (size_class(current->size) != cls) {
+                MEMORY_LOG(MEMORY_LOG_ERROR, "Bloque %p en clase %d incorrecta", (void*)current, cls);
+                errors++;
+            }
+
+            current = block_get_next(pool, current);
+            iteration++;
         }
 
-        if (current->used) {
-            MEMORY_LOG(MEMORY_LOG_ERROR, "Bloque marcado como usado en free_list: %p", (void*)current);
+        if (iteration > limit) {
+            MEMORY_LOG(MEMORY_LOG_ERROR, "Posible ciclo en free_list (clase %d)", cls);
             errors++;
         }
 
-        if (!block_in_pool(pool, current)) {
-            MEMORY_LOG(MEMORY_LOG_ERROR, "Bloque fuera del pool en free_list: %p", (void*)current);
+        if (!pool->free_lists[cls] != !(pool->free_class_mask & (UINT64_C(1) << cls))) {
+            MEMORY_LOG(MEMORY_LOG_ERROR, "Máscara de clases inconsistente en clase %d", cls);
             errors++;
-            break;
         }
-
-        current = current->next;
-        iteration++;
     }
 
-    if (iteration >= 1000) {
-        MEMORY_LOG(MEMORY_LOG_ERROR, "Posible ciclo en free_list");
-        errors++;
-    }
-
-    pthread_mutex_unlock(&pool->mutex);
+    pool_unlock(pool);
     return errors == 0;
 }
 
@@ -131,3 +407,58 @@ MEMORY_API size_t memory_pool_get_free_memory(void* pool_ptr) {
     memory_pool_get_metrics(pool_ptr, &metrics);
     return metrics.free_memory;
 }
+
+MEMORY_API int memory_pool_get_latency(void* pool_ptr, memory_latency_op_t op, int strategy,
+                                       memory_histogram_t* out) {
+    memory_pool_t* pool = (memory_pool_t*)pool_ptr;
+    if (!pool || !out || strategy >= ALLOC_STRATEGY_COUNT) return MEMORY_ERROR_INVALID_PARAM;
+
+    memory_histogram_reset(out);
+    if (pool->group) {
+        memory_histogram_t member_histogram;
+        memory_pool_t* member;
+        for (size_t i = 0; (member = pool_group_member(pool, i)); i++) {
+            int status = memory_pool_get_latency(member, op, strategy, &member_histogram);
+            if (status != MEMORY_SUCCESS) return status;
+            memory_histogram_merge(out, &member_histogram);
+        }
+        return MEMORY_SUCCESS;
+    }
+    if (!pool->latency) return MEMORY_ERROR_POOL_NOT_INIT; // histogramas compilados fuera
+
+    memory_histogram_t snapshot;
+    switch (op) {
+        case MEMORY_LATENCY_LOCK_WAIT:
+            memory_histogram_snapshot(&pool->latency->lock_wait, out);
+            return MEMORY_SUCCESS;
+        case MEMORY_LATENCY_ALLOC:
+        case MEMORY_LATENCY_FREE:
+            for (int i = 0; i < ALLOC_STRATEGY_COUNT; i++) {
+                if (strategy >= 0 && i != strategy) continue;
+                memory_histogram_snapshot(op == MEMORY_LATENCY_ALLOC ? &pool->latency->alloc[i]
+                                                                     : &pool->latency->free[i],
+                                          &snapshot);
+                memory_histogram_merge(out, &snapshot);
+            }
+            return MEMORY_SUCCESS;
+    }
+    return MEMORY_ERROR_INVALID_PARAM;
+}
+
+MEMORY_API void memory_pool_reset_latency(void* pool_ptr) {
+    memory_pool_t* pool = (memory_pool_t*)pool_ptr;
+    if (!pool) return;
+
+    if (pool->group) {
+        memory_pool_t* member;
+        for (size_t i = 0; (member = pool_group_member(pool, i)); i++) memory_pool_reset_latency(member);
+        return;
+    }
+    if (!pool->latency) return;
+
+    for (int i = 0; i < ALLOC_STRATEGY_COUNT; i++) {
+        memory_histogram_reset(&pool->latency->alloc[i]);
+        memory_histogram_reset(&pool->latency->free[i]);
+    }
+    memory_histogram_reset(&pool->latency->lock_wait);
+}
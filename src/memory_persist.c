@@ -0,0 +1,496 @@
+#define _GNU_SOURCE
+#include "memory_internal.h"
+#include "../include/memory_pool.h"
+#include "../include/memory_metrics.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <poll.h>
+
+// =============================================================================
+// FORMATO DEL ARCHIVO PERSISTENTE
+// =============================================================================
+//
+// [ superbloque | relleno hasta PERSIST_HEADER_SIZE | heap de total_size bytes ]
+//
+// El heap usa headers con enlaces relativos (ver block_header_t), por lo que
+// puede mapearse en cualquier dirección. Se intenta reutilizar la dirección
+// base anterior para que los punteros absolutos guardados por la aplicación
+// dentro del pool sigan siendo válidos.
+
+#define PERSIST_MAGIC UINT64_C(0x4c4f4f504d454d4d) // "MMEMPOOL"
+#define PERSIST_VERSION 3
+#define PERSIST_HEADER_SIZE 4096
+
+typedef struct {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t block_header_size;
+    uint64_t heap_size;
+    uint64_t free_lists[FREE_LIST_CLASSES];
+    uint64_t root;
+    uint64_t base_address;
+    uint64_t allocation_count;
+    uint64_t free_count;
+    uint64_t failed_allocations;
+    uint64_t used_memory;
+    uint64_t free_memory;
+    uint64_t largest_free_block;
+    int32_t used_blocks;
+    int32_t free_blocks;
+    int32_t largest_free_count;
+    uint64_t free_class_blocks[FREE_LIST_CLASSES];
+    uint64_t free_class_bytes[FREE_LIST_CLASSES];
+    uint32_t strategy;
+    uint32_t alignment;
+    uint32_t clean_shutdown;
+} persist_superblock_t;
+
+static persist_superblock_t* pool_superblock(const memory_pool_t* pool) {
+    return (persist_superblock_t*)pool->mapping;
+}
+
+// Copia en sb el estado del heap que no vive en los headers
+static void persist_fill_state(const memory_pool_t* pool, persist_superblock_t* sb) {
+    for (int cls = 0; cls < FREE_LIST_CLASSES; cls++) {
+        sb->free_lists[cls] = block_to_offset(pool, pool->free_lists[cls]);
+        sb->free_class_blocks[cls] = pool->free_class_blocks[cls];
+        sb->free_class_bytes[cls] = pool->free_class_bytes[cls];
+    }
+    sb->strategy = (uint32_t)memory_pool_get_strategy(pool);
+    sb->allocation_count = pool->metrics.allocation_count;
+    sb->free_count = pool->metrics.free_count;
+    sb->failed_allocations = pool->metrics.failed_allocations;
+    sb->used_memory = pool->metrics.used_memory;
+    sb->free_memory = pool->metrics.free_memory;
+    sb->largest_free_block = pool->metrics.largest_free_block;
+    sb->used_blocks = pool->metrics.used_blocks;
+    sb->free_blocks = pool->metrics.free_blocks;
+    sb->largest_free_count = pool->largest_free_count;
+}
+
+static void persist_store_state(memory_pool_t* pool) {
+    persist_fill_state(pool, pool_superblock(pool));
+}
+
+static memory_pool_t* persist_attach(int fd, void* mapping, size_t mapping_size,
+                                     alloc_strategy_t strategy) {
+    memory_pool_t* pool = malloc(sizeof(memory_pool_t));
+    if (!pool) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "No se pudo asignar estructura del pool");
+        return NULL;
+    }
+
+    if (pool_init(pool, (char*)mapping + PERSIST_HEADER_SIZE,
+                  mapping_size - PERSIST_HEADER_SIZE, strategy) != MEMORY_SUCCESS) {
+        free(pool);
+        return NULL;
+    }
+
+    pool->backing = POOL_BACKING_FILE;
+    pool->fd = fd;
+    pool->mapping = mapping;
+    pool->mapping_size = mapping_size;
+    return pool;
+}
+
+// Llamada desde memory_pool_destroy con el mutex del pool tomado
+void persist_close(memory_pool_t* pool) {
+    persist_superblock_t* sb = pool_superblock(pool);
+
+    persist_store_state(pool);
+    msync(pool->mapping, pool->mapping_size, MS_SYNC);
+
+    // El marcador de cierre limpio se escribe después de que el heap está en disco
+    sb->clean_shutdown = 1;
+    msync(pool->mapping, PERSIST_HEADER_SIZE, MS_SYNC);
+
+    munmap(pool->mapping, pool->mapping_size);
+    close(pool->fd);
+
+    pool->mapping = NULL;
+    pool->mapping_size = 0;
+    pool->fd = -1;
+}
+
+// =============================================================================
+// API PÚBLICA
+// =============================================================================
+
+MEMORY_API memory_pool_t* memory_pool_create_persistent(const char* path, size_t total_size,
+                                                        alloc_strategy_t strategy) {
+    if (!path || total_size < sizeof(block_header_t) + MIN_BLOCK_SIZE) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "Parámetros inválidos para pool persistente");
+        return NULL;
+    }
+
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "No se pudo crear archivo del pool: %s", path);
+        return NULL;
+    }
+
+    size_t mapping_size = PERSIST_HEADER_SIZE + total_size;
+    if (ftruncate(fd, (off_t)mapping_size) != 0) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "No se pudo dimensionar archivo del pool: %zu bytes", mapping_size);
+        close(fd);
+        return NULL;
+    }
+
+    // El archivo recién truncado se lee como ceros: no hace falta memset
+    void* mapping = mmap(NULL, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "No se pudo mapear archivo del pool: %s", path);
+        close(fd);
+        return NULL;
+    }
+
+    memory_pool_t* pool = persist_attach(fd, mapping, mapping_size, strategy);
+    if (!pool) {
+        munmap(mapping, mapping_size);
+        close(fd);
+        return NULL;
+    }
+
+    persist_superblock_t* sb = pool_superblock(pool);
+    sb->magic = PERSIST_MAGIC;
+    sb->version = PERSIST_VERSION;
+    sb->block_header_size = sizeof(block_header_t);
+    sb->heap_size = total_size;
+    sb->root = BLOCK_OFFSET_NULL;
+    sb->base_address = (uint64_t)(uintptr_t)mapping;
+    sb->alignment = MEMORY_ALIGNMENT;
+    sb->clean_shutdown = 0;
+
+    pool_init_first_block(pool);
+    persist_store_state(pool);
+
+    MEMORY_LOG(MEMORY_LOG_INFO, "Pool persistente creado: %s (%zu bytes)", path, total_size);
+    return pool;
+}
+
+MEMORY_API memory_pool_t* memory_pool_open(const char* path) {
+    if (!path) return NULL;
+
+    int fd = open(path, O_RDWR);
+    if (fd < 0) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "No se pudo abrir archivo del pool: %s", path);
+        return NULL;
+    }
+
+    struct stat st;
+    persist_superblock_t header;
+    if (fstat(fd, &st) != 0 ||
+        (size_t)st.st_size < PERSIST_HEADER_SIZE + sizeof(block_header_t) + MIN_BLOCK_SIZE ||
+        pread(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header)) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "Archivo de pool truncado: %s", path);
+        close(fd);
+        return NULL;
+    }
+
+    if (header.magic != PERSIST_MAGIC || header.version != PERSIST_VERSION ||
+        header.block_header_size != sizeof(block_header_t) ||
+        header.alignment != MEMORY_ALIGNMENT ||
+        header.strategy > ALLOC_ADAPTIVE ||
+        header.heap_size != (uint64_t)st.st_size - PERSIST_HEADER_SIZE) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "Archivo de pool incompatible: %s", path);
+        close(fd);
+        return NULL;
+    }
+
+    // Sugerir la dirección base anterior para conservar punteros absolutos
+    size_t mapping_size = (size_t)st.st_size;
+    void* mapping = mmap((void*)(uintptr_t)header.base_address, mapping_size,
+                         PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "No se pudo mapear archivo del pool: %s", path);
+        close(fd);
+        return NULL;
+    }
+
+    if ((uintptr_t)mapping != header.base_address) {
+        MEMORY_LOG(MEMORY_LOG_WARN, "Pool %s mapeado en otra dirección base (%p)", path, mapping);
+    }
+
+    memory_pool_t* pool = persist_attach(fd, mapping, mapping_size, (alloc_strategy_t)header.strategy);
+    if (!pool) {
+        munmap(mapping, mapping_size);
+        close(fd);
+        return NULL;
+    }
+
+    persist_superblock_t* sb = pool_superblock(pool);
+    pool->metrics.allocation_count = sb->allocation_count;
+    pool->metrics.free_count = sb->free_count;
+    pool->metrics.failed_allocations = sb->failed_allocations;
+
+    int clean = sb->clean_shutdown;
+    for (int cls = 0; cls < FREE_LIST_CLASSES && clean; cls++) {
+        clean = sb->free_lists[cls] == BLOCK_OFFSET_NULL ||
+                sb->free_lists[cls] + sizeof(block_header_t) <= pool->total_size;
+    }
+
+    if (clean) {
+        // Restaurar listas libres y contadores tal como quedaron al cerrar
+        for (int cls = 0; cls < FREE_LIST_CLASSES; cls++) {
+            pool->free_lists[cls] = block_from_offset(pool, sb->free_lists[cls]);
+            if (pool->free_lists[cls]) pool->free_class_mask |= UINT64_C(1) << cls;
+            pool->free_class_blocks[cls] = sb->free_class_blocks[cls];
+            pool->free_class_bytes[cls] = sb->free_class_bytes[cls];
+        }
+        pool->metrics.used_memory = sb->used_memory;
+        pool->metrics.free_memory = sb->free_memory;
+        pool->metrics.largest_free_block = sb->largest_free_block;
+        pool->metrics.used_blocks = sb->used_blocks;
+        pool->metrics.free_blocks = sb->free_blocks;
+        pool->largest_free_count = sb->largest_free_count;
+    }
+
+    // Marcar el archivo como abierto antes de cualquier modificación del heap
+    sb->clean_shutdown = 0;
+    sb->base_address = (uint64_t)(uintptr_t)mapping;
+    msync(mapping, PERSIST_HEADER_SIZE, MS_SYNC);
+
+    if (!clean || !memory_pool_check(pool)) {
+        // Recuperación: reconstruir la lista libre desde el heap y verificarla
+        MEMORY_LOG(MEMORY_LOG_WARN, "Pool %s no se cerró limpiamente, reconstruyendo", path);
+        size_t walked = pool_rebuild_free_list(pool);
+        if (walked == 0 || !memory_pool_check(pool)) {
+            MEMORY_LOG(MEMORY_LOG_ERROR, "Recuperación fallida para pool %s", path);
+            pool_fini(pool);
+            munmap(mapping, mapping_size);
+            close(fd);
+            free(pool);
+            return NULL;
+        }
+        persist_store_state(pool);
+    }
+
+    MEMORY_LOG(MEMORY_LOG_INFO, "Pool persistente abierto: %s (%zu bytes, %s)",
+               path, pool->total_size, clean ? "cierre limpio" : "recuperado");
+    return pool;
+}
+
+MEMORY_API int memory_pool_sync(memory_pool_t* pool) {
+    if (!pool) return MEMORY_ERROR_INVALID_PARAM;
+    if (pool->backing != POOL_BACKING_FILE) return MEMORY_ERROR_INVALID_PARAM;
+
+    pool_lock(pool);
+    persist_store_state(pool);
+    int result = msync(pool->mapping, pool->mapping_size, MS_SYNC) == 0
+                 ? MEMORY_SUCCESS : MEMORY_ERROR_CORRUPTION;
+    pool_unlock(pool);
+
+    return result;
+}
+
+MEMORY_API int memory_pool_set_root(memory_pool_t* pool, void* ptr) {
+    if (!pool || pool->backing != POOL_BACKING_FILE) return MEMORY_ERROR_INVALID_PARAM;
+
+    pool_lock(pool);
+    if (ptr && !block_in_pool(pool, (block_header_t*)ptr)) {
+        pool_unlock(pool);
+        return MEMORY_ERROR_INVALID_PARAM;
+    }
+    pool_superblock(pool)->root = ptr ? (uint64_t)((char*)ptr - (char*)pool->memory_block)
+                                      : BLOCK_OFFSET_NULL;
+    pool_unlock(pool);
+
+    return MEMORY_SUCCESS;
+}
+
+MEMORY_API void* memory_pool_get_root(const memory_pool_t* pool) {
+    if (!pool || pool->backing != POOL_BACKING_FILE) return NULL;
+
+    uint64_t root = pool_superblock(pool)->root;
+    if (root == BLOCK_OFFSET_NULL || root >= pool->total_size) return NULL;
+    return (char*)pool->memory_block + root;
+}
+
+MEMORY_API int memory_pool_is_persistent(const memory_pool_t* pool) {
+    return pool && pool->backing == POOL_BACKING_FILE;
+}
+
+// =============================================================================
+// INSTANTÁNEAS COPY-ON-WRITE
+// =============================================================================
+// Con el mutex tomado se prepara el superbloque y se hace fork: el hijo ve
+// el heap congelado en ese instante (el kernel duplica solo las páginas que
+// el padre modifique después) y lo escribe en el formato persistente
+// mientras el padre sigue asignando. La pausa es la del fork, proporcional
+// a las tablas de páginas y no al contenido.
+//
+// El hijo solo tiene el hilo que llamó a fork: no puede usar malloc, stdio
+// ni MEMORY_LOG (otro hilo podía tener sus locks). Escribe con llamadas al
+// sistema y devuelve el resultado por una tubería.
+
+struct memory_snapshot {
+    pid_t child;
+    int result_fd;
+    uint64_t pause_ns;
+};
+
+typedef struct {
+    int32_t status;
+    uint64_t bytes_written;
+    uint64_t write_ns;
+} snapshot_result_t;
+
+static int snapshot_write_all(int fd, const void* data, size_t size) {
+    const char* cursor = data;
+    while (size > 0) {
+        ssize_t written = write(fd, cursor, size);
+        if (written < 0) return 0;
+        cursor += written;
+        size -= (size_t)written;
+    }
+    return 1;
+}
+
+// Cuerpo del proceso hijo: archivo temporal, fsync y rename atómico
+static void snapshot_child(const memory_pool_t* pool, const persist_superblock_t* sb,
+                           const char* path, const char* temp_path, int result_fd) {
+    snapshot_result_t result = {MEMORY_ERROR_CORRUPTION, 0, 0};
+    uint64_t start = memory_now_ns();
+
+    // Por encima de la frontera de cero el heap está a cero: queda como hueco
+    size_t written_heap = pool->zero_frontier < pool->total_size ? pool->zero_frontier : pool->total_size;
+    static char header[PERSIST_HEADER_SIZE];
+    memcpy(header, sb, sizeof(*sb));
+
+    int fd = open(temp_path, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (fd >= 0) {
+        int ok = ftruncate(fd, (off_t)(PERSIST_HEADER_SIZE + pool->total_size)) == 0 &&
+                 snapshot_write_all(fd, header, sizeof(header)) &&
+                 snapshot_write_all(fd, pool->memory_block, written_heap) &&
+                 fsync(fd) == 0;
+        ok = close(fd) == 0 && ok;
+        if (ok && rename(temp_path, path) == 0) {
+            result.status = MEMORY_SUCCESS;
+            result.bytes_written = PERSIST_HEADER_SIZE + written_heap;
+        } else {
+            unlink(temp_path);
+        }
+    }
+
+    result.write_ns = memory_now_ns() - start;
+    snapshot_write_all(result_fd, &result, sizeof(result));
+    _exit(result.status == MEMORY_SUCCESS ? 0 : 1);
+}
+
+MEMORY_API memory_snapshot_t* memory_pool_snapshot(memory_pool_t* pool, const char* path, void* root) {
+    // Un pool persistente comparte sus páginas con el archivo (MAP_SHARED):
+    // fork no las congela. Esos pools se guardan con memory_pool_sync.
+    if (!pool || !path || pool->group || pool->backing == POOL_BACKING_FILE) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "Parámetros inválidos para instantánea");
+        return NULL;
+    }
+
+    memory_snapshot_t* snapshot = malloc(sizeof(memory_snapshot_t));
+    size_t path_length = strlen(path);
+    char* temp_path = malloc(path_length + sizeof(".tmp"));
+    int pipe_fds[2];
+    if (!snapshot || !temp_path || pipe(pipe_fds) != 0) {
+        free(snapshot);
+        free(temp_path);
+        return NULL;
+    }
+    memcpy(temp_path, path, path_length);
+    memcpy(temp_path + path_length, ".tmp", sizeof(".tmp"));
+
+    pool_lock(pool);
+    if (!pool->active || (root && !block_in_pool(pool, (block_header_t*)root))) {
+        pool_unlock(pool);
+        MEMORY_LOG(MEMORY_LOG_ERROR, "Pool inactivo o raíz fuera del pool en la instantánea");
+        close(pipe_fds[0]);
+        close(pipe_fds[1]);
+        free(snapshot);
+        free(temp_path);
+        return NULL;
+    }
+
+    uint64_t start = memory_now_ns();
+
+    // Al abrir la copia se intenta mapear el heap en su dirección actual
+    persist_superblock_t sb;
+    memset(&sb, 0, sizeof(sb));
+    sb.magic = PERSIST_MAGIC;
+    sb.version = PERSIST_VERSION;
+    sb.block_header_size = sizeof(block_header_t);
+    sb.heap_size = pool->total_size;
+    sb.root = root ? (uint64_t)((char*)root - (char*)pool->memory_block) : BLOCK_OFFSET_NULL;
+    sb.base_address = (uint64_t)(uintptr_t)((char*)pool->memory_block - PERSIST_HEADER_SIZE);
+    sb.alignment = MEMORY_ALIGNMENT;
+    sb.clean_shutdown = 1;
+    persist_fill_state(pool, &sb);
+
+    pid_t child = fork();
+    if (child == 0) {
+        close(pipe_fds[0]);
+        snapshot_child(pool, &sb, path, temp_path, pipe_fds[1]);
+    }
+
+    snapshot->pause_ns = memory_now_ns() - start;
+    pool_unlock(pool);
+
+    close(pipe_fds[1]);
+    free(temp_path);
+    if (child < 0) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "No se pudo crear el proceso de la instantánea");
+        close(pipe_fds[0]);
+        free(snapshot);
+        return NULL;
+    }
+
+    snapshot->child = child;
+    snapshot->result_fd = pipe_fds[0];
+    MEMORY_LOG(MEMORY_LOG_INFO, "Instantánea de %zu bytes en curso hacia %s (pausa %llu ns)",
+               pool->total_size, path, (unsigned long long)snapshot->pause_ns);
+    return snapshot;
+}
+
+MEMORY_API int memory_snapshot_done(const memory_snapshot_t* snapshot) {
+    if (!snapshot) return 1;
+    // La tubería se vuelve legible con el resultado o al morir el hijo
+    struct pollfd readable = {snapshot->result_fd, POLLIN, 0};
+    return poll(&readable, 1, 0) > 0;
+}
+
+MEMORY_API int memory_snapshot_wait(memory_snapshot_t* snapshot, memory_snapshot_info_t* info) {
+    if (!snapshot) return MEMORY_ERROR_INVALID_PARAM;
+
+    snapshot_result_t result = {MEMORY_ERROR_CORRUPTION, 0, 0};
+    char* cursor = (char*)&result;
+    size_t remaining = sizeof(result);
+    while (remaining > 0) {
+        ssize_t received = read(snapshot->result_fd, cursor, remaining);
+        if (received <= 0) break;
+        cursor += received;
+        remaining -= (size_t)received;
+    }
+    // Sin resultado completo el hijo murió antes de terminar
+    if (remaining > 0) result.status = MEMORY_ERROR_CORRUPTION;
+
+    int child_status;
+    while (waitpid(snapshot->child, &child_status, 0) < 0 && errno == EINTR) {
+    }
+    close(snapshot->result_fd);
+
+    if (info) {
+        info->pause_ns = snapshot->pause_ns;
+        info->write_ns = result.write_ns;
+        info->bytes_written = (size_t)result.bytes_written;
+    }
+    if (result.status != MEMORY_SUCCESS) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "La instantánea no se pudo escribir");
+    }
+
+    free(snapshot);
+    return result.status;
+}
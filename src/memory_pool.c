@@ -1,23 +1,22 @@
 #include "memory_internal.h"
 #include "../include/memory_pool.h"
 #include "../include/memory_metrics.h"
+#include "../include/memory_histogram.h"
+#include "../include/memory_trace.h"
+#include "../include/memory_kernels.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <stdarg.h>
+#include <sys/mman.h>
 
-// Logging interno
-void memory_log_internal(memory_log_level_t level, const char* file, int line, const char* format, ...) {
-    const char* level_str[] = {"DEBUG", "INFO", "WARN", "ERROR"};
-    fprintf(stderr, "[MEMORY-%s] %s:%d: ", level_str[level], file, line);
+__thread char memory_thread_token;
 
-    va_list args;
-    va_start(args, format);
-    vfprintf(stderr, format, args);
-    va_end(args);
-
-    fprintf(stderr, "\n");
+// Uso de un pool o cliente sin sincronizar desde un hilo que no es su dueño
+void owner_violation(const char* what) {
+    MEMORY_LOG(MEMORY_LOG_ERROR, "%s sin sincronizar usado desde otro hilo", what);
+    abort();
 }
+
 // Verificación de bloque
 int block_is_valid(const block_header_t* block) {
     return block && block->magic == MAGIC_NUMBER;
@@ -31,18 +30,62 @@ int block_in_pool(const memory_pool_t* pool, const block_header_t* block) {
 }
 
 // Operaciones de lista libre
+// La lista libre está segregada por clase de tamaño (potencias de dos): la
+// clase k contiene los bloques con size en [2^k, 2^(k+1)). free_class_mask
+// indica qué clases tienen bloques, lo que permite saltar clases vacías.
+
+// Recalcula el mayor bloque libre a partir de la clase no vacía más alta
+static void recompute_largest_free(memory_pool_t* pool) {
+    size_t largest = 0;
+    int largest_count = 0;
+
+    if (pool->free_class_mask) {
+        int top = FREE_LIST_CLASSES - 1 - __builtin_clzll(pool->free_class_mask);
+        for (block_header_t* current = pool->free_lists[top]; current;
+             current = block_get_next(pool, current)) {
+            size_t total = sizeof(block_header_t) + current->size;
+            if (total > largest) {
+                largest = total;
+                largest_count = 1;
+            } else if (total == largest) {
+                largest_count++;
+            }
+        }
+    }
+
+    METRIC_SET(pool, largest_free_block, largest);
+    pool->largest_free_count = largest_count;
+}
+
 void add_to_free_list(memory_pool_t* pool, block_header_t* block) {
     if (!pool || !block || !block_is_valid(block)) return;
 
-    block->next = pool->free_list;
-    block->prev = NULL;
+    int cls = size_class(block->size);
+    block_header_t* head = pool->free_lists[cls];
+
+    block->next = block_to_offset(pool, head);
+    block->prev = BLOCK_OFFSET_NULL;
     block->used = 0;
+    block->flags = 0;
     block->client_id = -1;
 
-    if (pool->free_list) {
-        pool->free_list->prev = block;
+    if (head) {
+        head->prev = block_to_offset(pool, block);
+    }
+    pool->free_lists[cls] = block;
+    pool->free_class_mask |= UINT64_C(1) << cls;
+
+    size_t total = sizeof(block_header_t) + block->size;
+    METRIC_ADD(pool, free_memory, total);
+    METRIC_ADD(pool, free_blocks, 1);
+    CLASS_METRIC_ADD(pool, free_class_blocks, cls, 1);
+    CLASS_METRIC_ADD(pool, free_class_bytes, cls, total);
+    if (total > pool->metrics.largest_free_block) {
+        METRIC_SET(pool, largest_free_block, total);
+        pool->largest_free_count = 1;
+    } else if (total == pool->metrics.largest_free_block) {
+        pool->largest_free_count++;
     }
-    pool->free_list = block;
 
     MEMORY_LOG(MEMORY_LOG_DEBUG, "Bloque agregado a lista libre: %p (%zu bytes)",
                (void*)block, block->size);
@@ -51,21 +94,13 @@ void add_to_free_list(memory_pool_t* pool, block_header_t* block) {
 static int remove_from_free_list(memory_pool_t* pool, block_header_t* block) {
     if (!pool || !block || !block_is_valid(block)) return 0;
 
-    // Verificar si el bloque está realmente en la lista libre
-    int found = 0;
-    block_header_t* current = pool->free_list;
-    int safety_count = 0;
-
-    while (current && safety_count < 1000) {
-        if (current == block) {
-            found = 1;
-            break;
-        }
-        current = current->next;
-        safety_count++;
-    }
+    int cls = size_class(block->size);
+    block_header_t* next = block_get_next(pool, block);
+    block_header_t* prev = block_get_prev(pool, block);
 
-    if (!found) {
+    // Verificar que el bloque está realmente enlazado en su lista (O(1))
+    int linked = prev ? block_get_next(pool, prev) == block : pool->free_lists[cls] == block;
+    if (block->used || !linked) {
         MEMORY_LOG(MEMORY_LOG_WARN, "Intento de remover bloque %p no encontrado en lista libre",
                    (void*)block);
         return 0;
@@ -73,94 +108,127 @@ static int remove_from_free_list(memory_pool_t* pool, block_header_t* block) {
 
     // Actualizar next_fit si es necesario
     if (pool->next_fit == block) {
-        pool->next_fit = block->next ? block->next : pool->free_list;
+        pool->next_fit = next;
     }
 
     // Remover de la lista
-    if (block->prev) {
-        block->prev->next = block->next;
+    if (prev) {
+        prev->next = block->next;
     } else {
-        pool->free_list = block->next;
+        pool->free_lists[cls] = next;
+        if (!next) pool->free_class_mask &= ~(UINT64_C(1) << cls);
     }
 
-    if (block->next) {
-        block->next->prev = block->prev;
+    if (next) {
+        next->prev = block->prev;
     }
 
-    block->next = NULL;
-    block->prev = NULL;
+    block->next = BLOCK_OFFSET_NULL;
+    block->prev = BLOCK_OFFSET_NULL;
+
+    size_t total = sizeof(block_header_t) + block->size;
+    METRIC_SUB(pool, free_memory, total);
+    METRIC_SUB(pool, free_blocks, 1);
+    CLASS_METRIC_ADD(pool, free_class_blocks, cls, -1);
+    CLASS_METRIC_ADD(pool, free_class_bytes, cls, -total);
+    if (total == pool->metrics.largest_free_block && --pool->largest_free_count == 0) {
+        recompute_largest_free(pool);
+    }
 
     return 1;
 }
 
+// Primer bloque libre de la primera clase no vacía >= cls
+static block_header_t* first_free_from_class(const memory_pool_t* pool, int cls) {
+    if (cls >= FREE_LIST_CLASSES) return NULL;
+    uint64_t mask = pool->free_class_mask & (~UINT64_C(0) << cls);
+    return mask ? pool->free_lists[__builtin_ctzll(mask)] : NULL;
+}
+
+// Siguiente bloque en el orden (clase, posición en la lista)
+static block_header_t* next_free_in_order(const memory_pool_t* pool, const block_header_t* block) {
+    block_header_t* next = block_get_next(pool, block);
+    return next ? next : first_free_from_class(pool, size_class(block->size) + 1);
+}
+
 // Estrategias de asignación
+// En clases superiores a la del tamaño pedido todo bloque sirve, por lo que
+// las búsquedas solo recorren en detalle la clase del tamaño pedido.
 static block_header_t* find_first_fit(memory_pool_t* pool, size_t size) {
-    block_header_t* current = pool->free_list;
+    block_header_t* current = first_free_from_class(pool, size_class(size));
     while (current) {
+        COST_ADD(pool, search_steps, 1);
         if (current->size >= size) {
             return current;
         }
-        current = current->next;
+        current = next_free_in_order(pool, current);
     }
     return NULL;
 }
 
 static block_header_t* find_best_fit(memory_pool_t* pool, size_t size) {
-    block_header_t* current = pool->free_list;
+    int cls = size_class(size);
     block_header_t* best = NULL;
-    int safety_count = 0;
 
-    while (current && safety_count < 1000) {
-        if (current->size >= size) {
-            if (!best || current->size < best->size) {
-                best = current;
-                // Si encontramos un ajuste perfecto, salir inmediatamente
-                if (current->size == size) break;
-            }
+    for (block_header_t* current = pool->free_lists[cls]; current;
+         current = block_get_next(pool, current)) {
+        COST_ADD(pool, search_steps, 1);
+        if (current->size >= size && (!best || current->size < best->size)) {
+            best = current;
+            // Si encontramos un ajuste perfecto, salir inmediatamente
+            if (current->size == size) break;
         }
-        current = current->next;
-        safety_count++;
     }
-
-    if (safety_count >= 1000) {
-        MEMORY_LOG(MEMORY_LOG_ERROR, "Posible ciclo en lista libre durante BEST_FIT");
+    if (best) return best;
+
+    // Cualquier bloque de una clase superior es mayor que los de la clase pedida
+    for (block_header_t* current = first_free_from_class(pool, cls + 1); current;
+         current = block_get_next(pool, current)) {
+        COST_ADD(pool, search_steps, 1);
+        if (!best || current->size < best->size) {
+            best = current;
+        }
     }
-
     return best;
 }
 
 static block_header_t* find_worst_fit(memory_pool_t* pool, size_t size) {
-    block_header_t* current = pool->free_list;
+    if (!pool->free_class_mask) return NULL;
+
+    int top = FREE_LIST_CLASSES - 1 - __builtin_clzll(pool->free_class_mask);
     block_header_t* worst = NULL;
 
-    while (current) {
-        if (current->size >= size) {
-            if (!worst || current->size > worst->size) {
-                worst = current;
-            }
+    for (block_header_t* current = pool->free_lists[top]; current;
+         current = block_get_next(pool, current)) {
+        COST_ADD(pool, search_steps, 1);
+        if (!worst || current->size > worst->size) {
+            worst = current;
         }
-        current = current->next;
     }
-    return worst;
+    return worst && worst->size >= size ? worst : NULL;
 }
 
 static block_header_t* find_next_fit(memory_pool_t* pool, size_t size) {
-    if (!pool->free_list) return NULL;
-
-    if (!pool->next_fit) {
-        pool->next_fit = pool->free_list;
+    int cls = size_class(size);
+    block_header_t* first = first_free_from_class(pool, cls);
+    if (!first) return NULL;
+
+    // Continuar desde la última posición si sigue siendo candidata
+    block_header_t* start = first;
+    if (pool->next_fit && !pool->next_fit->used && size_class(pool->next_fit->size) >= cls) {
+        start = pool->next_fit;
     }
 
-    block_header_t* current = pool->next_fit;
-    block_header_t* start = current;
-
+    block_header_t* current = start;
     do {
+        block_header_t* next = next_free_in_order(pool, current);
+        COST_ADD(pool, search_steps, 1);
         if (current->size >= size) {
-            pool->next_fit = current->next ? current->next : pool->free_list;
+            pool->next_fit = next;
             return current;
         }
-        current = current->next ? current->next : pool->free_list;
-    } while (current && current != start);
+        current = next ? next : first;
+    } while (current != start);
 
     return NULL;
 }
@@ -189,9 +257,10 @@ static void fuse_with_neighbors(memory_pool_t* pool, block_header_t* block) {
         if ((char*)next_block < (char*)pool->memory_block + pool->total_size &&
             block_is_valid(next_block) && !next_block->used) {
 
-            block->size += sizeof(block_header_t) + next_block->size;
             remove_from_free_list(pool, next_block);
-            next_block->magic = 0;
+            block->size += sizeof(block_header_t) + next_block->size;
+            block_retire(pool, next_block, block);
+            COST_ADD(pool, forward_merges, 1);
             fused = 1;
 
             MEMORY_LOG(MEMORY_LOG_DEBUG, "Bloques fusionados con siguiente: %p + %p",
@@ -205,9 +274,11 @@ static void fuse_with_neighbors(memory_pool_t* pool, block_header_t* block) {
             block_header_t* potential_prev = NULL;
             char* current_pos = (char*)pool->memory_block;
 
+            size_t walked = 0;
             while (current_pos < (char*)block) {
                 block_header_t* current_block = (block_header_t*)current_pos;
                 if (!block_is_valid(current_block)) break;
+                walked++;
 
                 size_t block_total_size = sizeof(block_header_t) + current_block->size;
                 char* next_block_pos = current_pos + block_total_size;
@@ -223,15 +294,20 @@ static void fuse_with_neighbors(memory_pool_t* pool, block_header_t* block) {
                 current_pos += block_total_size;
             }
 
+            COST_ADD(pool, backward_walk_steps, walked);
+
             if (potential_prev) {
+                // El anterior cambia de tamaño (y de clase): sale de su lista
+                remove_from_free_list(pool, potential_prev);
                 potential_prev->size += sizeof(block_header_t) + block->size;
-                remove_from_free_list(pool, block);
-                block->magic = 0;
-                block = potential_prev;
-                fused = 1;
+                block_retire(pool, block, potential_prev);
+                COST_ADD(pool, backward_merges, 1);
 
                 MEMORY_LOG(MEMORY_LOG_DEBUG, "Bloques fusionados con anterior: %p + %p",
                            (void*)potential_prev, (void*)block);
+
+                block = potential_prev;
+                fused = 1;
                 continue; // Continuar para posible fusión adicional
             }
         }
@@ -244,8 +320,166 @@ static void fuse_with_neighbors(memory_pool_t* pool, block_header_t* block) {
     }
 }
 
+// Inicialización común de la estructura del pool sobre una región ya reservada
+int pool_init(memory_pool_t* pool, void* memory, size_t total_size, alloc_strategy_t strategy) {
+    if ((unsigned)strategy > ALLOC_ADAPTIVE) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "Estrategia inválida: %d", strategy);
+        return MEMORY_ERROR_INVALID_PARAM;
+    }
+
+    pool->memory_block = memory;
+    pool->total_size = total_size;
+    pool->strategy = strategy == ALLOC_ADAPTIVE ? ALLOC_FIRST_FIT : strategy;
+    memset(&pool->costs, 0, sizeof(pool->costs));
+    pool->adaptive = NULL;
+    pool->adaptive_state = NULL;
+    memset(pool->free_lists, 0, sizeof(pool->free_lists));
+    pool->free_class_mask = 0;
+    pool->next_fit = NULL;
+    pool->unsynchronized = 0;
+    pool->owner = NULL;
+    pool->active = 1;
+    pool->zero_frontier = total_size;
+    pool->backing = POOL_BACKING_HEAP;
+    pool->fd = -1;
+    pool->mapping = NULL;
+    pool->mapping_size = 0;
+    pool->group = NULL;
+    pool->verify_cursor = 0;
+    pool->verify = NULL;
+    pool->waits = NULL;
+    memset(&pool->metrics, 0, sizeof(pool_metrics_t));
+    pool->metrics.total_memory = total_size;
+    pool->metrics_seq = 0;
+    pool_reset_counters(pool);
+    pool->latency = NULL;
+
+#if MEMORY_LATENCY_HISTOGRAMS
+    pool->latency = malloc(sizeof(pool_latency_t));
+    if (!pool->latency) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "No se pudieron asignar histogramas de latencia");
+        return MEMORY_ERROR_OUT_OF_MEMORY;
+    }
+    memory_pool_reset_latency(pool);
+#endif
+
+    if (strategy == ALLOC_ADAPTIVE && !(pool->adaptive = pool->adaptive_state = adaptive_create())) {
+        free(pool->latency);
+        pool->latency = NULL;
+        return MEMORY_ERROR_OUT_OF_MEMORY;
+    }
+
+    if (pthread_mutex_init(&pool->mutex, NULL) != 0) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "No se pudo inicializar mutex");
+        free(pool->latency);
+        free(pool->adaptive_state);
+        pool->latency = NULL;
+        pool->adaptive = pool->adaptive_state = NULL;
+        return MEMORY_ERROR_POOL_NOT_INIT;
+    }
+
+    return MEMORY_SUCCESS;
+}
+
+// Libera los recursos creados por pool_init (no la memoria del heap)
+void pool_fini(memory_pool_t* pool) {
+    pthread_mutex_destroy(&pool->mutex);
+    free(pool->latency);
+    free(pool->adaptive_state);
+    pool->latency = NULL;
+    pool->adaptive = pool->adaptive_state = NULL;
+}
+
+// Pone a cero los contadores de ocupación (no los de operaciones)
+void pool_reset_counters(memory_pool_t* pool) {
+    METRIC_SET(pool, used_memory, 0);
+    METRIC_SET(pool, free_memory, 0);
+    METRIC_SET(pool, used_blocks, 0);
+    METRIC_SET(pool, free_blocks, 0);
+    METRIC_SET(pool, largest_free_block, 0);
+    pool->largest_free_count = 0;
+    for (int cls = 0; cls < FREE_LIST_CLASSES; cls++) {
+        __atomic_store_n(&pool->free_class_blocks[cls], 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&pool->free_class_bytes[cls], 0, __ATOMIC_RELAXED);
+    }
+}
+
+// Crea un único bloque libre que abarca todo el pool
+void pool_init_first_block(memory_pool_t* pool) {
+    block_header_t* first_block = (block_header_t*)pool->memory_block;
+    first_block->size = pool->total_size - sizeof(block_header_t);
+    first_block->used = 0;
+    first_block->flags = 0;
+    first_block->client_id = -1;
+    first_block->magic = MAGIC_NUMBER;
+    first_block->next = first_block->prev = BLOCK_OFFSET_NULL;
+    pool->verify_cursor = 0;
+
+    metrics_write_begin(pool);
+    add_to_free_list(pool, first_block);
+    metrics_write_end(pool);
+}
+
+// Recorre el heap en orden de direcciones, fusiona bloques libres adyacentes
+// y reconstruye listas y contadores (dentro de una sección de escritura).
+// Devuelve el número de bloques recorridos; se detiene en el primer header
+// inválido.
+static size_t pool_sweep_free_blocks(memory_pool_t* pool) {
+    memset(pool->free_lists, 0, sizeof(pool->free_lists));
+    pool->free_class_mask = 0;
+    pool->next_fit = NULL;
+
+    pool_reset_counters(pool);
+
+    char* current = (char*)pool->memory_block;
+    char* end = current + pool->total_size;
+    block_header_t* pending_free = NULL;
+    size_t walked = 0;
+
+    while (current + sizeof(block_header_t) <= end) {
+        block_header_t* block = (block_header_t*)current;
+        if (!block_is_valid(block) || block->size > (size_t)(end - current) - sizeof(block_header_t)) {
+            MEMORY_LOG(MEMORY_LOG_ERROR, "Header inválido durante reconstrucción: %p", (void*)block);
+            break;
+        }
+
+        walked++;
+        current += sizeof(block_header_t) + block->size;
+
+        if (block->used) {
+            if (pending_free) add_to_free_list(pool, pending_free);
+            pending_free = NULL;
+            METRIC_ADD(pool, used_memory, sizeof(block_header_t) + block->size);
+            METRIC_ADD(pool, used_blocks, 1);
+            continue;
+        }
+
+        if (pending_free) {
+            pending_free->size += sizeof(block_header_t) + block->size;
+            block_retire(pool, block, pending_free);
+            COST_ADD(pool, forward_merges, 1);
+        } else {
+            pending_free = block;
+        }
+    }
+
+    if (pending_free) add_to_free_list(pool, pending_free);
+    return walked;
+}
+
+size_t pool_rebuild_free_list(memory_pool_t* pool) {
+    metrics_write_begin(pool);
+    size_t walked = pool_sweep_free_blocks(pool);
+    metrics_write_end(pool);
+    return walked;
+}
+
 // Implementación de la API pública
 MEMORY_API memory_pool_t* memory_pool_create(size_t total_size, alloc_strategy_t strategy) {
+    return memory_pool_create_ex(total_size, strategy, 0);
+}
+
+MEMORY_API memory_pool_t* memory_pool_create_ex(size_t total_size, alloc_strategy_t strategy, unsigned flags) {
     if (total_size < sizeof(block_header_t) + MIN_BLOCK_SIZE) {
         MEMORY_LOG(MEMORY_LOG_ERROR, "Tamaño de pool insuficiente: %zu", total_size);
         return NULL;
@@ -257,51 +491,65 @@ MEMORY_API memory_pool_t* memory_pool_create(size_t total_size, alloc_strategy_t
         return NULL;
     }
 
-    pool->memory_block = malloc(total_size);
-    if (!pool->memory_block) {
+    // Modo perezoso: solo se reserva espacio de direcciones; el kernel entrega
+    // páginas a cero y las compromete cuando se tocan
+    void* memory;
+    if (flags & MEMORY_POOL_FLAG_LAZY) {
+        memory = mmap(NULL, total_size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (memory == MAP_FAILED) memory = NULL;
+    } else {
+        memory = malloc(total_size);
+        if (memory) memory_zero(memory, total_size);
+    }
+
+    if (!memory) {
         MEMORY_LOG(MEMORY_LOG_ERROR, "No se pudo asignar bloque de memoria: %zu bytes", total_size);
         free(pool);
         return NULL;
     }
 
-    memset(pool->memory_block, 0, total_size);
-    pool->total_size = total_size;
-    pool->strategy = strategy;
-    pool->free_list = NULL;
-    pool->next_fit = NULL;
-    pool->active = 1;
-    memset(&pool->metrics, 0, sizeof(pool_metrics_t));
-    pool->metrics.total_memory = total_size;
-
-    if (pthread_mutex_init(&pool->mutex, NULL) != 0) {
-        MEMORY_LOG(MEMORY_LOG_ERROR, "No se pudo inicializar mutex");
-        free(pool->memory_block);
+    if (pool_init(pool, memory, total_size, strategy) != MEMORY_SUCCESS) {
+        if (flags & MEMORY_POOL_FLAG_LAZY) munmap(memory, total_size);
+        else free(memory);
         free(pool);
         return NULL;
     }
 
-    block_header_t* first_block = (block_header_t*)pool->memory_block;
-    first_block->size = total_size - sizeof(block_header_t);
-    first_block->used = 0;
-    first_block->client_id = -1;
-    first_block->magic = MAGIC_NUMBER;
-    first_block->next = first_block->prev = NULL;
+    if (flags & MEMORY_POOL_FLAG_LAZY) {
+        pool->backing = POOL_BACKING_MMAP;
+        pool->mapping = memory;
+        pool->mapping_size = total_size;
+    }
 
-    add_to_free_list(pool, first_block);
+    pool_init_first_block(pool);
+    pool->zero_frontier = sizeof(block_header_t);
+    if (!(flags & MEMORY_POOL_FLAG_LAZY)) COST_ADD(pool, bytes_zeroed, total_size);
+    pool->unsynchronized = (flags & MEMORY_POOL_FLAG_UNSYNCHRONIZED) != 0;
 
-    MEMORY_LOG(MEMORY_LOG_INFO, "Pool creado: %zu bytes, estrategia: %d",
-               total_size, strategy);
+    MEMORY_LOG(MEMORY_LOG_INFO, "Pool creado: %zu bytes, estrategia: %d%s%s",
+               total_size, strategy, (flags & MEMORY_POOL_FLAG_LAZY) ? " (perezoso)" : "",
+               pool->unsynchronized ? " (sin sincronizar)" : "");
 
     return pool;
 }
 
 MEMORY_API void memory_pool_destroy(memory_pool_t* pool) {
     if (!pool) return;
+    export_forget(pool);
+    pool_verify_release(pool);
+    pool_wait_release(pool);
+    if (pool->group) {
+        pool_group_destroy_view(pool);
+        return;
+    }
 
-    pthread_mutex_lock(&pool->mutex);
+    // Destruir desde otro hilo es legítimo cuando el dueño ya terminó
+    pool->owner = NULL;
+    pool_lock(pool);
 
     if (!pool->active) {
-        pthread_mutex_unlock(&pool->mutex);
+        pool_unlock(pool);
         return;
     }
 
@@ -313,80 +561,146 @@ MEMORY_API void memory_pool_destroy(memory_pool_t* pool) {
 
     pool->active = 0;
 
-    if (pool->memory_block) {
+    if (pool->backing == POOL_BACKING_FILE) {
+        // Cierre limpio: el contenido del heap se conserva en el archivo
+        persist_close(pool);
+    } else if (pool->backing == POOL_BACKING_MMAP) {
+        munmap(pool->mapping, pool->mapping_size);
+    } else if (pool->memory_block) {
         free(pool->memory_block);
-        pool->memory_block = NULL;
     }
+    pool->memory_block = NULL;
 
-    pool->free_list = NULL;
+    memset(pool->free_lists, 0, sizeof(pool->free_lists));
+    pool->free_class_mask = 0;
     pool->next_fit = NULL;
     pool->total_size = 0;
 
-    pthread_mutex_unlock(&pool->mutex);
-    pthread_mutex_destroy(&pool->mutex);
+    pool_unlock(pool);
+    pool_fini(pool);
 
     free(pool);
 
     MEMORY_LOG(MEMORY_LOG_INFO, "Pool destruido correctamente");
 }
 
-MEMORY_API void* memory_pool_alloc(memory_pool_t* pool, size_t size, int client_id) {
-    if (!pool || size == 0) {
-        MEMORY_LOG(MEMORY_LOG_ERROR, "Parámetros inválidos para alloc");
-        return NULL;
+// Limpia [start, end) del heap solo por debajo de la frontera de cero y la
+// avanza hasta end, incluido el header del bloque que pueda seguirle
+static void pool_clear_range(memory_pool_t* pool, char* start, char* end) {
+    size_t from = (size_t)(start - (char*)pool->memory_block);
+    size_t to = (size_t)(end - (char*)pool->memory_block);
+
+    if (from < pool->zero_frontier) {
+        size_t dirty_end = to < pool->zero_frontier ? to : pool->zero_frontier;
+        memory_zero(start, dirty_end - from);
+        COST_ADD(pool, bytes_zeroed, dirty_end - from);
     }
+    size_t written_end = to + (to < pool->total_size ? sizeof(block_header_t) : 0);
+    if (written_end > pool->zero_frontier) pool->zero_frontier = written_end;
+}
+
+// Bloque siguiente en orden de direcciones (NULL al final del heap)
+static block_header_t* block_next_physical(const memory_pool_t* pool, const block_header_t* block) {
+    block_header_t* next = (block_header_t*)((char*)(block + 1) + block->size);
+    return (char*)next < (char*)pool->memory_block + pool->total_size ? next : NULL;
+}
+
+// Devuelve a la lista libre lo que sobra de un bloque usado tras sus primeros
+// keep bytes de datos, fusionándolo con el siguiente si está libre (dentro de
+// una sección de escritura de métricas)
+static void block_release_tail(memory_pool_t* pool, block_header_t* block, size_t keep) {
+    if (block->size - keep < sizeof(block_header_t) + MIN_BLOCK_SIZE) return;
+
+    block_header_t* tail = (block_header_t*)((char*)(block + 1) + keep);
+    tail->size = block->size - keep - sizeof(block_header_t);
+    tail->used = 0;
+    tail->flags = 0;
+    tail->client_id = -1;
+    tail->magic = MAGIC_NUMBER;
+    tail->next = tail->prev = BLOCK_OFFSET_NULL;
+
+    METRIC_SUB(pool, used_memory, block->size - keep);
+    block->size = keep;
+    COST_ADD(pool, splits, 1);
+
+    block_header_t* next = block_next_physical(pool, tail);
+    if (next && block_is_valid(next) && !next->used) {
+        remove_from_free_list(pool, next);
+        tail->size += sizeof(block_header_t) + next->size;
+        block_retire(pool, next, tail);
+        COST_ADD(pool, forward_merges, 1);
+    }
+    add_to_free_list(pool, tail);
+}
 
-    pthread_mutex_lock(&pool->mutex);
+static void* pool_alloc_locked(memory_pool_t* pool, size_t size, int client_id,
+                               int sampled, alloc_strategy_t* used_strategy) {
+    pool_lock(pool);
+    *used_strategy = pool->strategy;
 
     if (!pool->active) {
         MEMORY_LOG(MEMORY_LOG_ERROR, "Intento de usar pool inactivo");
-        pthread_mutex_unlock(&pool->mutex);
+        pool_unlock(pool);
         return NULL;
     }
 
-    size_t aligned_size = ALIGN_SIZE(size);
-    if (aligned_size > pool->total_size - sizeof(block_header_t)) {
-        MEMORY_LOG(MEMORY_LOG_ERROR, "Tamaño solicitado demasiado grande: %zu", aligned_size);
-        pthread_mutex_unlock(&pool->mutex);
-        pool->metrics.failed_allocations++;
+    // Antes de alinear: cerca de SIZE_MAX el redondeo da la vuelta a 0
+    if (size > pool->total_size || ALIGN_SIZE(size) > pool->total_size - sizeof(block_header_t)) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "Tamaño solicitado demasiado grande: %zu", size);
+        metrics_write_begin(pool);
+        METRIC_ADD(pool, failed_allocations, 1);
+        metrics_write_end(pool);
+        pool_unlock(pool);
         return NULL;
     }
 
+    size_t aligned_size = ALIGN_SIZE(size);
+
     block_header_t* block = NULL;
+    COST_ADD(pool, searches, 1);
     switch (pool->strategy) {
         case ALLOC_FIRST_FIT: block = find_first_fit(pool, aligned_size); break;
         case ALLOC_BEST_FIT: block = find_best_fit(pool, aligned_size); break;
         case ALLOC_WORST_FIT: block = find_worst_fit(pool, aligned_size); break;
         case ALLOC_NEXT_FIT: block = find_next_fit(pool, aligned_size); break;
+        case ALLOC_ADAPTIVE: break;     // pool->strategy siempre es concreta
     }
 
     if (!block) {
         MEMORY_LOG(MEMORY_LOG_WARN, "No hay bloques libres para %zu bytes", aligned_size);
-        pthread_mutex_unlock(&pool->mutex);
-        pool->metrics.failed_allocations++;
+        metrics_write_begin(pool);
+        METRIC_ADD(pool, failed_allocations, 1);
+        if (pool->adaptive) adaptive_account(pool, 1, 0);
+        metrics_write_end(pool);
+        pool_unlock(pool);
         return NULL;
     }
 
+    metrics_write_begin(pool);
     remove_from_free_list(pool, block);
 
     size_t remaining = block->size - aligned_size;
-    if (remaining >= sizeof(block_header_t) + MIN_BLOCK_SIZE) {
+    int split = remaining >= sizeof(block_header_t) + MIN_BLOCK_SIZE;
+    if (split) {
+        COST_ADD(pool, splits, 1);
         block_header_t* new_block = (block_header_t*)((char*)(block + 1) + aligned_size);
 
         if (!block_in_pool(pool, new_block)) {
             MEMORY_LOG(MEMORY_LOG_ERROR, "Error crítico: split block fuera del pool");
             // Recuperación: restaurar bloque original
             add_to_free_list(pool, block);
-            pthread_mutex_unlock(&pool->mutex);
-            pool->metrics.failed_allocations++;
+            METRIC_ADD(pool, failed_allocations, 1);
+            metrics_write_end(pool);
+            pool_unlock(pool);
             return NULL;
         }
 
         new_block->size = remaining - sizeof(block_header_t);
         new_block->used = 0;
+        new_block->flags = 0;
         new_block->client_id = -1;
         new_block->magic = MAGIC_NUMBER;
-        new_block->next = new_block->prev = NULL;
+        new_block->next = new_block->prev = BLOCK_OFFSET_NULL;
 
         block->size = aligned_size;
         add_to_free_list(pool, new_block);
@@ -397,95 +711,476 @@ MEMORY_API void* memory_pool_alloc(memory_pool_t* pool, size_t size, int client_
     }
 
     block->used = 1;
+    block->flags = sampled ? BLOCK_FLAG_SAMPLED : 0;
     block->client_id = client_id;
 
+    // Solo se limpia la parte del bloque por debajo de la frontera de cero
     void* data_ptr = (void*)(block + 1);
-    memset(data_ptr, 0, block->size);
+    pool_clear_range(pool, data_ptr, (char*)data_ptr + block->size);
 
-    pool->metrics.allocation_count++;
-    pool->metrics.used_memory += block->size;
+    METRIC_ADD(pool, allocation_count, 1);
+    METRIC_ADD(pool, used_memory, sizeof(block_header_t) + block->size);
+    METRIC_ADD(pool, used_blocks, 1);
+    if (pool->adaptive) adaptive_account(pool, 0, split);
+    metrics_write_end(pool);
 
     MEMORY_LOG(MEMORY_LOG_DEBUG, "Cliente %d asignó %zu bytes en %p",
                client_id, block->size, data_ptr);
 
-    pthread_mutex_unlock(&pool->mutex);
+    pool_unlock(pool);
     return data_ptr;
 }
 
-MEMORY_API int memory_pool_free(memory_pool_t* pool, void* ptr, int client_id) {
-    if (!pool || !ptr) {
-        MEMORY_LOG(MEMORY_LOG_ERROR, "Parámetros inválidos para free");
-        return MEMORY_ERROR_INVALID_PARAM;
-    }
-
-    pthread_mutex_lock(&pool->mutex);
-
-    if (!pool->active) {
-        MEMORY_LOG(MEMORY_LOG_ERROR, "Intento de usar pool inactivo");
-        pthread_mutex_unlock(&pool->mutex);
-        return MEMORY_ERROR_POOL_NOT_INIT;
-    }
-
-    block_header_t* block = (block_header_t*)ptr - 1;
+// Comprobaciones previas a liberar un bloque (con el mutex tomado).
+// Devuelve BLOCK_ALREADY_FREE si no hay nada que liberar.
+#define BLOCK_ALREADY_FREE 1
 
+static int block_check_release(const memory_pool_t* pool, const block_header_t* block, int client_id) {
     if (!block_in_pool(pool, block)) {
         MEMORY_LOG(MEMORY_LOG_ERROR, "Bloque fuera del pool: %p", (void*)block);
-        pthread_mutex_unlock(&pool->mutex);
         return MEMORY_ERROR_CORRUPTION;
     }
 
     if (!block_is_valid(block)) {
         MEMORY_LOG(MEMORY_LOG_ERROR, "Bloque corrupto: %p", (void*)block);
-        pthread_mutex_unlock(&pool->mutex);
         return MEMORY_ERROR_CORRUPTION;
     }
 
     if (!block->used) {
         MEMORY_LOG(MEMORY_LOG_WARN, "Bloque ya libre: %p", (void*)block);
-        pthread_mutex_unlock(&pool->mutex);
-        return MEMORY_SUCCESS;
+        return BLOCK_ALREADY_FREE;
     }
 
     if (block->client_id != client_id) {
         MEMORY_LOG(MEMORY_LOG_ERROR, "Cliente %d intentó liberar bloque del cliente %d",
                    client_id, block->client_id);
-        pthread_mutex_unlock(&pool->mutex);
         return MEMORY_ERROR_CLIENT_INVALID;
     }
 
+    return MEMORY_SUCCESS;
+}
+
+// Perfilador y traza, solo para bloques ya validados y con el mutex tomado:
+// una vez libre otro hilo podría reutilizar la misma dirección
+static void pool_free_hooks(const block_header_t* block, int client_id, int traced) {
+    if (block->flags & BLOCK_FLAG_SAMPLED) profiler_record_free((void*)(block + 1));
+    if (traced && __atomic_load_n(&trace_active, __ATOMIC_RELAXED)) {
+        trace_record(MEMORY_TRACE_FREE, block + 1, NULL, 0, client_id);
+    }
+}
+
+// traced = 0 cuando quien llama registra su propio evento (realloc)
+static int pool_free_locked(memory_pool_t* pool, void* ptr, int client_id, int traced,
+                            alloc_strategy_t* used_strategy) {
+    pool_lock(pool);
+    *used_strategy = pool->strategy;
+
+    if (!pool->active) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "Intento de usar pool inactivo");
+        pool_unlock(pool);
+        return MEMORY_ERROR_POOL_NOT_INIT;
+    }
+
+    block_header_t* block = (block_header_t*)ptr - 1;
+
+    int status = block_check_release(pool, block, client_id);
+    if (status != MEMORY_SUCCESS) {
+        pool_unlock(pool);
+        return status == BLOCK_ALREADY_FREE ? MEMORY_SUCCESS : status;
+    }
+
     MEMORY_LOG(MEMORY_LOG_DEBUG, "Cliente %d liberó %zu bytes en %p",
                client_id, block->size, ptr);
+    pool_free_hooks(block, client_id, traced);
 
-    pool->metrics.free_count++;
-    pool->metrics.used_memory -= block->size;
+    metrics_write_begin(pool);
+    METRIC_ADD(pool, free_count, 1);
+    METRIC_SUB(pool, used_memory, sizeof(block_header_t) + block->size);
+    METRIC_SUB(pool, used_blocks, 1);
 
+    block->used = 0;
     fuse_with_neighbors(pool, block);
+    metrics_write_end(pool);
+
+    pool_unlock(pool);
+    return MEMORY_SUCCESS;
+}
+
+// Cambio de tamaño sin mover el bloque: encoge devolviendo la cola o crece
+// absorbiendo el bloque siguiente si está libre. Devuelve BLOCK_NEEDS_MOVE si
+// no hay espacio contiguo.
+#define BLOCK_NEEDS_MOVE 2
+
+static int pool_resize_locked(memory_pool_t* pool, void* ptr, size_t size, int client_id) {
+    pool_lock(pool);
+
+    if (!pool->active) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "Intento de usar pool inactivo");
+        pool_unlock(pool);
+        return MEMORY_ERROR_POOL_NOT_INIT;
+    }
+
+    block_header_t* block = (block_header_t*)ptr - 1;
+    int status = block_check_release(pool, block, client_id);
+    if (status != MEMORY_SUCCESS) {
+        pool_unlock(pool);
+        return status == BLOCK_ALREADY_FREE ? MEMORY_ERROR_INVALID_PARAM : status;
+    }
+
+    size_t aligned_size = ALIGN_SIZE(size);
+    block_header_t* next = NULL;
+    if (aligned_size > block->size) {
+        next = block_next_physical(pool, block);
+        if (!next || !block_is_valid(next) || next->used ||
+            block->size + sizeof(block_header_t) + next->size < aligned_size) {
+            pool_unlock(pool);
+            return BLOCK_NEEDS_MOVE;
+        }
+    }
+
+    metrics_write_begin(pool);
+    if (next) {
+        char* grown = (char*)(block + 1) + block->size;
+        remove_from_free_list(pool, next);
+        block_retire(pool, next, block);
+        COST_ADD(pool, forward_merges, 1);
+        METRIC_ADD(pool, used_memory, sizeof(block_header_t) + next->size);
+        block->size += sizeof(block_header_t) + next->size;
+        pool_clear_range(pool, grown, (char*)(block + 1) + aligned_size);
+    }
+    block_release_tail(pool, block, aligned_size);
+    metrics_write_end(pool);
+
+    MEMORY_LOG(MEMORY_LOG_DEBUG, "Cliente %d redimensionó %p a %zu bytes sin moverlo",
+               client_id, ptr, block->size);
 
-    pthread_mutex_unlock(&pool->mutex);
+    pool_unlock(pool);
     return MEMORY_SUCCESS;
 }
 
+// Recoloca un bloque recién asignado con holgura para que sus datos queden
+// alineados a alignment: el hueco delantero y la cola sobrante vuelven libres
+static void* pool_align_block(memory_pool_t* pool, void* raw, size_t alignment, size_t size) {
+    pool_lock(pool);
+    metrics_write_begin(pool);
+
+    block_header_t* block = (block_header_t*)raw - 1;
+    uintptr_t address = (uintptr_t)raw;
+    if (address & (alignment - 1)) {
+        // El hueco delantero debe poder ser un bloque libre por sí mismo
+        address = (address + sizeof(block_header_t) + MIN_BLOCK_SIZE + alignment - 1) &
+                  ~(uintptr_t)(alignment - 1);
+        block_header_t* aligned = (block_header_t*)address - 1;
+        size_t front = (size_t)((char*)aligned - (char*)block);
+
+        *aligned = *block;
+        aligned->size = block->size - front;
+        aligned->next = aligned->prev = BLOCK_OFFSET_NULL;
+
+        block->size = front - sizeof(block_header_t);
+        block->used = 0;
+        METRIC_SUB(pool, used_memory, front);
+        fuse_with_neighbors(pool, block);
+
+        block = aligned;
+    }
+    block_release_tail(pool, block, ALIGN_SIZE(size));
+
+    metrics_write_end(pool);
+    pool_unlock(pool);
+    return block + 1;
+}
+
+MEMORY_API void* memory_pool_alloc(memory_pool_t* pool, size_t size, int client_id) {
+    if (!pool || size == 0) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "Parámetros inválidos para alloc");
+        return NULL;
+    }
+    if (pool->group) return pool_group_alloc(pool, size, client_id);
+
+    // Decisión de muestreo fuera del lock; el backtrace se toma tras soltarlo
+    int sampled = __atomic_load_n(&profiler_interval, __ATOMIC_RELAXED) &&
+                  profiler_sample_tick(size);
+
+    // Bloques internos (client_id negativo) nunca van a la región de guarda
+    void* ptr = NULL;
+    if (__atomic_load_n(&guard_sample_rate, __ATOMIC_RELAXED) && client_id >= 0 && guard_sample_tick()) {
+        ptr = guard_alloc(size, client_id);
+        sampled = 0;
+    }
+
+    if (!ptr) {
+        uint64_t start = LATENCY_START();
+        alloc_strategy_t strategy;
+        ptr = pool_alloc_locked(pool, size, client_id, sampled, &strategy);
+        LATENCY_RECORD(pool, alloc, strategy, start);
+    }
+
+    if (sampled && ptr) {
+        profiler_record_alloc(ptr, ((block_header_t*)ptr - 1)->size, client_id);
+    }
+    if (__atomic_load_n(&trace_active, __ATOMIC_RELAXED)) {
+        trace_record(MEMORY_TRACE_ALLOC, ptr, NULL, size, client_id);
+    }
+
+    return ptr;
+}
+
+MEMORY_API int memory_pool_free(memory_pool_t* pool, void* ptr, int client_id) {
+    if (!pool || !ptr) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "Parámetros inválidos para free");
+        return MEMORY_ERROR_INVALID_PARAM;
+    }
+    if (guard_owns(ptr)) return guard_free(ptr, client_id);
+    int result;
+    if (pool->group) {
+        result = pool_group_free(pool, ptr, client_id);
+    } else {
+        uint64_t start = LATENCY_START();
+        alloc_strategy_t strategy;
+        result = pool_free_locked(pool, ptr, client_id, 1, &strategy);
+        LATENCY_RECORD(pool, free, strategy, start);
+    }
+
+    if (result == MEMORY_SUCCESS) pool_release_notify(pool);
+    return result;
+}
+
+// Liberación en bloque: un único lock para todos los punteros. Fusionar uno
+// a uno recorre los headers desde el principio del heap hasta cada bloque
+// (fuse_with_neighbors); marcar todos libres y reconstruir las listas en una
+// pasada recorre el heap entero una vez. Se elige lo más barato estimando el
+// recorrido de cada bloque por su posición: un lote pequeño respecto a los
+// bloques del heap, o concentrado al principio, se libera uno a uno.
+
+MEMORY_API size_t memory_pool_free_bulk(memory_pool_t* pool, void* const* ptrs, size_t count, int client_id) {
+    if (!pool || !ptrs) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "Parámetros inválidos para free_bulk");
+        return 0;
+    }
+    // Los bloques de la región de guarda se liberan aparte y el resto los salta
+    size_t guarded = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (ptrs[i] && guard_owns(ptrs[i]) && memory_pool_free(pool, ptrs[i], client_id) == MEMORY_SUCCESS) {
+            guarded++;
+        }
+    }
+    if (pool->group) {
+        size_t freed = pool_group_free_bulk(pool, ptrs, count, client_id);
+        if (freed) pool_release_notify(pool);
+        return guarded + freed;
+    }
+
+    // Fracción del heap que precede a cada bloque, sumada sobre el lote
+    double walk_fraction = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        if (!ptrs[i] || guard_owns(ptrs[i])) continue;
+        size_t offset = (size_t)((char*)ptrs[i] - (char*)pool->memory_block);
+        if (offset < pool->total_size) walk_fraction += (double)offset / (double)pool->total_size;
+    }
+
+    pool_lock(pool);
+    if (!pool->active) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "Intento de usar pool inactivo");
+        pool_unlock(pool);
+        return guarded;
+    }
+
+    size_t heap_blocks = (size_t)pool->metrics.used_blocks + (size_t)pool->metrics.free_blocks;
+    int sweep = walk_fraction * (double)heap_blocks + (double)count > (double)heap_blocks;
+    size_t freed = 0;
+    size_t freed_bytes = 0;
+
+    metrics_write_begin(pool);
+    for (size_t i = 0; i < count; i++) {
+        if (!ptrs[i] || guard_owns(ptrs[i])) continue;
+
+        block_header_t* block = (block_header_t*)ptrs[i] - 1;
+        if (block_check_release(pool, block, client_id) != MEMORY_SUCCESS) continue;
+
+        pool_free_hooks(block, client_id, 1);
+        freed++;
+        freed_bytes += sizeof(block_header_t) + block->size;
+        block->used = 0;
+        if (!sweep) fuse_with_neighbors(pool, block);
+    }
+
+    METRIC_ADD(pool, free_count, freed);
+    METRIC_SUB(pool, used_memory, freed_bytes);
+    METRIC_SUB(pool, used_blocks, (int)freed);
+    if (sweep && freed) pool_sweep_free_blocks(pool);
+    metrics_write_end(pool);
+
+    pool_unlock(pool);
+    if (freed) pool_release_notify(pool);
+
+    MEMORY_LOG(MEMORY_LOG_DEBUG, "Cliente %d liberó %zu bloques en bloque (%zu bytes)",
+               client_id, freed, freed_bytes);
+    return guarded + freed;
+}
+
+// realloc con la semántica de C: ptr NULL equivale a alloc y size 0 a free.
+// Si el bloque no puede crecer en su sitio se mueve; ante un fallo el bloque
+// original queda intacto. La traza registra un único evento REALLOC.
+MEMORY_API void* memory_pool_realloc(memory_pool_t* pool, void* ptr, size_t size, int client_id) {
+    if (!pool) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "Parámetros inválidos para realloc");
+        return NULL;
+    }
+    if (!ptr) return memory_pool_alloc(pool, size, client_id);
+    if (size == 0) {
+        memory_pool_free(pool, ptr, client_id);
+        return NULL;
+    }
+    if (guard_owns(ptr)) {
+        // Un bloque muestreado nunca crece en su página: se mueve siempre
+        size_t old_size = guard_usable_size(ptr);
+        if (!old_size) return NULL;
+
+        void* result = memory_pool_alloc(pool, size, client_id);
+        if (!result) return NULL;
+        memory_copy(result, ptr, old_size < size ? old_size : size);
+        memory_pool_free(pool, ptr, client_id);
+        return result;
+    }
+    if (pool->group) {
+        // Los miembros ya avisan a sus esperas; la vista tiene las suyas
+        void* moved = pool_group_realloc(pool, ptr, size, client_id);
+        if (moved) pool_release_notify(pool);
+        return moved;
+    }
+    if (size > pool->total_size) return NULL;
+
+    void* result = ptr;
+    int status = pool_resize_locked(pool, ptr, size, client_id);
+    if (status == BLOCK_NEEDS_MOVE) {
+        int sampled = __atomic_load_n(&profiler_interval, __ATOMIC_RELAXED) &&
+                      profiler_sample_tick(size);
+        alloc_strategy_t strategy;
+
+        result = pool_alloc_locked(pool, size, client_id, sampled, &strategy);
+        if (!result) return NULL;
+
+        block_header_t* old_block = (block_header_t*)ptr - 1;
+        memory_copy(result, ptr, old_block->size);
+        pool_free_locked(pool, ptr, client_id, 0, &strategy);
+
+        if (sampled) profiler_record_alloc(result, ((block_header_t*)result - 1)->size, client_id);
+    } else if (status != MEMORY_SUCCESS) {
+        return NULL;
+    }
+
+    if (__atomic_load_n(&trace_active, __ATOMIC_RELAXED)) {
+        trace_record(MEMORY_TRACE_REALLOC, result, ptr, size, client_id);
+    }
+    // Mover o encoger deja memoria libre (crecer en el sitio solo despierta en vano)
+    pool_release_notify(pool);
+    return result;
+}
+
+// alignment debe ser potencia de dos; hasta MEMORY_ALIGNMENT basta alloc
+MEMORY_API void* memory_pool_alloc_aligned(memory_pool_t* pool, size_t alignment, size_t size, int client_id) {
+    if (!pool || size == 0 || alignment == 0 || (alignment & (alignment - 1))) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "Parámetros inválidos para alloc_aligned");
+        return NULL;
+    }
+    if (alignment <= MEMORY_ALIGNMENT) return memory_pool_alloc(pool, size, client_id);
+    if (pool->group) return pool_group_alloc_aligned(pool, alignment, size, client_id);
+
+    size_t padding = alignment + sizeof(block_header_t) + MIN_BLOCK_SIZE;
+    if (size > pool->total_size) return NULL;
+
+    int sampled = __atomic_load_n(&profiler_interval, __ATOMIC_RELAXED) &&
+                  profiler_sample_tick(size);
+    alloc_strategy_t strategy;
+    void* raw = pool_alloc_locked(pool, size + padding, client_id, sampled, &strategy);
+    void* ptr = raw ? pool_align_block(pool, raw, alignment, size) : NULL;
+
+    if (sampled && ptr) {
+        profiler_record_alloc(ptr, ((block_header_t*)ptr - 1)->size, client_id);
+    }
+    if (__atomic_load_n(&trace_active, __ATOMIC_RELAXED)) {
+        trace_record(MEMORY_TRACE_ALLOC, ptr, NULL, size, client_id);
+    }
+    return ptr;
+}
+
+// Bytes utilizables de un bloque en uso (0 si ptr no es un bloque válido)
+MEMORY_API size_t memory_pool_usable_size(const memory_pool_t* pool, const void* ptr) {
+    if (!pool || !ptr) return 0;
+    if (guard_owns(ptr)) return guard_usable_size(ptr);
+    if (pool->group) return pool_group_usable_size(pool, ptr);
+
+    const block_header_t* block = (const block_header_t*)ptr - 1;
+    if (!block_in_pool(pool, block) || !block_is_valid(block) || !block->used) return 0;
+    return block->size;
+}
+
 MEMORY_API int memory_pool_set_strategy(memory_pool_t* pool, alloc_strategy_t strategy) {
-    if (!pool) return MEMORY_ERROR_INVALID_PARAM;
+    if (!pool || (unsigned)strategy > ALLOC_ADAPTIVE) return MEMORY_ERROR_INVALID_PARAM;
+
+    // En un grupo la estrategia se aplica a todas las clases
+    memory_pool_t* member;
+    for (size_t i = 0; pool->group && (member = pool_group_member(pool, i)); i++) {
+        memory_pool_set_strategy(member, strategy);
+    }
+
+    // ALLOC_ADAPTIVE parte de la estrategia actual; una concreta lo desactiva.
+    // El estado no se libera al desactivarlo: memory_pool_get_adaptive_stats
+    // lo lee sin mutex y puede tener todavía el puntero
+    pool_adaptive_t* created = NULL;
+    if (strategy == ALLOC_ADAPTIVE && !pool->adaptive_state && !(created = adaptive_create())) {
+        return MEMORY_ERROR_OUT_OF_MEMORY;
+    }
 
-    pthread_mutex_lock(&pool->mutex);
-    pool->strategy = strategy;
+    // El cambio de estado va en una sección de escritura: los lectores de
+    // memory_pool_get_adaptive_stats reintentan en vez de leer uno a medias
+    pool_lock(pool);
+    metrics_write_begin(pool);
+    if (strategy == ALLOC_ADAPTIVE) {
+        if (!pool->adaptive_state) {
+            pool->adaptive_state = created;
+            created = NULL;
+        }
+        if (!pool->adaptive) {
+            memset(pool->adaptive_state, 0, sizeof(pool_adaptive_t));
+            pool->adaptive_state->window_start_steps = pool->costs.search_steps;
+            pool->adaptive = pool->adaptive_state;
+        }
+    } else {
+        pool->adaptive = NULL;
+        pool->strategy = strategy;
+    }
     pool->next_fit = NULL;
-    pthread_mutex_unlock(&pool->mutex);
+    metrics_write_end(pool);
+    pool_unlock(pool);
 
+    free(created);
     return MEMORY_SUCCESS;
 }
 
 MEMORY_API alloc_strategy_t memory_pool_get_strategy(const memory_pool_t* pool) {
-    return pool ? pool->strategy : ALLOC_FIRST_FIT;
+    if (!pool) return ALLOC_FIRST_FIT;
+    return pool->adaptive ? ALLOC_ADAPTIVE : pool->strategy;
 }
 
 MEMORY_API size_t memory_pool_get_total_size(const memory_pool_t* pool) {
-    return pool ? pool->total_size : 0;
+    if (!pool) return 0;
+    if (!pool->group) return pool->total_size;
+
+    size_t total = 0;
+    memory_pool_t* member;
+    for (size_t i = 0; (member = pool_group_member(pool, i)); i++) total += member->total_size;
+    return total;
 }
 
 MEMORY_API int memory_pool_is_valid(const memory_pool_t* pool) {
-    return pool && pool->active && pool->memory_block;
+    return pool && pool->active && (pool->memory_block || pool->group);
+}
+
+// El próximo hilo que use el pool pasa a ser su dueño
+MEMORY_API void memory_pool_release_owner(memory_pool_t* pool) {
+    if (pool) __atomic_store_n(&pool->owner, NULL, __ATOMIC_RELAXED);
 }
 
 #ifdef MEMORY_DEBUG
@@ -0,0 +1,227 @@
+#include "memory_internal.h"
+#include "../include/memory_pool_group.h"
+#include "../include/memory_kernels.h"
+#include <stdlib.h>
+#include <string.h>
+
+// =============================================================================
+// GRUPOS DE POOLS SEGREGADOS POR TAMAÑO
+// =============================================================================
+// El grupo contiene un memory_pool_t "vista" sin heap propio cuyo campo group
+// apunta aquí: memory_pool_alloc/free/free_bulk lo detectan y delegan en el
+// pool de la clase. Así un cliente no distingue un grupo de un pool normal.
+
+#define GROUP_BULK_BATCH 64
+
+struct memory_pool_group {
+    memory_pool_t view;
+    size_t count;
+    memory_pool_t* pools[MEMORY_POOL_GROUP_MAX_CLASSES];
+    size_t max_sizes[MEMORY_POOL_GROUP_MAX_CLASSES];
+    // Rango de direcciones de cada heap para encontrar el dueño en free
+    const char* starts[MEMORY_POOL_GROUP_MAX_CLASSES];
+    const char* ends[MEMORY_POOL_GROUP_MAX_CLASSES];
+};
+
+static int group_owner(const memory_pool_group_t* group, const void* ptr) {
+    for (size_t i = 0; i < group->count; i++) {
+        if ((const char*)ptr >= group->starts[i] && (const char*)ptr < group->ends[i]) return (int)i;
+    }
+    return -1;
+}
+
+// =============================================================================
+// INTERFAZ INTERNA (usada por memory_pool.c y memory_metrics.c)
+// =============================================================================
+
+// Si la clase que corresponde está llena, la petición sube a la siguiente:
+// un grupo no debe fallar donde un pool único todavía tendría espacio
+void* pool_group_alloc(memory_pool_t* view, size_t size, int client_id) {
+    memory_pool_group_t* group = view->group;
+
+    for (size_t i = 0; i < group->count; i++) {
+        if (size > group->max_sizes[i]) continue;
+
+        void* ptr = memory_pool_alloc(group->pools[i], size, client_id);
+        if (ptr) return ptr;
+
+        MEMORY_LOG(MEMORY_LOG_DEBUG, "Clase %zu del grupo llena para %zu bytes, probando la siguiente",
+                   i, size);
+    }
+
+    MEMORY_LOG(MEMORY_LOG_WARN, "Ninguna clase del grupo pudo asignar %zu bytes", size);
+    return NULL;
+}
+
+int pool_group_free(memory_pool_t* view, void* ptr, int client_id) {
+    memory_pool_group_t* group = view->group;
+
+    int owner = group_owner(group, ptr);
+    if (owner < 0) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "Puntero %p fuera de los pools del grupo", ptr);
+        return MEMORY_ERROR_INVALID_PARAM;
+    }
+    return memory_pool_free(group->pools[owner], ptr, client_id);
+}
+
+// Reparte los punteros por pool dueño en una sola pasada y libera cada lote
+// con un único lock de ese pool
+size_t pool_group_free_bulk(memory_pool_t* view, void* const* ptrs, size_t count, int client_id) {
+    memory_pool_group_t* group = view->group;
+    void* batches[MEMORY_POOL_GROUP_MAX_CLASSES][GROUP_BULK_BATCH];
+    size_t pending[MEMORY_POOL_GROUP_MAX_CLASSES] = {0};
+    size_t freed = 0;
+
+    for (size_t j = 0; j < count; j++) {
+        if (!ptrs[j] || guard_owns(ptrs[j])) continue;
+
+        int owner = group_owner(group, ptrs[j]);
+        if (owner < 0) {
+            MEMORY_LOG(MEMORY_LOG_ERROR, "Puntero %p fuera de los pools del grupo", ptrs[j]);
+            continue;
+        }
+
+        batches[owner][pending[owner]++] = ptrs[j];
+        if (pending[owner] == GROUP_BULK_BATCH) {
+            freed += memory_pool_free_bulk(group->pools[owner], batches[owner], pending[owner], client_id);
+            pending[owner] = 0;
+        }
+    }
+
+    for (size_t i = 0; i < group->count; i++) {
+        if (pending[i]) freed += memory_pool_free_bulk(group->pools[i], batches[i], pending[i], client_id);
+    }
+    return freed;
+}
+
+// Mientras el nuevo tamaño quepa en la clase del pool dueño se redimensiona
+// allí; si no, el bloque se mueve a la clase que le corresponde
+void* pool_group_realloc(memory_pool_t* view, void* ptr, size_t size, int client_id) {
+    memory_pool_group_t* group = view->group;
+
+    int owner = group_owner(group, ptr);
+    if (owner < 0) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "Puntero %p fuera de los pools del grupo", ptr);
+        return NULL;
+    }
+
+    size_t old_size = memory_pool_usable_size(group->pools[owner], ptr);
+    if (!old_size) return NULL;
+
+    if (size <= group->max_sizes[owner]) {
+        void* result = memory_pool_realloc(group->pools[owner], ptr, size, client_id);
+        if (result) return result;
+    }
+
+    void* result = pool_group_alloc(view, size, client_id);
+    if (!result) return NULL;
+
+    memory_copy(result, ptr, old_size < size ? old_size : size);
+    memory_pool_free(group->pools[owner], ptr, client_id);
+    return result;
+}
+
+void* pool_group_alloc_aligned(memory_pool_t* view, size_t alignment, size_t size, int client_id) {
+    memory_pool_group_t* group = view->group;
+
+    for (size_t i = 0; i < group->count; i++) {
+        if (size > group->max_sizes[i]) continue;
+
+        void* ptr = memory_pool_alloc_aligned(group->pools[i], alignment, size, client_id);
+        if (ptr) return ptr;
+    }
+    return NULL;
+}
+
+size_t pool_group_usable_size(const memory_pool_t* view, const void* ptr) {
+    const memory_pool_group_t* group = view->group;
+
+    int owner = group_owner(group, ptr);
+    return owner < 0 ? 0 : memory_pool_usable_size(group->pools[owner], ptr);
+}
+
+memory_pool_t* pool_group_member(const memory_pool_t* view, size_t index) {
+    const memory_pool_group_t* group = view->group;
+    return index < group->count ? group->pools[index] : NULL;
+}
+
+void pool_group_destroy_view(memory_pool_t* view) {
+    memory_pool_group_destroy(view->group);
+}
+
+// =============================================================================
+// API PÚBLICA
+// =============================================================================
+
+MEMORY_API memory_pool_group_t* memory_pool_group_create(const memory_pool_group_class_t* classes, size_t count) {
+    if (!classes || count == 0 || count > MEMORY_POOL_GROUP_MAX_CLASSES) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "Clases inválidas para el grupo: %zu", count);
+        return NULL;
+    }
+    for (size_t i = 1; i < count; i++) {
+        if (classes[i].max_size <= classes[i - 1].max_size) {
+            MEMORY_LOG(MEMORY_LOG_ERROR, "Las clases del grupo deben ir en orden creciente de tamaño");
+            return NULL;
+        }
+    }
+
+    memory_pool_group_t* group = calloc(1, sizeof(memory_pool_group_t));
+    if (!group) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "No se pudo asignar estructura del grupo");
+        return NULL;
+    }
+
+    if (pool_init(&group->view, NULL, 0, classes[count - 1].strategy) != MEMORY_SUCCESS) {
+        free(group);
+        return NULL;
+    }
+    group->view.group = group;
+
+    for (size_t i = 0; i < count; i++) {
+        memory_pool_t* pool = memory_pool_create_ex(classes[i].pool_size, classes[i].strategy,
+                                                    classes[i].flags);
+        if (!pool) {
+            memory_pool_group_destroy(group);
+            return NULL;
+        }
+
+        group->pools[i] = pool;
+        group->max_sizes[i] = classes[i].max_size;
+        group->starts[i] = pool->memory_block;
+        group->ends[i] = (const char*)pool->memory_block + pool->total_size;
+        group->count++;
+        // Con un miembro sin sincronizar la vista tampoco admite otros hilos
+        group->view.unsynchronized |= pool->unsynchronized;
+    }
+
+    MEMORY_LOG(MEMORY_LOG_INFO, "Grupo de pools creado: %zu clases", count);
+    return group;
+}
+
+MEMORY_API void memory_pool_group_destroy(memory_pool_group_t* group) {
+    if (!group) return;
+
+    // El verificador de fondo de la vista recorre los pools miembros
+    export_forget(&group->view);
+    pool_verify_release(&group->view);
+    pool_wait_release(&group->view);
+    for (size_t i = 0; i < group->count; i++) {
+        memory_pool_destroy(group->pools[i]);
+    }
+    pool_fini(&group->view);
+    free(group);
+
+    MEMORY_LOG(MEMORY_LOG_INFO, "Grupo de pools destruido");
+}
+
+MEMORY_API memory_pool_t* memory_pool_group_as_pool(memory_pool_group_t* group) {
+    return group ? &group->view : NULL;
+}
+
+MEMORY_API size_t memory_pool_group_get_count(const memory_pool_group_t* group) {
+    return group ? group->count : 0;
+}
+
+MEMORY_API memory_pool_t* memory_pool_group_get_pool(const memory_pool_group_t* group, size_t index) {
+    return group && index < group->count ? group->pools[index] : NULL;
+}
@@ -0,0 +1,350 @@
+#include "memory_internal.h"
+#include "../include/memory_profiler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <execinfo.h>
+#include <sys/mman.h>
+
+// =============================================================================
+// ESTADO DEL PERFILADOR
+// =============================================================================
+
+#define PROFILER_MAX_FRAMES 32
+#define PROFILER_SKIP_FRAMES 2
+#define PROFILER_BUCKETS 4096
+#define PROFILER_MAX_SAMPLES 16384
+
+typedef struct profiler_sample {
+    void* ptr;
+    size_t size;
+    size_t weight;
+    int client_id;
+    int depth;
+    void* frames[PROFILER_MAX_FRAMES];
+    struct profiler_sample* next;
+} profiler_sample_t;
+
+// Intervalo medio de muestreo; 0 = perfilador inactivo
+size_t profiler_interval = 0;
+
+static unsigned profiler_generation = 0;
+static pthread_mutex_t profiler_mutex = PTHREAD_MUTEX_INITIALIZER;
+static profiler_sample_t* profiler_buckets[PROFILER_BUCKETS];
+static size_t profiler_total_samples = 0;
+static size_t profiler_live_samples = 0;
+static size_t profiler_live_bytes = 0;
+static size_t profiler_dropped_samples = 0;
+
+// Las muestras salen de una reserva fija hecha con mmap: el registro corre
+// dentro de la asignación y malloc puede ser el propio pool con LD_PRELOAD.
+// La reserva no se libera nunca; si se agota, la muestra se descarta.
+static profiler_sample_t* profiler_reserve = NULL;
+static profiler_sample_t* profiler_free_samples = NULL;
+
+// Estado por hilo: bytes restantes hasta la siguiente muestra
+static __thread int64_t bytes_until_sample = 0;
+static __thread unsigned thread_generation = 0;
+static __thread uint64_t thread_rng = 0;
+
+// =============================================================================
+// MUESTREO GEOMÉTRICO (sin depender de libm)
+// =============================================================================
+
+static uint64_t profiler_random(void) {
+    if (!thread_rng) {
+        thread_rng = (uint64_t)(uintptr_t)&thread_rng ^ memory_now_ns() ^ UINT64_C(0x9e3779b97f4a7c15);
+    }
+    // xorshift64*
+    thread_rng ^= thread_rng >> 12;
+    thread_rng ^= thread_rng << 25;
+    thread_rng ^= thread_rng >> 27;
+    return thread_rng * UINT64_C(0x2545f4914f6cdd1d);
+}
+
+// ln(x) para x en (0, 1]: exponente binario más serie de atanh para la mantisa
+static double profiler_log(double x) {
+    union { double d; uint64_t u; } bits = { x };
+    int exponent = (int)((bits.u >> 52) & 0x7ff) - 1023;
+    bits.u = (bits.u & ~(UINT64_C(0x7ff) << 52)) | (UINT64_C(1023) << 52);
+
+    double t = (bits.d - 1.0) / (bits.d + 1.0);
+    double t2 = t * t;
+    double ln_mantissa = 2.0 * t * (1.0 + t2 * (1.0 / 3 + t2 * (1.0 / 5 + t2 * (1.0 / 7 + t2 / 9))));
+    return exponent * 0.6931471805599453 + ln_mantissa;
+}
+
+// e^(-x) para x >= 0 por reducción de argumento y cuadrados sucesivos
+static double profiler_exp_neg(double x) {
+    if (x > 40.0) return 0.0;
+
+    int squarings = 0;
+    while (x > 0.125) {
+        x *= 0.5;
+        squarings++;
+    }
+    double result = 1.0 - x * (1.0 - x * (0.5 - x * (1.0 / 6 - x / 24)));
+    while (squarings--) result *= result;
+    return result;
+}
+
+static int64_t profiler_next_interval(size_t interval) {
+    // Distribución exponencial de media interval: -ln(U) * interval
+    double uniform = (double)((profiler_random() >> 11) + 1) / 9007199254740993.0;
+    double next = -profiler_log(uniform) * (double)interval;
+    return next < 1.0 ? 1 : (int64_t)next;
+}
+
+// Llamada en cada asignación con el perfilador activo; devuelve 1 si se muestrea
+int profiler_sample_tick(size_t size) {
+    size_t interval = __atomic_load_n(&profiler_interval, __ATOMIC_RELAXED);
+    if (!interval) return 0;
+
+    unsigned generation = __atomic_load_n(&profiler_generation, __ATOMIC_RELAXED);
+    if (thread_generation != generation) {
+        thread_generation = generation;
+        bytes_until_sample = profiler_next_interval(interval);
+    }
+
+    bytes_until_sample -= (int64_t)size;
+    if (bytes_until_sample > 0) return 0;
+
+    bytes_until_sample = profiler_next_interval(interval);
+    return 1;
+}
+
+// =============================================================================
+// REGISTRO DE MUESTRAS VIVAS
+// =============================================================================
+
+static size_t profiler_bucket(const void* ptr) {
+    uintptr_t key = (uintptr_t)ptr;
+    key = (key ^ (key >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+    key ^= key >> 31;
+    return (size_t)(key % PROFILER_BUCKETS);
+}
+
+void profiler_record_alloc(void* ptr, size_t size, int client_id) {
+    size_t interval = __atomic_load_n(&profiler_interval, __ATOMIC_RELAXED);
+    if (!interval) return;
+
+    pthread_mutex_lock(&profiler_mutex);
+    profiler_sample_t* sample = profiler_free_samples;
+    if (sample) profiler_free_samples = sample->next;
+    else profiler_dropped_samples++;
+    pthread_mutex_unlock(&profiler_mutex);
+    if (!sample) return;
+
+    sample->ptr = ptr;
+    sample->size = size;
+    sample->client_id = client_id;
+
+    // Peso estimado: bytes que representa la muestra (corrige el sesgo a
+    // favor de los bloques grandes del muestreo por bytes)
+    double probability = 1.0 - profiler_exp_neg((double)size / (double)interval);
+    sample->weight = probability > 0.0 ? (size_t)((double)size / probability) : interval;
+
+    void* frames[PROFILER_MAX_FRAMES + PROFILER_SKIP_FRAMES];
+    int depth = backtrace(frames, PROFILER_MAX_FRAMES + PROFILER_SKIP_FRAMES);
+    depth = depth > PROFILER_SKIP_FRAMES ? depth - PROFILER_SKIP_FRAMES : 0;
+    memcpy(sample->frames, frames + PROFILER_SKIP_FRAMES, (size_t)depth * sizeof(void*));
+    sample->depth = depth;
+
+    size_t bucket = profiler_bucket(ptr);
+    pthread_mutex_lock(&profiler_mutex);
+    sample->next = profiler_buckets[bucket];
+    profiler_buckets[bucket] = sample;
+    profiler_total_samples++;
+    profiler_live_samples++;
+    profiler_live_bytes += sample->weight;
+    pthread_mutex_unlock(&profiler_mutex);
+}
+
+void profiler_record_free(void* ptr) {
+    size_t bucket = profiler_bucket(ptr);
+    profiler_sample_t* removed = NULL;
+
+    pthread_mutex_lock(&profiler_mutex);
+    for (profiler_sample_t** current = &profiler_buckets[bucket]; *current; current = &(*current)->next) {
+        if ((*current)->ptr == ptr) {
+            removed = *current;
+            *current = removed->next;
+            profiler_live_samples--;
+            profiler_live_bytes -= removed->weight;
+            removed->next = profiler_free_samples;
+            profiler_free_samples = removed;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&profiler_mutex);
+}
+
+static void profiler_clear_locked(void) {
+    for (size_t i = 0; i < PROFILER_BUCKETS; i++) {
+        profiler_sample_t* current = profiler_buckets[i];
+        while (current) {
+            profiler_sample_t* next = current->next;
+            current->next = profiler_free_samples;
+            profiler_free_samples = current;
+            current = next;
+        }
+        profiler_buckets[i] = NULL;
+    }
+    profiler_live_samples = 0;
+    profiler_live_bytes = 0;
+}
+
+// =============================================================================
+// API PÚBLICA
+// =============================================================================
+
+MEMORY_API int memory_profiler_start(size_t sample_interval) {
+    if (sample_interval == 0) return MEMORY_ERROR_INVALID_PARAM;
+
+    // La primera llamada a backtrace puede asignar memoria (carga de libgcc)
+    void* warmup[1];
+    backtrace(warmup, 1);
+
+    pthread_mutex_lock(&profiler_mutex);
+    if (!profiler_reserve) {
+        void* memory = mmap(NULL, PROFILER_MAX_SAMPLES * sizeof(profiler_sample_t),
+                            PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (memory == MAP_FAILED) {
+            pthread_mutex_unlock(&profiler_mutex);
+            return MEMORY_ERROR_OUT_OF_MEMORY;
+        }
+        profiler_reserve = memory;
+        for (size_t i = PROFILER_MAX_SAMPLES; i-- > 0;) {
+            profiler_reserve[i].next = profiler_free_samples;
+            profiler_free_samples = &profiler_reserve[i];
+        }
+    }
+    profiler_clear_locked();
+    profiler_total_samples = 0;
+    profiler_dropped_samples = 0;
+    __atomic_add_fetch(&profiler_generation, 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&profiler_interval, sample_interval, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&profiler_mutex);
+
+    MEMORY_LOG(MEMORY_LOG_INFO, "Perfilador de heap activo: una muestra cada ~%zu bytes", sample_interval);
+    return MEMORY_SUCCESS;
+}
+
+MEMORY_API void memory_profiler_stop(void) {
+    pthread_mutex_lock(&profiler_mutex);
+    __atomic_store_n(&profiler_interval, 0, __ATOMIC_RELAXED);
+    profiler_clear_locked();
+    pthread_mutex_unlock(&profiler_mutex);
+}
+
+MEMORY_API int memory_profiler_is_active(void) {
+    return __atomic_load_n(&profiler_interval, __ATOMIC_RELAXED) != 0;
+}
+
+MEMORY_API void memory_profiler_get_stats(memory_profiler_stats_t* stats) {
+    if (!stats) return;
+
+    pthread_mutex_lock(&profiler_mutex);
+    stats->sample_interval = profiler_interval;
+    stats->total_samples = profiler_total_samples;
+    stats->live_samples = profiler_live_samples;
+    stats->live_bytes_estimate = profiler_live_bytes;
+    stats->dropped_samples = profiler_dropped_samples;
+    pthread_mutex_unlock(&profiler_mutex);
+}
+
+// Nombre de función de una línea de backtrace_symbols: "bin(func+0x1a) [0x...]"
+static void profiler_frame_name(const char* symbol, void* address, char* out, size_t out_size) {
+    const char* open = symbol ? strchr(symbol, '(') : NULL;
+    if (open && open[1] != '+' && open[1] != ')') {
+        size_t length = strcspn(open + 1, "+)");
+        if (length >= out_size) length = out_size - 1;
+        memcpy(out, open + 1, length);
+        out[length] = '\0';
+        return;
+    }
+    snprintf(out, out_size, "%p", address);
+}
+
+static void profiler_dump_collapsed(FILE* out, const profiler_sample_t* sample) {
+    char** symbols = backtrace_symbols((void* const*)sample->frames, sample->depth);
+
+    // Raíz del stack primero; el cliente propietario como frame raíz
+    fprintf(out, "client_%d", sample->client_id);
+    for (int i = sample->depth - 1; i >= 0; i--) {
+        char name[256];
+        profiler_frame_name(symbols ? symbols[i] : NULL, sample->frames[i], name, sizeof(name));
+        fprintf(out, ";%s", name);
+    }
+    fprintf(out, " %zu\n", sample->weight);
+
+    free(symbols);
+}
+
+static void profiler_dump_pprof_maps(FILE* out) {
+    fprintf(out, "\nMAPPED_LIBRARIES:\n");
+
+    FILE* maps = fopen("/proc/self/maps", "r");
+    if (!maps) return;
+
+    char buffer[4096];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), maps)) > 0) {
+        fwrite(buffer, 1, read, out);
+    }
+    fclose(maps);
+}
+
+// Copia las muestras vivas a memoria propia: backtrace_symbols y stdio
+// asignan con malloc, que con LD_PRELOAD es el pool, y el pool notifica las
+// liberaciones con su mutex tomado. Sin esta copia, volcar con el mutex del
+// perfilador tomado podría bloquearse contra un free en curso.
+static profiler_sample_t* profiler_snapshot(size_t* count, size_t* interval) {
+    pthread_mutex_lock(&profiler_mutex);
+    *count = profiler_live_samples;
+    *interval = profiler_interval;
+
+    profiler_sample_t* copy = NULL;
+    if (*count) {
+        copy = mmap(NULL, *count * sizeof(profiler_sample_t), PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (copy == MAP_FAILED) {
+            copy = NULL;
+        } else {
+            size_t n = 0;
+            for (size_t i = 0; i < PROFILER_BUCKETS; i++) {
+                for (profiler_sample_t* s = profiler_buckets[i]; s; s = s->next) copy[n++] = *s;
+            }
+        }
+    }
+    pthread_mutex_unlock(&profiler_mutex);
+    return copy;
+}
+
+MEMORY_API int memory_profiler_dump(FILE* out, memory_profile_format_t format) {
+    if (!out) return MEMORY_ERROR_INVALID_PARAM;
+
+    size_t count, interval;
+    profiler_sample_t* samples = profiler_snapshot(&count, &interval);
+    if (count && !samples) return MEMORY_ERROR_OUT_OF_MEMORY;
+
+    if (format == MEMORY_PROFILE_PPROF) {
+        size_t raw_bytes = 0;
+        for (size_t i = 0; i < count; i++) raw_bytes += samples[i].size;
+
+        // heap_v2: pprof corrige el muestreo a partir del intervalo
+        fprintf(out, "heap profile: %zu: %zu [%zu: %zu] @ heap_v2/%zu\n",
+                count, raw_bytes, count, raw_bytes, interval);
+        for (size_t i = 0; i < count; i++) {
+            fprintf(out, "1: %zu [1: %zu] @", samples[i].size, samples[i].size);
+            for (int f = 0; f < samples[i].depth; f++) fprintf(out, " %p", samples[i].frames[f]);
+            fprintf(out, "\n");
+        }
+        profiler_dump_pprof_maps(out);
+    } else {
+        for (size_t i = 0; i < count; i++) profiler_dump_collapsed(out, &samples[i]);
+    }
+
+    if (samples) munmap(samples, count * sizeof(profiler_sample_t));
+    return MEMORY_SUCCESS;
+}
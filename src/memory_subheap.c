@@ -0,0 +1,214 @@
+#include "memory_internal.h"
+#include "../include/memory_client.h"
+#include "../include/memory_trace.h"
+#include "../include/memory_kernels.h"
+#include <string.h>
+
+// =============================================================================
+// SUB-HEAP PRIVADO DEL CLIENTE
+// =============================================================================
+// El cliente reserva tramos (spans) del pool y reparte dentro de ellos
+// asignaciones pequeñas por clases de potencia de dos (16 B .. 1 KiB), con un
+// puntero de avance y listas libres por tramo. Ni el mutex del pool ni el del
+// cliente se toman: solo es válido si un único hilo usa el cliente. El pool
+// solo interviene para obtener un tramo nuevo o recibir uno vacío.
+
+#define SUBHEAP_MIN_CLASS_SHIFT 4
+#define SUBHEAP_CLASSES 7
+#define SUBHEAP_MAX_SIZE ((size_t)1 << (SUBHEAP_MIN_CLASS_SHIFT + SUBHEAP_CLASSES - 1))
+#define SUBHEAP_MIN_SPAN 4096
+#define SUBHEAP_SPAN_OWNER (-3)        // client_id de los tramos en el pool
+#define SUBHEAP_NOT_OWNED 1
+
+#define SLOT_MAGIC_USED 0x5B0CCA11u
+#define SLOT_MAGIC_FREE 0x5B0CF8EEu
+
+typedef struct {
+    uint32_t magic;
+    uint16_t cls;
+    uint16_t reserved;
+} subheap_slot_t;
+
+#define SLOT_HEADER_SIZE ALIGN_SIZE(sizeof(subheap_slot_t))
+#define SLOT_PAYLOAD(slot) ((void*)((char*)(slot) + SLOT_HEADER_SIZE))
+
+struct client_span {
+    client_span_t* next;
+    char* start;
+    char* bump;
+    char* end;
+    size_t live;
+    subheap_slot_t* free_lists[SUBHEAP_CLASSES];
+};
+
+#define SPAN_HEADER_SIZE ALIGN_SIZE(sizeof(client_span_t))
+
+static inline int subheap_class(size_t size) {
+    if (size <= ((size_t)1 << SUBHEAP_MIN_CLASS_SHIFT)) return 0;
+    return 64 - __builtin_clzll((unsigned long long)(size - 1)) - SUBHEAP_MIN_CLASS_SHIFT;
+}
+
+static inline size_t subheap_class_size(int cls) {
+    return (size_t)1 << (cls + SUBHEAP_MIN_CLASS_SHIFT);
+}
+
+static client_span_t* subheap_refill(memory_client_t* client) {
+    // Un tramo afín ocupa líneas de caché completas: sus bordes no tocan
+    // bloques de otros clientes
+    void* memory = (client->flags & MEMORY_CLIENT_FLAG_AFFINE)
+        ? memory_pool_alloc_aligned(client->pool, MEMORY_CACHE_LINE, client->span_size, SUBHEAP_SPAN_OWNER)
+        : memory_pool_alloc(client->pool, client->span_size, SUBHEAP_SPAN_OWNER);
+    if (!memory) {
+        MEMORY_LOG(MEMORY_LOG_WARN, "Cliente %d: sin tramo de %zu bytes para su sub-heap",
+                   client->id, client->span_size);
+        return NULL;
+    }
+
+    client_span_t* span = memory;
+    span->start = (char*)memory + SPAN_HEADER_SIZE;
+    span->bump = span->start;
+    span->end = (char*)memory + client->span_size;
+    span->live = 0;
+    memset(span->free_lists, 0, sizeof(span->free_lists));
+
+    span->next = client->spans;
+    client->spans = span;
+
+    MEMORY_LOG(MEMORY_LOG_DEBUG, "Cliente %d reservó tramo %p (%zu bytes)",
+               client->id, (void*)span, client->span_size);
+    return span;
+}
+
+static void* span_alloc(client_span_t* span, int cls) {
+    subheap_slot_t* slot = span->free_lists[cls];
+    if (slot) {
+        span->free_lists[cls] = *(subheap_slot_t**)SLOT_PAYLOAD(slot);
+    } else {
+        size_t needed = SLOT_HEADER_SIZE + subheap_class_size(cls);
+        if ((size_t)(span->end - span->bump) < needed) return NULL;
+        slot = (subheap_slot_t*)span->bump;
+        span->bump += needed;
+        slot->cls = (uint16_t)cls;
+        slot->reserved = 0;
+    }
+
+    slot->magic = SLOT_MAGIC_USED;
+    span->live++;
+    return SLOT_PAYLOAD(slot);
+}
+
+static client_span_t* subheap_find_span(const memory_client_t* client, const void* ptr) {
+    client_span_t* active = client->active_span;
+    if (active && (const char*)ptr >= active->start && (const char*)ptr < active->bump) {
+        return active;
+    }
+    for (client_span_t* span = client->spans; span; span = span->next) {
+        if ((const char*)ptr >= span->start && (const char*)ptr < span->bump) return span;
+    }
+    return NULL;
+}
+
+static void subheap_return_span(memory_client_t* client, client_span_t* span) {
+    for (client_span_t** link = &client->spans; *link; link = &(*link)->next) {
+        if (*link == span) {
+            *link = span->next;
+            break;
+        }
+    }
+    if (client->active_span == span) client->active_span = NULL;
+    memory_pool_free(client->pool, span, SUBHEAP_SPAN_OWNER);
+}
+
+// =============================================================================
+// INTERFAZ INTERNA (usada por memory_client.c)
+// =============================================================================
+
+int subheap_enable(memory_client_t* client, size_t span_size) {
+    client->flags |= MEMORY_CLIENT_FLAG_SUBHEAP;
+    client->span_size = ALIGN_SIZE(span_size > SUBHEAP_MIN_SPAN ? span_size : SUBHEAP_MIN_SPAN);
+    if (client->flags & MEMORY_CLIENT_FLAG_AFFINE) client->span_size = affine_size(client->span_size);
+
+    client_span_t* span = subheap_refill(client);
+    if (!span) return MEMORY_ERROR_OUT_OF_MEMORY;
+
+    client->active_span = span;
+    return MEMORY_SUCCESS;
+}
+
+void* subheap_alloc(memory_client_t* client, size_t size) {
+    if (size == 0 || size > SUBHEAP_MAX_SIZE) return NULL;
+
+    int cls = subheap_class(size);
+    client_span_t* span = client->active_span;
+    void* ptr = span ? span_alloc(span, cls) : NULL;
+
+    if (!ptr) {
+        // Huecos de esta clase en otro tramo antes de pedir uno nuevo al pool
+        for (span = client->spans; span; span = span->next) {
+            if (span != client->active_span && (ptr = span_alloc(span, cls))) break;
+        }
+        if (!ptr) {
+            span = subheap_refill(client);
+            if (!span) return NULL;
+            ptr = span_alloc(span, cls);
+        }
+        client->active_span = span;
+    }
+
+    client->subheap_live++;
+    memory_zero(ptr, size);
+
+    if (__atomic_load_n(&trace_active, __ATOMIC_RELAXED)) {
+        trace_record(MEMORY_TRACE_ALLOC, ptr, NULL, size, client->id);
+    }
+    return ptr;
+}
+
+// Devuelve SUBHEAP_NOT_OWNED si ptr no pertenece a ningún tramo del cliente
+int subheap_free(memory_client_t* client, void* ptr) {
+    // Todo hueco lleva su magic justo antes de los datos; en un bloque del
+    // pool ahí está el client_id del header. Sin magic de hueco el puntero
+    // no es del sub-heap y no hace falta recorrer los tramos. Los bloques de
+    // la región de guarda pueden empezar en el borde de una página protegida.
+    uint32_t tag;
+    if (guard_owns(ptr)) return SUBHEAP_NOT_OWNED;
+    memcpy(&tag, (const char*)ptr - SLOT_HEADER_SIZE, sizeof(tag));
+    if (tag != SLOT_MAGIC_USED && tag != SLOT_MAGIC_FREE) return SUBHEAP_NOT_OWNED;
+
+    client_span_t* span = subheap_find_span(client, ptr);
+    if (!span) return SUBHEAP_NOT_OWNED;
+
+    subheap_slot_t* slot = (subheap_slot_t*)((char*)ptr - SLOT_HEADER_SIZE);
+    if (slot->magic == SLOT_MAGIC_FREE) {
+        MEMORY_LOG(MEMORY_LOG_WARN, "Bloque ya libre en sub-heap: %p", ptr);
+        return MEMORY_SUCCESS;
+    }
+    if (slot->magic != SLOT_MAGIC_USED || slot->cls >= SUBHEAP_CLASSES) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "Bloque corrupto en sub-heap: %p", ptr);
+        return MEMORY_ERROR_CORRUPTION;
+    }
+
+    if (__atomic_load_n(&trace_active, __ATOMIC_RELAXED)) {
+        trace_record(MEMORY_TRACE_FREE, ptr, NULL, 0, client->id);
+    }
+
+    slot->magic = SLOT_MAGIC_FREE;
+    *(subheap_slot_t**)ptr = span->free_lists[slot->cls];
+    span->free_lists[slot->cls] = slot;
+    span->live--;
+    client->subheap_live--;
+
+    // Un tramo vacío que no es el activo vuelve al pool
+    if (span->live == 0 && span != client->active_span) {
+        subheap_return_span(client, span);
+    }
+    return MEMORY_SUCCESS;
+}
+
+void subheap_release_all(memory_client_t* client) {
+    while (client->spans) {
+        subheap_return_span(client, client->spans);
+    }
+    client->active_span = NULL;
+    client->subheap_live = 0;
+}
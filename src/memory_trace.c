@@ -0,0 +1,262 @@
+#include "memory_internal.h"
+#include "../include/memory_trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+
+// =============================================================================
+// BUFFER CIRCULAR MPSC
+// =============================================================================
+// Cola acotada multi-productor / un consumidor: cada celda lleva un número de
+// secuencia que indica si está libre para el productor de esa vuelta o lista
+// para el consumidor. Los productores nunca esperan: con el buffer lleno el
+// evento se descarta.
+
+#define TRACE_DEFAULT_CAPACITY 65536
+#define TRACE_FLUSH_BATCH 1024
+#define TRACE_IDLE_SLEEP_NS 1000000
+
+typedef struct {
+    size_t sequence;
+    memory_trace_event_t event;
+} trace_cell_t;
+
+typedef struct {
+    trace_cell_t* cells;
+    size_t mask;
+    size_t enqueue_pos;
+    size_t dequeue_pos;
+} trace_ring_t;
+
+// Activo: los hooks de alloc/free consultan este flag antes de registrar
+int trace_active = 0;
+
+static pthread_mutex_t trace_mutex = PTHREAD_MUTEX_INITIALIZER;
+static trace_ring_t trace_ring;
+static FILE* trace_file = NULL;
+static pthread_t trace_flusher;
+static int trace_running = 0;
+static int trace_writers = 0;
+static uint64_t trace_start_ns = 0;
+static size_t trace_recorded = 0;
+static size_t trace_dropped = 0;
+static size_t trace_written = 0;
+// Índices de hilo por traza: cada memory_trace_start abre una generación y
+// los hilos renumeran al ver una distinta de la suya
+static unsigned trace_generation = 0;
+static uint32_t trace_next_thread = 0;
+
+static __thread unsigned trace_thread_generation = 0;
+static __thread uint32_t trace_thread_index = 0;
+
+static int trace_ring_push(trace_ring_t* ring, const memory_trace_event_t* event) {
+    size_t pos = __atomic_load_n(&ring->enqueue_pos, __ATOMIC_RELAXED);
+    trace_cell_t* cell;
+
+    for (;;) {
+        cell = &ring->cells[pos & ring->mask];
+        size_t sequence = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&ring->enqueue_pos, &pos, pos + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return 0;   // lleno
+        } else {
+            pos = __atomic_load_n(&ring->enqueue_pos, __ATOMIC_RELAXED);
+        }
+    }
+
+    cell->event = *event;
+    __atomic_store_n(&cell->sequence, pos + 1, __ATOMIC_RELEASE);
+    return 1;
+}
+
+static int trace_ring_pop(trace_ring_t* ring, memory_trace_event_t* event) {
+    size_t pos = ring->dequeue_pos;
+    trace_cell_t* cell = &ring->cells[pos & ring->mask];
+
+    if (__atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE) != pos + 1) return 0;
+
+    *event = cell->event;
+    __atomic_store_n(&cell->sequence, pos + ring->mask + 1, __ATOMIC_RELEASE);
+    ring->dequeue_pos = pos + 1;
+    return 1;
+}
+
+// =============================================================================
+// HILO DE VOLCADO
+// =============================================================================
+
+static size_t trace_drain(memory_trace_event_t* batch) {
+    size_t count = 0;
+    while (count < TRACE_FLUSH_BATCH && trace_ring_pop(&trace_ring, &batch[count])) {
+        count++;
+    }
+    if (count) {
+        size_t written = fwrite(batch, sizeof(memory_trace_event_t), count, trace_file);
+        __atomic_add_fetch(&trace_written, written, __ATOMIC_RELAXED);
+    }
+    return count;
+}
+
+static void* trace_flusher_main(void* arg) {
+    (void)arg;
+    memory_trace_event_t* batch = malloc(TRACE_FLUSH_BATCH * sizeof(memory_trace_event_t));
+    if (!batch) return NULL;
+
+    struct timespec idle = {0, TRACE_IDLE_SLEEP_NS};
+    while (__atomic_load_n(&trace_running, __ATOMIC_ACQUIRE)) {
+        if (!trace_drain(batch)) nanosleep(&idle, NULL);
+    }
+
+    // Vaciado final: ya no quedan productores activos
+    while (trace_drain(batch)) {
+    }
+
+    free(batch);
+    return NULL;
+}
+
+// =============================================================================
+// REGISTRO DE EVENTOS (llamado desde los caminos de alloc/free)
+// =============================================================================
+
+void trace_record(uint8_t type, const void* address, const void* old_address,
+                  size_t size, int client_id) {
+    __atomic_add_fetch(&trace_writers, 1, __ATOMIC_SEQ_CST);
+
+    // Comprobación repetida: memory_trace_stop espera a trace_writers == 0
+    // antes de liberar el buffer
+    if (__atomic_load_n(&trace_active, __ATOMIC_SEQ_CST)) {
+        unsigned generation = __atomic_load_n(&trace_generation, __ATOMIC_RELAXED);
+        if (trace_thread_generation != generation) {
+            trace_thread_generation = generation;
+            trace_thread_index = __atomic_add_fetch(&trace_next_thread, 1, __ATOMIC_RELAXED);
+        }
+
+        memory_trace_event_t event;
+        event.timestamp_ns = memory_now_ns() - trace_start_ns;
+        event.address = (uint64_t)(uintptr_t)address;
+        event.old_address = (uint64_t)(uintptr_t)old_address;
+        event.size = size;
+        event.client_id = client_id;
+        event.thread = trace_thread_index;
+        event.type = type;
+        memset(event.reserved, 0, sizeof(event.reserved));
+
+        if (trace_ring_push(&trace_ring, &event)) {
+            __atomic_add_fetch(&trace_recorded, 1, __ATOMIC_RELAXED);
+        } else {
+            __atomic_add_fetch(&trace_dropped, 1, __ATOMIC_RELAXED);
+        }
+    }
+
+    __atomic_sub_fetch(&trace_writers, 1, __ATOMIC_RELEASE);
+}
+
+// =============================================================================
+// API PÚBLICA
+// =============================================================================
+
+MEMORY_API int memory_trace_start(const char* path, size_t ring_capacity) {
+    if (!path) return MEMORY_ERROR_INVALID_PARAM;
+
+    pthread_mutex_lock(&trace_mutex);
+    if (trace_active) {
+        pthread_mutex_unlock(&trace_mutex);
+        MEMORY_LOG(MEMORY_LOG_ERROR, "El tracer ya está activo");
+        return MEMORY_ERROR_INVALID_PARAM;
+    }
+
+    // Capacidad redondeada a potencia de dos
+    size_t capacity = 2;
+    size_t requested = ring_capacity ? ring_capacity : TRACE_DEFAULT_CAPACITY;
+    while (capacity < requested) capacity <<= 1;
+
+    trace_ring.cells = malloc(capacity * sizeof(trace_cell_t));
+    if (!trace_ring.cells) {
+        pthread_mutex_unlock(&trace_mutex);
+        return MEMORY_ERROR_OUT_OF_MEMORY;
+    }
+    for (size_t i = 0; i < capacity; i++) trace_ring.cells[i].sequence = i;
+    trace_ring.mask = capacity - 1;
+    trace_ring.enqueue_pos = 0;
+    trace_ring.dequeue_pos = 0;
+
+    trace_file = fopen(path, "wb");
+    if (!trace_file) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "No se pudo crear el archivo de traza %s", path);
+        free(trace_ring.cells);
+        pthread_mutex_unlock(&trace_mutex);
+        return MEMORY_ERROR_INVALID_PARAM;
+    }
+
+    trace_start_ns = memory_now_ns();
+    memory_trace_file_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MEMORY_TRACE_MAGIC, sizeof(MEMORY_TRACE_MAGIC));
+    header.version = MEMORY_TRACE_VERSION;
+    header.event_size = sizeof(memory_trace_event_t);
+    header.start_time_ns = trace_start_ns;
+    fwrite(&header, sizeof(header), 1, trace_file);
+
+    trace_recorded = trace_dropped = trace_written = 0;
+    trace_next_thread = 0;
+    __atomic_add_fetch(&trace_generation, 1, __ATOMIC_RELAXED);
+    trace_running = 1;
+    if (pthread_create(&trace_flusher, NULL, trace_flusher_main, NULL) != 0) {
+        fclose(trace_file);
+        trace_file = NULL;
+        free(trace_ring.cells);
+        trace_running = 0;
+        pthread_mutex_unlock(&trace_mutex);
+        return MEMORY_ERROR_OUT_OF_MEMORY;
+    }
+
+    __atomic_store_n(&trace_active, 1, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&trace_mutex);
+
+    MEMORY_LOG(MEMORY_LOG_INFO, "Traza de asignaciones activa en %s (%zu eventos de buffer)",
+               path, capacity);
+    return MEMORY_SUCCESS;
+}
+
+MEMORY_API int memory_trace_stop(void) {
+    pthread_mutex_lock(&trace_mutex);
+    if (!trace_active) {
+        pthread_mutex_unlock(&trace_mutex);
+        return MEMORY_ERROR_INVALID_PARAM;
+    }
+
+    __atomic_store_n(&trace_active, 0, __ATOMIC_SEQ_CST);
+    while (__atomic_load_n(&trace_writers, __ATOMIC_SEQ_CST)) sched_yield();
+
+    __atomic_store_n(&trace_running, 0, __ATOMIC_RELEASE);
+    pthread_join(trace_flusher, NULL);
+
+    int result = fclose(trace_file) == 0 ? MEMORY_SUCCESS : MEMORY_ERROR_CORRUPTION;
+    trace_file = NULL;
+    free(trace_ring.cells);
+    trace_ring.cells = NULL;
+    pthread_mutex_unlock(&trace_mutex);
+
+    MEMORY_LOG(MEMORY_LOG_INFO, "Traza cerrada: %zu eventos escritos, %zu descartados",
+               trace_written, trace_dropped);
+    return result;
+}
+
+MEMORY_API int memory_trace_is_active(void) {
+    return __atomic_load_n(&trace_active, __ATOMIC_RELAXED);
+}
+
+MEMORY_API void memory_trace_get_stats(memory_trace_stats_t* stats) {
+    if (!stats) return;
+    stats->recorded_events = __atomic_load_n(&trace_recorded, __ATOMIC_RELAXED);
+    stats->dropped_events = __atomic_load_n(&trace_dropped, __ATOMIC_RELAXED);
+    stats->written_events = __atomic_load_n(&trace_written, __ATOMIC_RELAXED);
+}
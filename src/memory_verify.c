@@ -0,0 +1,312 @@
+#include "memory_internal.h"
+#include "../include/memory_verify.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+// =============================================================================
+// ESTADO DEL RECORRIDO
+// =============================================================================
+// El cursor vive en el pool (verify_cursor) para que block_retire lo corrija
+// sin indirecciones; el resto del estado se crea en el primer uso. Los
+// contadores y el manejador se protegen con el mutex del pool.
+
+struct pool_verify {
+    size_t passes_completed;
+    size_t blocks_checked;
+    size_t errors;
+    memory_verify_error_fn handler;
+    void* user_data;
+
+    // Hilo de fondo
+    pthread_mutex_t thread_mutex;
+    pthread_cond_t thread_cond;
+    pthread_t thread;
+    int running;
+    size_t blocks_per_step;
+    unsigned interval_ms;
+};
+
+// Crea el estado del pool si aún no existe
+static struct pool_verify* verify_state(memory_pool_t* pool) {
+    pool_lock(pool);
+    struct pool_verify* state = pool->verify;
+    if (!state) {
+        state = calloc(1, sizeof(struct pool_verify));
+        if (state) {
+            pthread_mutex_init(&state->thread_mutex, NULL);
+            pthread_cond_init(&state->thread_cond, NULL);
+            pool->verify = state;
+        }
+    }
+    pool_unlock(pool);
+    return state;
+}
+
+static void verify_error(memory_pool_t* pool, struct pool_verify* state,
+                         const block_header_t* block, const char* reason) {
+    state->errors++;
+    MEMORY_LOG(MEMORY_LOG_ERROR, "Verificación incremental: %s en bloque %p (desplazamiento %zu)",
+               reason, (const void*)block, block_to_offset(pool, block));
+    if (state->handler) state->handler(pool, block, reason, state->user_data);
+}
+
+// Enlace de la lista libre que debe apuntar a un header libre y válido
+static int verify_link(const memory_pool_t* pool, size_t offset) {
+    if (offset > pool->total_size - sizeof(block_header_t)) return 0;
+    const block_header_t* linked = block_from_offset(pool, offset);
+    return block_is_valid(linked) && !linked->used;
+}
+
+// Comprobaciones de un bloque libre: fusión con el anterior y pertenencia a
+// la lista de su clase (enlaces en ambos sentidos)
+static int verify_free_block(memory_pool_t* pool, struct pool_verify* state,
+                             const block_header_t* block, int previous_free) {
+    int errors = 0;
+    size_t offset = block_to_offset(pool, block);
+    int cls = size_class(block->size);
+
+    if (previous_free) {
+        verify_error(pool, state, block, "bloques libres contiguos sin fusionar");
+        errors++;
+    }
+
+    if (block->prev == BLOCK_OFFSET_NULL) {
+        if (pool->free_lists[cls] != block) {
+            verify_error(pool, state, block, "bloque libre fuera de la lista de su clase");
+            errors++;
+        }
+    } else if (!verify_link(pool, block->prev) || block_get_prev(pool, block)->next != offset) {
+        verify_error(pool, state, block, "enlace prev de la lista libre inconsistente");
+        errors++;
+    }
+
+    if (block->next != BLOCK_OFFSET_NULL &&
+        (!verify_link(pool, block->next) || block_get_next(pool, block)->prev != offset)) {
+        verify_error(pool, state, block, "enlace next de la lista libre inconsistente");
+        errors++;
+    }
+
+    if (!(pool->free_class_mask & (UINT64_C(1) << cls))) {
+        verify_error(pool, state, block, "clase sin marcar en la máscara de listas");
+        errors++;
+    }
+    return errors;
+}
+
+// Un tramo de como mucho max_blocks bloques con el mutex tomado. Termina antes
+// si completa el recorrido; un header ilegible reinicia el recorrido.
+static int verify_slice(memory_pool_t* pool, struct pool_verify* state, size_t max_blocks) {
+    pool_lock(pool);
+    if (!pool->active) {
+        pool_unlock(pool);
+        return 0;
+    }
+
+    int errors = 0;
+    // Entre tramos el bloque anterior puede haber cambiado: no se arrastra
+    int previous_free = 0;
+
+    for (size_t n = 0; n < max_blocks; n++) {
+        size_t offset = pool->verify_cursor;
+        if (offset + sizeof(block_header_t) > pool->total_size) {
+            if (offset != pool->total_size) {
+                verify_error(pool, state, block_from_offset(pool, offset), "el último bloque no cierra el pool");
+                errors++;
+            }
+            pool->verify_cursor = 0;
+            state->blocks_checked = 0;
+            state->passes_completed++;
+            break;
+        }
+
+        block_header_t* block = block_from_offset(pool, offset);
+        const char* fatal = NULL;
+        if (!block_is_valid(block)) {
+            fatal = "header con magic inválido";
+        } else if (block->size > pool->total_size - offset - sizeof(block_header_t)) {
+            fatal = "tamaño de bloque fuera del pool";
+        }
+        if (fatal) {
+            verify_error(pool, state, block, fatal);
+            errors++;
+            pool->verify_cursor = 0;
+            state->blocks_checked = 0;
+            break;
+        }
+
+        if (block->used > 1) {
+            verify_error(pool, state, block, "estado de uso inválido");
+            errors++;
+        } else if (!block->used) {
+            errors += verify_free_block(pool, state, block, previous_free);
+        }
+
+        previous_free = !block->used;
+        state->blocks_checked++;
+        pool->verify_cursor = offset + sizeof(block_header_t) + block->size;
+    }
+
+    pool_unlock(pool);
+    return errors;
+}
+
+static void verify_read_progress(memory_pool_t* pool, memory_verify_progress_t* progress) {
+    pool_lock(pool);
+    const struct pool_verify* state = pool->verify;
+    if (state) {
+        progress->passes_completed += state->passes_completed;
+        progress->blocks_checked += state->blocks_checked;
+        progress->errors += state->errors;
+        progress->bytes_checked += pool->verify_cursor;
+    }
+    progress->total_bytes += pool->total_size;
+    pool_unlock(pool);
+}
+
+// =============================================================================
+// API PÚBLICA
+// =============================================================================
+
+// En un grupo cada pool miembro avanza su propio recorrido; el progreso es
+// la suma de los miembros
+MEMORY_API int memory_pool_verify_step(void* pool_ptr, size_t max_blocks, memory_verify_progress_t* progress) {
+    memory_pool_t* pool = (memory_pool_t*)pool_ptr;
+    if (!pool || max_blocks == 0) return -1;
+
+    int errors = 0;
+    if (pool->group) {
+        memory_pool_t* member;
+        for (size_t i = 0; (member = pool_group_member(pool, i)); i++) {
+            int member_errors = memory_pool_verify_step(member, max_blocks, NULL);
+            if (member_errors < 0) return member_errors;
+            errors += member_errors;
+        }
+    } else {
+        struct pool_verify* state = verify_state(pool);
+        if (!state) return -1;
+        errors = verify_slice(pool, state, max_blocks);
+    }
+
+    if (progress) memory_pool_verify_get_progress(pool, progress);
+    return errors;
+}
+
+MEMORY_API void memory_pool_verify_get_progress(void* pool_ptr, memory_verify_progress_t* progress) {
+    memory_pool_t* pool = (memory_pool_t*)pool_ptr;
+    if (!progress) return;
+
+    memset(progress, 0, sizeof(memory_verify_progress_t));
+    if (!pool) return;
+
+    if (pool->group) {
+        memory_pool_t* member;
+        for (size_t i = 0; (member = pool_group_member(pool, i)); i++) verify_read_progress(member, progress);
+    } else {
+        verify_read_progress(pool, progress);
+    }
+}
+
+MEMORY_API int memory_pool_verify_set_handler(void* pool_ptr, memory_verify_error_fn handler, void* user_data) {
+    memory_pool_t* pool = (memory_pool_t*)pool_ptr;
+    if (!pool) return MEMORY_ERROR_INVALID_PARAM;
+
+    if (pool->group) {
+        memory_pool_t* member;
+        for (size_t i = 0; (member = pool_group_member(pool, i)); i++) {
+            int result = memory_pool_verify_set_handler(member, handler, user_data);
+            if (result != MEMORY_SUCCESS) return result;
+        }
+        return MEMORY_SUCCESS;
+    }
+
+    struct pool_verify* state = verify_state(pool);
+    if (!state) return MEMORY_ERROR_OUT_OF_MEMORY;
+
+    pool_lock(pool);
+    state->handler = handler;
+    state->user_data = user_data;
+    pool_unlock(pool);
+    return MEMORY_SUCCESS;
+}
+
+static void* verify_thread_main(void* arg) {
+    memory_pool_t* pool = arg;
+    struct pool_verify* state = pool->verify;
+
+    pthread_mutex_lock(&state->thread_mutex);
+    while (state->running) {
+        pthread_mutex_unlock(&state->thread_mutex);
+        memory_pool_verify_step(pool, state->blocks_per_step, NULL);
+        pthread_mutex_lock(&state->thread_mutex);
+
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        uint64_t nanoseconds = (uint64_t)deadline.tv_nsec + (uint64_t)state->interval_ms * 1000000;
+        deadline.tv_sec += (time_t)(nanoseconds / 1000000000);
+        deadline.tv_nsec = (long)(nanoseconds % 1000000000);
+        while (state->running &&
+               pthread_cond_timedwait(&state->thread_cond, &state->thread_mutex, &deadline) != ETIMEDOUT) {
+        }
+    }
+    pthread_mutex_unlock(&state->thread_mutex);
+    return NULL;
+}
+
+MEMORY_API int memory_pool_verify_start(void* pool_ptr, size_t blocks_per_step, unsigned interval_ms) {
+    memory_pool_t* pool = (memory_pool_t*)pool_ptr;
+    if (!pool || blocks_per_step == 0) return MEMORY_ERROR_INVALID_PARAM;
+    if (pool->unsynchronized) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "Un pool sin sincronizar no admite el verificador en segundo plano");
+        return MEMORY_ERROR_INVALID_PARAM;
+    }
+
+    struct pool_verify* state = verify_state(pool);
+    if (!state) return MEMORY_ERROR_OUT_OF_MEMORY;
+
+    pthread_mutex_lock(&state->thread_mutex);
+    if (state->running) {
+        pthread_mutex_unlock(&state->thread_mutex);
+        MEMORY_LOG(MEMORY_LOG_ERROR, "El verificador incremental ya está activo");
+        return MEMORY_ERROR_INVALID_PARAM;
+    }
+
+    state->blocks_per_step = blocks_per_step;
+    state->interval_ms = interval_ms;
+    state->running = 1;
+    if (pthread_create(&state->thread, NULL, verify_thread_main, pool) != 0) {
+        state->running = 0;
+        pthread_mutex_unlock(&state->thread_mutex);
+        return MEMORY_ERROR_OUT_OF_MEMORY;
+    }
+    pthread_mutex_unlock(&state->thread_mutex);
+
+    MEMORY_LOG(MEMORY_LOG_INFO, "Verificador incremental activo: %zu bloques cada %u ms",
+               blocks_per_step, interval_ms);
+    return MEMORY_SUCCESS;
+}
+
+MEMORY_API void memory_pool_verify_stop(void* pool_ptr) {
+    memory_pool_t* pool = (memory_pool_t*)pool_ptr;
+    if (!pool || !pool->verify) return;
+
+    struct pool_verify* state = pool->verify;
+    pthread_mutex_lock(&state->thread_mutex);
+    int was_running = state->running;
+    state->running = 0;
+    pthread_cond_signal(&state->thread_cond);
+    pthread_mutex_unlock(&state->thread_mutex);
+
+    if (was_running) pthread_join(state->thread, NULL);
+}
+
+// Detiene el hilo y libera el estado (antes de destruir el pool)
+void pool_verify_release(memory_pool_t* pool) {
+    if (!pool->verify) return;
+
+    memory_pool_verify_stop(pool);
+    pthread_mutex_destroy(&pool->verify->thread_mutex);
+    pthread_cond_destroy(&pool->verify->thread_cond);
+    free(pool->verify);
+    pool->verify = NULL;
+}
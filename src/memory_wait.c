@@ -0,0 +1,223 @@
+#include "memory_internal.h"
+#include <stdlib.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+// =============================================================================
+// ESPERA DE MEMORIA
+// =============================================================================
+// Los hilos que esperan forman una cola FIFO de nodos que viven en su propia
+// pila, cada uno con su condvar: solo la cabeza intenta asignar y, al salir
+// (con memoria o por timeout), cede el turno a la siguiente. Cada liberación
+// despierta únicamente a la cabeza, así que una ráfaga se convierte en una
+// cola en lugar de una tormenta de reintentos.
+//
+// La cola tiene su propio mutex: el intento pasa por la API pública (sub-heap,
+// guarda, traza) y no puede hacerse con el del pool tomado. Una liberación
+// solo mira dos contadores atómicos si nadie espera.
+//
+// Para bucles de eventos: un intento asíncrono fallido arma un eventfd que la
+// siguiente liberación vuelve legible.
+
+typedef struct wait_node {
+    struct wait_node* next;
+    pthread_cond_t cond;
+    int signaled;                   // turno concedido: puede intentar asignar
+} wait_node_t;
+
+struct pool_wait {
+    pthread_mutex_t mutex;
+    wait_node_t* head;
+    wait_node_t* tail;
+    int waiters;                    // nodos en la cola (lectura atómica)
+    int armed;                      // un intento asíncrono espera el eventfd
+    int event_fd;
+};
+
+// Crea el estado del pool si aún no existe
+static struct pool_wait* wait_state(memory_pool_t* pool) {
+    struct pool_wait* state = __atomic_load_n(&pool->waits, __ATOMIC_ACQUIRE);
+    if (state) return state;
+
+    pool_lock(pool);
+    state = pool->waits;
+    if (!state) {
+        state = calloc(1, sizeof(struct pool_wait));
+        if (state) {
+            pthread_mutex_init(&state->mutex, NULL);
+            state->event_fd = -1;
+            __atomic_store_n(&pool->waits, state, __ATOMIC_RELEASE);
+        }
+    }
+    pool_unlock(pool);
+    return state;
+}
+
+static void wait_signal_event(struct pool_wait* state) {
+    if (__atomic_exchange_n(&state->armed, 0, __ATOMIC_SEQ_CST) && state->event_fd >= 0) {
+        uint64_t one = 1;
+        ssize_t written = write(state->event_fd, &one, sizeof(one));
+        (void)written;      // ya legible: el contador no se desborda en la práctica
+    }
+}
+
+// Llamada tras cada liberación (ver pool_release_notify)
+void pool_wait_notify(memory_pool_t* pool) {
+    struct pool_wait* state = pool->waits;
+
+    // Esta carga y el incremento del que espera son seq_cst: o la liberación
+    // ve al que espera, o el intento de este ve la memoria liberada
+    if (__atomic_load_n(&state->waiters, __ATOMIC_SEQ_CST)) {
+        pthread_mutex_lock(&state->mutex);
+        if (state->head) {
+            state->head->signaled = 1;
+            pthread_cond_signal(&state->head->cond);
+        }
+        pthread_mutex_unlock(&state->mutex);
+    }
+    wait_signal_event(state);
+}
+
+void* pool_alloc_wait(memory_pool_t* pool, size_t size, long timeout_ms,
+                      void* (*attempt)(void* context, size_t size), void* context) {
+    struct pool_wait* state = __atomic_load_n(&pool->waits, __ATOMIC_ACQUIRE);
+
+    // Lo que no cabe ni en el pool vacío no merece esperar
+    if (!pool->group && size > pool->total_size) timeout_ms = 0;
+
+    // Con otros esperando no se adelanta a la cola
+    void* ptr = NULL;
+    if (!state || !__atomic_load_n(&state->waiters, __ATOMIC_SEQ_CST)) {
+        ptr = attempt(context, size);
+    }
+    // Sin mutex nadie más puede liberar mientras este hilo espera
+    if (ptr || timeout_ms == 0 || pool->unsynchronized) return ptr;
+
+    if (!state && !(state = wait_state(pool))) return NULL;
+
+    struct timespec deadline;
+    if (timeout_ms > 0) {
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        uint64_t nanoseconds = (uint64_t)deadline.tv_nsec + (uint64_t)timeout_ms * 1000000;
+        deadline.tv_sec += (time_t)(nanoseconds / 1000000000);
+        deadline.tv_nsec = (long)(nanoseconds % 1000000000);
+    }
+
+    wait_node_t node;
+    node.next = NULL;
+    pthread_cond_init(&node.cond, NULL);
+
+    pthread_mutex_lock(&state->mutex);
+    if (state->tail) state->tail->next = &node;
+    else state->head = &node;
+    state->tail = &node;
+    node.signaled = state->head == &node;
+    __atomic_store_n(&state->waiters, state->waiters + 1, __ATOMIC_SEQ_CST);
+
+    for (;;) {
+        int result = 0;
+        while (!node.signaled && result != ETIMEDOUT) {
+            result = timeout_ms > 0 ? pthread_cond_timedwait(&node.cond, &state->mutex, &deadline)
+                                    : pthread_cond_wait(&node.cond, &state->mutex);
+        }
+        if (!node.signaled) break;
+
+        node.signaled = 0;
+        pthread_mutex_unlock(&state->mutex);
+        ptr = attempt(context, size);
+        pthread_mutex_lock(&state->mutex);
+        if (ptr) break;
+    }
+
+    // Salir de la cola; si era la cabeza, el turno pasa a la siguiente
+    wait_node_t** link = &state->head;
+    wait_node_t* previous = NULL;
+    while (*link != &node) {
+        previous = *link;
+        link = &(*link)->next;
+    }
+    *link = node.next;
+    if (state->tail == &node) state->tail = previous;
+    __atomic_store_n(&state->waiters, state->waiters - 1, __ATOMIC_SEQ_CST);
+
+    if (!previous && state->head) {
+        state->head->signaled = 1;
+        pthread_cond_signal(&state->head->cond);
+    }
+    int drained = state->head == NULL;
+    pthread_mutex_unlock(&state->mutex);
+    pthread_cond_destroy(&node.cond);
+
+    // Los intentos asíncronos cedían ante la cola: ahora pueden reintentar
+    if (drained) wait_signal_event(state);
+
+    if (!ptr) MEMORY_LOG(MEMORY_LOG_WARN, "Espera de %zu bytes agotada tras %ld ms", size, timeout_ms);
+    return ptr;
+}
+
+void* pool_alloc_async(memory_pool_t* pool, size_t size,
+                       void* (*attempt)(void* context, size_t size), void* context) {
+    struct pool_wait* state = wait_state(pool);
+    if (!state) return NULL;
+
+    int queued = __atomic_load_n(&state->waiters, __ATOMIC_SEQ_CST) != 0;
+    void* ptr = queued ? NULL : attempt(context, size);
+    if (ptr) return ptr;
+
+    // Armar antes de reintentar: una liberación anterior la ve el reintento y
+    // una posterior encuentra el eventfd armado
+    __atomic_store_n(&state->armed, 1, __ATOMIC_SEQ_CST);
+    if (queued || __atomic_load_n(&state->waiters, __ATOMIC_SEQ_CST)) return NULL;
+    return attempt(context, size);
+}
+
+void pool_wait_release(memory_pool_t* pool) {
+    struct pool_wait* state = pool->waits;
+    if (!state) return;
+
+    if (state->head) MEMORY_LOG(MEMORY_LOG_ERROR, "Pool destruido con hilos esperando memoria");
+    if (state->event_fd >= 0) close(state->event_fd);
+    pthread_mutex_destroy(&state->mutex);
+    free(state);
+    pool->waits = NULL;
+}
+
+// =============================================================================
+// API PÚBLICA
+// =============================================================================
+
+typedef struct {
+    memory_pool_t* pool;
+    int client_id;
+} pool_attempt_t;
+
+static void* pool_attempt(void* context, size_t size) {
+    pool_attempt_t* target = context;
+    return memory_pool_alloc(target->pool, size, target->client_id);
+}
+
+MEMORY_API void* memory_pool_alloc_wait(memory_pool_t* pool, size_t size, int client_id, long timeout_ms) {
+    if (!pool || size == 0) {
+        MEMORY_LOG(MEMORY_LOG_ERROR, "Parámetros inválidos para alloc_wait");
+        return NULL;
+    }
+    pool_attempt_t target = {pool, client_id};
+    return pool_alloc_wait(pool, size, timeout_ms, pool_attempt, &target);
+}
+
+MEMORY_API int memory_pool_wait_fd(memory_pool_t* pool) {
+    if (!pool) return MEMORY_ERROR_INVALID_PARAM;
+    struct pool_wait* state = wait_state(pool);
+    if (!state) return MEMORY_ERROR_OUT_OF_MEMORY;
+
+    pthread_mutex_lock(&state->mutex);
+    if (state->event_fd < 0) {
+        state->event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (state->event_fd < 0) MEMORY_LOG(MEMORY_LOG_ERROR, "No se pudo crear el eventfd del pool");
+    }
+    int fd = state->event_fd;
+    pthread_mutex_unlock(&state->mutex);
+
+    return fd >= 0 ? fd : MEMORY_ERROR_POOL_NOT_INIT;
+}
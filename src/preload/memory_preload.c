@@ -0,0 +1,216 @@
+#include "../memory_internal.h"
+#include "../../include/memory_preload.h"
+#include "../../include/memory_guard.h"
+#include <errno.h>
+#include <malloc.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// =============================================================================
+// INTERPOSICIÓN DE MALLOC SOBRE EL POOL
+// =============================================================================
+// Se compila aparte de libmemory_manager.a (que no debe redefinir malloc) con
+// MEMORY_ALIGNMENT=16, la alineación que malloc garantiza en x86-64 y
+// AArch64. Todas las asignaciones usan el cliente 0.
+
+#define PRELOAD_CLIENT 0
+#define PRELOAD_BOOTSTRAP_HEADER 16
+
+enum {
+    PRELOAD_UNINITIALIZED = 0,
+    PRELOAD_INITIALIZING = 1,
+    PRELOAD_READY = 2
+};
+
+static memory_pool_t* preload_pool = NULL;
+static int preload_state = PRELOAD_UNINITIALIZED;
+
+// Buffer para las asignaciones hechas mientras se crea el pool (la propia
+// creación llama a malloc); cada entrada guarda su tamaño delante
+static _Alignas(16) char preload_bootstrap[MEMORY_PRELOAD_BOOTSTRAP_SIZE];
+static size_t preload_bootstrap_used = 0;
+
+static void preload_fatal(const char* message) {
+    ssize_t written = write(STDERR_FILENO, message, strlen(message));
+    (void)written;
+    abort();
+}
+
+static void* bootstrap_alloc(size_t size) {
+    if (size > sizeof(preload_bootstrap)) return NULL;
+    size_t needed = PRELOAD_BOOTSTRAP_HEADER + ((size + 15) & ~(size_t)15);
+    size_t offset = __atomic_fetch_add(&preload_bootstrap_used, needed, __ATOMIC_RELAXED);
+    if (offset + needed > sizeof(preload_bootstrap)) {
+        preload_fatal("memory_preload: buffer de arranque agotado\n");
+    }
+
+    *(size_t*)(preload_bootstrap + offset) = size;
+    return preload_bootstrap + offset + PRELOAD_BOOTSTRAP_HEADER;
+}
+
+static void* bootstrap_alloc_aligned(size_t alignment, size_t size) {
+    if (size > sizeof(preload_bootstrap) || alignment > sizeof(preload_bootstrap)) return NULL;
+    char* raw = bootstrap_alloc(size + alignment);
+    if (!raw) return NULL;
+    char* ptr = (char*)(((uintptr_t)raw + alignment - 1) & ~(uintptr_t)(alignment - 1));
+    *(size_t*)(ptr - PRELOAD_BOOTSTRAP_HEADER) = size;
+    return ptr;
+}
+
+static int bootstrap_owns(const void* ptr) {
+    return (const char*)ptr >= preload_bootstrap &&
+           (const char*)ptr < preload_bootstrap + sizeof(preload_bootstrap);
+}
+
+static size_t bootstrap_size(const void* ptr) {
+    return *(const size_t*)((const char*)ptr - PRELOAD_BOOTSTRAP_HEADER);
+}
+
+// Un fork con el mutex del pool tomado por otro hilo dejaría al hijo bloqueado
+static void preload_prepare_fork(void) { pthread_mutex_lock(&preload_pool->mutex); }
+static void preload_release_fork(void) { pthread_mutex_unlock(&preload_pool->mutex); }
+
+static alloc_strategy_t preload_strategy(void) {
+    const char* name = getenv("MEMORY_PRELOAD_STRATEGY");
+    if (!name) return ALLOC_FIRST_FIT;
+    if (strcmp(name, "best") == 0) return ALLOC_BEST_FIT;
+    if (strcmp(name, "worst") == 0) return ALLOC_WORST_FIT;
+    if (strcmp(name, "next") == 0) return ALLOC_NEXT_FIT;
+    if (strcmp(name, "adaptive") == 0) return ALLOC_ADAPTIVE;
+    return ALLOC_FIRST_FIT;
+}
+
+// Devuelve 1 si el pool está listo; 0 si la llamada debe ir al buffer de
+// arranque (el pool se está creando, quizá en este mismo hilo)
+static int preload_init(void) {
+    int state = __atomic_load_n(&preload_state, __ATOMIC_ACQUIRE);
+    if (state == PRELOAD_READY) return 1;
+
+    int expected = PRELOAD_UNINITIALIZED;
+    if (!__atomic_compare_exchange_n(&preload_state, &expected, PRELOAD_INITIALIZING, 0,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        return 0;
+    }
+
+    size_t pool_size = MEMORY_PRELOAD_DEFAULT_POOL_SIZE;
+    const char* size_env = getenv("MEMORY_PRELOAD_POOL_SIZE");
+    if (size_env) pool_size = strtoull(size_env, NULL, 0);
+
+    preload_pool = memory_pool_create_ex(pool_size, preload_strategy(), MEMORY_POOL_FLAG_LAZY);
+    if (!preload_pool) preload_fatal("memory_preload: no se pudo crear el pool\n");
+
+    __atomic_store_n(&preload_state, PRELOAD_READY, __ATOMIC_RELEASE);
+    pthread_atfork(preload_prepare_fork, preload_release_fork, preload_release_fork);
+
+    // Con el pool listo: la reserva de la región de guarda ya pasa por malloc
+    const char* guard_env = getenv("MEMORY_GUARD_SAMPLE_RATE");
+    if (guard_env) memory_guard_start(strtoull(guard_env, NULL, 0), MEMORY_PRELOAD_GUARD_SLOTS);
+    return 1;
+}
+
+// =============================================================================
+// API ESTÁNDAR
+// =============================================================================
+
+MEMORY_API void* malloc(size_t size) {
+    if (!preload_init()) return bootstrap_alloc(size);
+
+    // malloc(0) devuelve un puntero único que se puede liberar
+    void* ptr = memory_pool_alloc(preload_pool, size ? size : 1, PRELOAD_CLIENT);
+    if (!ptr) errno = ENOMEM;
+    return ptr;
+}
+
+MEMORY_API void free(void* ptr) {
+    if (!ptr || bootstrap_owns(ptr)) return;
+    memory_pool_free(preload_pool, ptr, PRELOAD_CLIENT);
+}
+
+// El pool entrega la memoria ya a cero
+MEMORY_API void* calloc(size_t count, size_t size) {
+    size_t total;
+    if (__builtin_mul_overflow(count, size, &total)) {
+        errno = ENOMEM;
+        return NULL;
+    }
+    return malloc(total);
+}
+
+MEMORY_API void* realloc(void* ptr, size_t size) {
+    if (!ptr) return malloc(size);
+    if (size == 0) {
+        free(ptr);
+        return NULL;
+    }
+
+    if (bootstrap_owns(ptr)) {
+        void* moved = malloc(size);
+        if (moved) {
+            size_t old_size = bootstrap_size(ptr);
+            memcpy(moved, ptr, old_size < size ? old_size : size);
+        }
+        return moved;
+    }
+
+    void* result = memory_pool_realloc(preload_pool, ptr, size, PRELOAD_CLIENT);
+    if (!result) errno = ENOMEM;
+    return result;
+}
+
+MEMORY_API void* reallocarray(void* ptr, size_t count, size_t size) {
+    size_t total;
+    if (__builtin_mul_overflow(count, size, &total)) {
+        errno = ENOMEM;
+        return NULL;
+    }
+    return realloc(ptr, total);
+}
+
+MEMORY_API void* aligned_alloc(size_t alignment, size_t size) {
+    if (alignment == 0 || (alignment & (alignment - 1))) {
+        errno = EINVAL;
+        return NULL;
+    }
+    if (alignment <= 16) return malloc(size);
+    if (!preload_init()) return bootstrap_alloc_aligned(alignment, size);
+
+    void* ptr = memory_pool_alloc_aligned(preload_pool, alignment, size ? size : 1, PRELOAD_CLIENT);
+    if (!ptr) errno = ENOMEM;
+    return ptr;
+}
+
+MEMORY_API int posix_memalign(void** out, size_t alignment, size_t size) {
+    if (alignment % sizeof(void*) || (alignment & (alignment - 1))) return EINVAL;
+
+    int saved_errno = errno;
+    void* ptr = aligned_alloc(alignment, size);
+    errno = saved_errno;
+    if (!ptr) return ENOMEM;
+
+    *out = ptr;
+    return 0;
+}
+
+MEMORY_API void* memalign(size_t alignment, size_t size) {
+    return aligned_alloc(alignment, size);
+}
+
+MEMORY_API void* valloc(size_t size) {
+    return aligned_alloc((size_t)sysconf(_SC_PAGESIZE), size);
+}
+
+MEMORY_API void* pvalloc(size_t size) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    return aligned_alloc(page, (size + page - 1) & ~(page - 1));
+}
+
+MEMORY_API size_t malloc_usable_size(void* ptr) {
+    if (!ptr) return 0;
+    if (bootstrap_owns(ptr)) return bootstrap_size(ptr);
+    return memory_pool_usable_size(preload_pool, ptr);
+}
+
+MEMORY_API memory_pool_t* memory_preload_get_pool(void) {
+    return __atomic_load_n(&preload_state, __ATOMIC_ACQUIRE) == PRELOAD_READY ? preload_pool : NULL;
+}